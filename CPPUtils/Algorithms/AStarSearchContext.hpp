@@ -0,0 +1,339 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_ALGORITHMS_A_STAR_SEARCH_CONTEXT
+#define CPP_UTILS_ALGORITHMS_A_STAR_SEARCH_CONTEXT
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <CPPUtils/Algorithms/SearchState.hpp>
+#include <CPPUtils/DataStructures/CSRGraph.hpp>
+
+namespace CPPUtils::Algorithms {
+
+    /**
+     * @brief Reusable state for running many A* searches over one graph.
+     *
+     * Costs, parents and visited flags are kept in dense arrays indexed by
+     * vertex index, and the heap's buffer is kept between queries. Instead of
+     * clearing the arrays before each query, every entry is stamped with the
+     * generation of the query that wrote it, and an entry from an older
+     * generation reads as unvisited. Starting a query is therefore constant
+     * time, and a query costs time in proportion only to the part of the
+     * graph it explores.
+     *
+     * Heuristics estimate the remaining cost from a vertex to the goal. With
+     * a consistent heuristic, or none, the path found is a shortest path.
+     *
+     * Not thread safe; use one context per thread.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam V Cost type.
+     */
+    template<typename T, typename U = double, typename V = U>
+    class AStarSearchContext {
+    public:
+        using VertexIndex = DataStructures::Graphs::VertexIndex;
+
+        /**
+         * @brief Returned when no goal vertex was reached.
+         *
+         */
+        static constexpr VertexIndex invalidVertex = DataStructures::Graphs::CSRGraph<T, U>::invalidVertex;
+
+        /**
+         * @brief The cost of a vertex that was not reached.
+         *
+         */
+        static constexpr V infinity = Detail::infinityOf<V>();
+
+    protected:
+        using HeapEntry = std::pair<V, VertexIndex>;
+
+        const DataStructures::Graphs::CSRGraph<T, U>& G;
+
+        std::vector<V> costs;
+        std::vector<VertexIndex> parents;
+
+        // The generation in which each vertex was last reached, and settled.
+        std::vector<std::uint32_t> reachedIn;
+        std::vector<std::uint32_t> settledIn;
+        std::uint32_t generation;
+
+        std::vector<HeapEntry> heap;
+        size_t settledCount;
+
+        void beginQuery() {
+            heap.clear();
+            settledCount = 0;
+
+            Detail::nextGeneration(generation, reachedIn, settledIn);
+        }
+
+        void push(V priority, VertexIndex v) {
+            heap.emplace_back(priority, v);
+            std::push_heap(heap.begin(), heap.end(), std::greater<>());
+        }
+
+        HeapEntry pop() {
+            std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+            const auto top = heap.back();
+            heap.pop_back();
+            return top;
+        }
+
+    public:
+        /**
+         * @brief Construct a new A* Search Context object for `G`.
+         *
+         * `G` must outlive the context.
+         *
+         * @param G The graph to search.
+         */
+        explicit AStarSearchContext(const DataStructures::Graphs::CSRGraph<T, U>& G) :
+            G(G),
+            costs(G.getVertexCardinality()),
+            parents(G.getVertexCardinality()),
+            reachedIn(G.getVertexCardinality(), 0),
+            settledIn(G.getVertexCardinality(), 0),
+            generation(0),
+            settledCount(0) {
+            //
+        }
+
+        virtual ~AStarSearchContext() {
+            //
+        }
+
+        /**
+         * @brief Searches from `source` until a vertex satisfying `isGoal`
+         * is settled.
+         *
+         * @tparam GoalTest Callable type, `bool(VertexIndex)`.
+         * @tparam Heuristic Callable type, `V(VertexIndex)`.
+         * @param source The starting vertex.
+         * @param isGoal The goal test.
+         * @param heuristic Estimates the remaining cost from a vertex.
+         * @return VertexIndex The goal vertex reached, or `invalidVertex`.
+         */
+        template<typename GoalTest, typename Heuristic>
+        VertexIndex search(VertexIndex source, GoalTest&& isGoal, Heuristic&& heuristic) {
+            beginQuery();
+            if (source >= G.getVertexCardinality()) {
+                return invalidVertex;
+            }
+
+            reachedIn[source] = generation;
+            costs[source] = 0;
+            parents[source] = source;
+            push(heuristic(source), source);
+
+            while (!heap.empty()) {
+                const auto v = pop().second;
+
+                // Skip stale entries for vertices already settled.
+                if (settledIn[v] == generation) {
+                    continue;
+                }
+                settledIn[v] = generation;
+                settledCount++;
+
+                if (isGoal(v)) {
+                    return v;
+                }
+
+                const auto Nv = G.neighbours(v);
+                const auto Wv = G.neighbourWeights(v);
+                const auto g = costs[v];
+                for (size_t i = 0; i < Nv.size(); i++) {
+                    const auto u = Nv[i];
+                    const auto cost = g + static_cast<V>(Wv[i]);
+                    if (settledIn[u] == generation || (reachedIn[u] == generation && !(cost < costs[u]))) {
+                        continue;
+                    }
+
+                    reachedIn[u] = generation;
+                    costs[u] = cost;
+                    parents[u] = v;
+                    push(cost + heuristic(u), u);
+                }
+            }
+            return invalidVertex;
+        }
+
+        /**
+         * @brief Finds a shortest path from `source` to `target`, with
+         * Dijkstra's algorithm.
+         *
+         * @param source The starting vertex.
+         * @param target The goal vertex.
+         * @return true If `target` was reached.
+         * @return false Otherwise.
+         */
+        bool search(VertexIndex source, VertexIndex target) {
+            return search(source,
+                          [target](VertexIndex v) { return v == target; },
+                          [](VertexIndex) { return static_cast<V>(0); }) != invalidVertex;
+        }
+
+        /**
+         * @brief Determines if `v` was reached by the last search.
+         *
+         * @param v The query vertex.
+         * @return true If `v` was reached.
+         * @return false Otherwise.
+         */
+        bool wasReached(VertexIndex v) const {
+            return v < reachedIn.size() && reachedIn[v] == generation && generation != 0;
+        }
+
+        /**
+         * @brief Determines if the cost of `v` was final in the last search.
+         *
+         * @param v The query vertex.
+         * @return true If `v` was settled.
+         * @return false Otherwise.
+         */
+        bool wasSettled(VertexIndex v) const {
+            return v < settledIn.size() && settledIn[v] == generation && generation != 0;
+        }
+
+        /**
+         * @brief Provides the cost of reaching `v` in the last search.
+         *
+         * @param v The query vertex.
+         * @return V The cost, or `infinity` if `v` was not reached.
+         */
+        V getCost(VertexIndex v) const {
+            return wasReached(v) ? costs[v] : infinity;
+        }
+
+        /**
+         * @brief Provides the number of vertices settled by the last search.
+         *
+         * @return size_t The settled vertex count.
+         */
+        size_t getSettledCount() const {
+            return settledCount;
+        }
+
+        /**
+         * @brief Writes the path from the last search's source to `v` into
+         * `path`, reusing its storage.
+         *
+         * @param v The final vertex.
+         * @param path Receives the path, source first; empty if `v` was not
+         * reached.
+         */
+        void getPath(VertexIndex v, std::vector<VertexIndex>& path) const {
+            path.clear();
+            if (!wasReached(v)) {
+                return;
+            }
+
+            path.push_back(v);
+            while (parents[v] != v) {
+                v = parents[v];
+                path.push_back(v);
+            }
+            std::reverse(path.begin(), path.end());
+        }
+
+        /**
+         * @brief Provides the path from the last search's source to `v`.
+         *
+         * @param v The final vertex.
+         * @return std::vector<VertexIndex> The path, source first; empty if
+         * `v` was not reached.
+         */
+        std::vector<VertexIndex> getPath(VertexIndex v) const {
+            std::vector<VertexIndex> path;
+            getPath(v, path);
+            return path;
+        }
+
+        /**
+         * @brief Finds a shortest path between two vertex keys.
+         *
+         * `heuristic(a, b)` estimates the cost from `a` to `b`.
+         *
+         * @tparam Heuristic Callable type, `V(const T&, const T&)`.
+         * @param source The starting vertex.
+         * @param sink The goal vertex.
+         * @param heuristic The cost estimate.
+         * @return std::vector<T> The path, source first; empty if there is
+         * none.
+         */
+        template<typename Heuristic>
+        std::vector<T> findPath(const T& source, const T& sink, Heuristic&& heuristic) {
+            const auto s = G.indexOf(source);
+            const auto t = G.indexOf(sink);
+            if (s == invalidVertex || t == invalidVertex) {
+                return {};
+            }
+
+            const auto& goalKey = G.vertexAt(t);
+            const auto goal = search(s,
+                                     [t](VertexIndex v) { return v == t; },
+                                     [&](VertexIndex v) { return heuristic(G.vertexAt(v), goalKey); });
+
+            std::vector<T> path;
+            if (goal != invalidVertex) {
+                for (const auto v : getPath(goal)) {
+                    path.push_back(G.vertexAt(v));
+                }
+            }
+            return path;
+        }
+
+        /**
+         * @brief Finds a shortest path between two vertex keys, with
+         * Dijkstra's algorithm.
+         *
+         * @param source The starting vertex.
+         * @param sink The goal vertex.
+         * @return std::vector<T> The path, source first; empty if there is
+         * none.
+         */
+        std::vector<T> findPath(const T& source, const T& sink) {
+            return findPath(source, sink, [](const T&, const T&) { return static_cast<V>(0); });
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,486 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_ALGORITHMS_BIDIRECTIONAL_SEARCH
+#define CPP_UTILS_ALGORITHMS_BIDIRECTIONAL_SEARCH
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <CPPUtils/Algorithms/SearchState.hpp>
+#include <CPPUtils/Concurrency/Parallel.hpp>
+#include <CPPUtils/DataStructures/CSRGraph.hpp>
+
+namespace CPPUtils::Algorithms {
+
+    /**
+     * @brief Reusable state for point-to-point shortest path queries that
+     * search forward from the source and backward from the target at once.
+     *
+     * The backward search runs on the transpose of the graph, built once
+     * when the context is constructed. The searches stop when the sum of
+     * their least frontier keys reaches the best path found through a vertex
+     * reached by both, which is then a shortest path. As with
+     * `AStarSearchContext`, per-vertex state is held in dense arrays and
+     * reset lazily by generation stamps.
+     *
+     * With a heuristic, each side is guided by the average of the forward
+     * and backward estimates, which keeps edge costs non-negative for both
+     * searches when the heuristic is consistent; the cost type must then be
+     * signed.
+     *
+     * In parallel mode the two searches run on separate threads, sharing
+     * their costs through atomic accesses. Not otherwise thread safe; use
+     * one context per query thread.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam V Cost type.
+     */
+    template<typename T, typename U = double, typename V = U>
+    class BidirectionalSearchContext {
+    public:
+        using VertexIndex = DataStructures::Graphs::VertexIndex;
+
+        /**
+         * @brief The cost of a target that was not reached.
+         *
+         */
+        static constexpr V infinity = Detail::infinityOf<V>();
+
+    protected:
+        using HeapEntry = std::pair<V, VertexIndex>;
+
+        // The state of one direction of the search.
+        struct Side final {
+            const DataStructures::Graphs::CSRGraph<T, U>* graph = nullptr;
+
+            std::vector<V> costs;
+            std::vector<VertexIndex> parents;
+            std::vector<std::uint32_t> reachedIn;
+            std::vector<std::uint32_t> settledIn;
+            std::vector<HeapEntry> heap;
+            size_t settledCount = 0;
+
+            // The least key in the heap, and whether this side has stopped,
+            // as seen by the other side.
+            std::atomic<V> topKey;
+            std::atomic<bool> done;
+        };
+
+        const DataStructures::Graphs::CSRGraph<T, U>& G;
+        std::unique_ptr<DataStructures::Graphs::CSRGraph<T, U>> reverse;
+
+        Side forward;
+        Side backward;
+        std::uint32_t generation;
+
+        // The best path cost found so far, and the vertex it passes through.
+        std::atomic<V> best;
+        VertexIndex meeting;
+        std::mutex bestLock;
+
+        template<bool Concurrent, typename X>
+        static X load(const X& x) {
+            if constexpr (Concurrent) {
+                return std::atomic_ref<X>(const_cast<X&>(x)).load();
+            } else {
+                return x;
+            }
+        }
+
+        template<bool Concurrent, typename X>
+        static void store(X& x, X value) {
+            if constexpr (Concurrent) {
+                std::atomic_ref<X>(x).store(value);
+            } else {
+                x = value;
+            }
+        }
+
+        void beginQuery() {
+            forward.heap.clear();
+            backward.heap.clear();
+            forward.settledCount = 0;
+            backward.settledCount = 0;
+            forward.done = false;
+            backward.done = false;
+            best = infinity;
+            meeting = DataStructures::Graphs::CSRGraph<T, U>::invalidVertex;
+
+            Detail::nextGeneration(generation, forward.reachedIn, forward.settledIn,
+                                   backward.reachedIn, backward.settledIn);
+        }
+
+        void start(Side& side, VertexIndex v, V key) {
+            side.reachedIn[v] = generation;
+            side.costs[v] = 0;
+            side.parents[v] = v;
+            side.heap.emplace_back(key, v);
+            side.topKey = key;
+        }
+
+        // Pops entries for vertices already settled off the top of the heap.
+        static void discardStale(Side& side, std::uint32_t generation) {
+            while (!side.heap.empty() && side.settledIn[side.heap.front().second] == generation) {
+                std::pop_heap(side.heap.begin(), side.heap.end(), std::greater<>());
+                side.heap.pop_back();
+            }
+        }
+
+        // Settles the top vertex of `self` and relaxes its edges; keys are
+        // twice the cost plus `potential`, so that averaged heuristics stay
+        // exact for integer costs.
+        template<bool Concurrent, typename Potential>
+        void expand(Side& self, const Side& other, Potential& potential) {
+            std::pop_heap(self.heap.begin(), self.heap.end(), std::greater<>());
+            const auto v = self.heap.back().second;
+            self.heap.pop_back();
+            self.settledIn[v] = generation;
+            self.settledCount++;
+
+            const auto Nv = self.graph->neighbours(v);
+            const auto Wv = self.graph->neighbourWeights(v);
+            const auto g = load<Concurrent>(self.costs[v]);
+            for (size_t i = 0; i < Nv.size(); i++) {
+                const auto u = Nv[i];
+                if (self.settledIn[u] == generation) {
+                    continue;
+                }
+
+                const auto cost = g + static_cast<V>(Wv[i]);
+                if (load<Concurrent>(self.reachedIn[u]) == generation && !(cost < load<Concurrent>(self.costs[u]))) {
+                    continue;
+                }
+
+                // The cost is published before the stamp, so that the other
+                // side never pairs a new stamp with a stale cost.
+                store<Concurrent>(self.costs[u], cost);
+                store<Concurrent>(self.reachedIn[u], generation);
+                self.parents[u] = v;
+                self.heap.emplace_back(cost + cost + potential(u), u);
+                std::push_heap(self.heap.begin(), self.heap.end(), std::greater<>());
+
+                // A vertex reached from both ends closes a path.
+                if (load<Concurrent>(other.reachedIn[u]) == generation) {
+                    const auto total = cost + load<Concurrent>(other.costs[u]);
+                    if (total < best.load()) {
+                        std::lock_guard<std::mutex> lock(bestLock);
+                        if (total < best.load()) {
+                            best = total;
+                            meeting = u;
+                        }
+                    }
+                }
+            }
+        }
+
+        template<typename ForwardPotential, typename BackwardPotential>
+        void searchSerial(ForwardPotential& forwardPotential, BackwardPotential& backwardPotential) {
+            while (true) {
+                discardStale(forward, generation);
+                discardStale(backward, generation);
+                if (forward.heap.empty() || backward.heap.empty()) {
+                    return;
+                }
+
+                const auto topForward = forward.heap.front().first;
+                const auto topBackward = backward.heap.front().first;
+                const auto mu = best.load();
+                if (mu != infinity && !(topForward + topBackward < mu + mu)) {
+                    return;
+                }
+
+                // Grow the side with the smaller frontier key.
+                if (!(topBackward < topForward)) {
+                    expand<false>(forward, backward, forwardPotential);
+                } else {
+                    expand<false>(backward, forward, backwardPotential);
+                }
+            }
+        }
+
+        template<typename Potential>
+        void searchConcurrent(Side& self, const Side& other, Potential& potential) {
+            while (true) {
+                discardStale(self, generation);
+                if (self.heap.empty() || other.done) {
+                    break;
+                }
+
+                // The other side's key only grows, so a stale read is a
+                // lower bound and stopping on it is safe.
+                const auto top = self.heap.front().first;
+                self.topKey = top;
+                const auto mu = best.load();
+                if (mu != infinity && !(top + other.topKey.load() < mu + mu)) {
+                    break;
+                }
+                expand<true>(self, other, potential);
+            }
+            self.done = true;
+        }
+
+        template<typename Heuristic>
+        bool searchWith(VertexIndex source, VertexIndex target, Heuristic&& heuristic, bool parallel) {
+            beginQuery();
+            const auto N = G.getVertexCardinality();
+            if (source >= N || target >= N) {
+                return false;
+            }
+
+            // Each side's potential is its own estimate less the other's.
+            auto forwardPotential = [&](VertexIndex v) -> V {
+                return heuristic(v, target) - heuristic(source, v);
+            };
+            auto backwardPotential = [&](VertexIndex v) -> V {
+                return heuristic(source, v) - heuristic(v, target);
+            };
+
+            start(forward, source, forwardPotential(source));
+            start(backward, target, backwardPotential(target));
+            if (source == target) {
+                best = 0;
+                meeting = source;
+                return true;
+            }
+
+            if (!parallel) {
+                searchSerial(forwardPotential, backwardPotential);
+            } else {
+                static_assert(std::atomic_ref<V>::required_alignment <= alignof(V),
+                              "Parallel search needs costs that can be accessed atomically in place.");
+
+                Concurrency::parallelFor(0, 2, [&](size_t i) {
+                    auto& self = i == 0 ? forward : backward;
+                    try {
+                        if (i == 0) {
+                            searchConcurrent(forward, backward, forwardPotential);
+                        } else {
+                            searchConcurrent(backward, forward, backwardPotential);
+                        }
+                    }
+                    catch (...) {
+                        self.done = true;
+                        throw;
+                    }
+                }, 2);
+            }
+            return best.load() != infinity;
+        }
+
+    public:
+        /**
+         * @brief Construct a new Bidirectional Search Context object for
+         * `G`.
+         *
+         * `G` must outlive the context. Directed graphs are transposed once,
+         * here.
+         *
+         * @param G The graph to search.
+         */
+        explicit BidirectionalSearchContext(const DataStructures::Graphs::CSRGraph<T, U>& G) :
+            G(G),
+            generation(0),
+            best(infinity),
+            meeting(DataStructures::Graphs::CSRGraph<T, U>::invalidVertex) {
+            if (G.isDirected()) {
+                reverse = std::make_unique<DataStructures::Graphs::CSRGraph<T, U>>(
+                    DataStructures::Graphs::transpose(G));
+            }
+
+            const auto N = G.getVertexCardinality();
+            for (auto* side : { &forward, &backward }) {
+                side->costs.resize(N);
+                side->parents.resize(N);
+                side->reachedIn.assign(N, 0);
+                side->settledIn.assign(N, 0);
+                side->topKey = 0;
+                side->done = false;
+            }
+            forward.graph = &G;
+            backward.graph = reverse ? reverse.get() : &G;
+        }
+
+        virtual ~BidirectionalSearchContext() {
+            //
+        }
+
+        /**
+         * @brief Finds a shortest path from `source` to `target`, with
+         * bidirectional Dijkstra.
+         *
+         * @param source The starting vertex.
+         * @param target The goal vertex.
+         * @param parallel Whether to run the two searches on separate
+         * threads.
+         * @return true If `target` was reached.
+         * @return false Otherwise.
+         */
+        bool search(VertexIndex source, VertexIndex target, bool parallel = false) {
+            return searchWith(source, target, [](VertexIndex, VertexIndex) { return static_cast<V>(0); }, parallel);
+        }
+
+        /**
+         * @brief Finds a shortest path from `source` to `target`, with
+         * bidirectional A*.
+         *
+         * @tparam Heuristic Callable type, `V(VertexIndex, VertexIndex)`.
+         * @param source The starting vertex.
+         * @param target The goal vertex.
+         * @param heuristic Estimates the cost from its first argument to its
+         * second; it must be consistent.
+         * @param parallel Whether to run the two searches on separate
+         * threads.
+         * @return true If `target` was reached.
+         * @return false Otherwise.
+         */
+        template<typename Heuristic>
+        bool search(VertexIndex source, VertexIndex target, Heuristic&& heuristic, bool parallel = false) {
+            return searchWith(source, target, heuristic, parallel);
+        }
+
+        /**
+         * @brief Provides the cost of the path found by the last search.
+         *
+         * @return V The cost, or `infinity` if no path was found.
+         */
+        V getCost() const {
+            return best.load();
+        }
+
+        /**
+         * @brief Provides the number of vertices settled by the last search,
+         * in both directions.
+         *
+         * @return size_t The settled vertex count.
+         */
+        size_t getSettledCount() const {
+            return forward.settledCount + backward.settledCount;
+        }
+
+        /**
+         * @brief Writes the path found by the last search into `path`,
+         * reusing its storage.
+         *
+         * @param path Receives the path, source first; empty if no path was
+         * found.
+         */
+        void getPath(std::vector<VertexIndex>& path) const {
+            path.clear();
+            if (best.load() == infinity) {
+                return;
+            }
+
+            // Walk back to the source, then forward to the target.
+            for (auto v = meeting; ; v = forward.parents[v]) {
+                path.push_back(v);
+                if (forward.parents[v] == v) {
+                    break;
+                }
+            }
+            std::reverse(path.begin(), path.end());
+            for (auto v = meeting; backward.parents[v] != v; ) {
+                v = backward.parents[v];
+                path.push_back(v);
+            }
+        }
+
+        /**
+         * @brief Provides the path found by the last search.
+         *
+         * @return std::vector<VertexIndex> The path, source first; empty if
+         * no path was found.
+         */
+        std::vector<VertexIndex> getPath() const {
+            std::vector<VertexIndex> path;
+            getPath(path);
+            return path;
+        }
+
+        /**
+         * @brief Finds a shortest path between two vertex keys.
+         *
+         * @tparam Heuristic Callable type, `V(const T&, const T&)`.
+         * @param source The starting vertex.
+         * @param sink The goal vertex.
+         * @param heuristic Estimates the cost from its first argument to its
+         * second; it must be consistent.
+         * @param parallel Whether to run the two searches on separate
+         * threads.
+         * @return std::vector<T> The path, source first; empty if there is
+         * none.
+         */
+        template<typename Heuristic>
+        std::vector<T> findPath(const T& source, const T& sink, Heuristic&& heuristic, bool parallel = false) {
+            const auto s = G.indexOf(source);
+            const auto t = G.indexOf(sink);
+            if (s == DataStructures::Graphs::CSRGraph<T, U>::invalidVertex ||
+                t == DataStructures::Graphs::CSRGraph<T, U>::invalidVertex) {
+                return {};
+            }
+
+            std::vector<T> path;
+            const auto h = [&](VertexIndex a, VertexIndex b) { return heuristic(G.vertexAt(a), G.vertexAt(b)); };
+            if (searchWith(s, t, h, parallel)) {
+                for (const auto v : getPath()) {
+                    path.push_back(G.vertexAt(v));
+                }
+            }
+            return path;
+        }
+
+        /**
+         * @brief Finds a shortest path between two vertex keys, with
+         * bidirectional Dijkstra.
+         *
+         * @param source The starting vertex.
+         * @param sink The goal vertex.
+         * @param parallel Whether to run the two searches on separate
+         * threads.
+         * @return std::vector<T> The path, source first; empty if there is
+         * none.
+         */
+        std::vector<T> findPath(const T& source, const T& sink, bool parallel = false) {
+            return findPath(source, sink, [](const T&, const T&) { return static_cast<V>(0); }, parallel);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,612 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_ALGORITHMS_CENTRALITY
+#define CPP_UTILS_ALGORITHMS_CENTRALITY
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <CPPUtils/Concurrency/Parallel.hpp>
+#include <CPPUtils/DataStructures/CSRGraph.hpp>
+#include <CPPUtils/DataStructures/Graph.hpp>
+
+namespace CPPUtils::Algorithms {
+
+    /**
+     * @brief Iterative, pull-based PageRank.
+     *
+     * The graph is transposed on construction, so that each iteration
+     * computes the new rank of every vertex by gathering from its in
+     * neighbours. Each in edge carries a precomputed, contiguous transition
+     * probability, making the inner loop a gathered dot product. Vertices are
+     * processed in contiguous blocks, one per thread, so that each thread
+     * writes to a disjoint range of the output.
+     *
+     * On large graphs the gather is cache blocked: the source vertices are
+     * split into tiles whose ranks fit in cache, and each thread sweeps its
+     * block once per tile, gathering only in edges from that tile. In edges
+     * are stored sorted by source, so each vertex resumes where the previous
+     * tile stopped.
+     *
+     * Convergence is tracked like `GradientOptimizerBase`; the L1 norm of the
+     * change in rank is recorded for every iteration.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam R Rank type.
+     */
+    template<typename T, typename U = double, typename R = double>
+    class PageRank {
+    protected:
+        const R damping;
+        const R convergenceThreshold;
+        const unsigned int maxIterations;
+        const unsigned int numThreads;
+        unsigned int currentIteration;
+
+        std::vector<R> residualHistory;
+
+        // Vertex keys, in index order.
+        std::vector<T> keys;
+
+        // Transposed CSR; the sources of the in edges of each vertex, with
+        // the probability of following each of them.
+        std::vector<DataStructures::Graphs::EdgeIndex> inOffsets;
+        std::vector<DataStructures::Graphs::VertexIndex> inSources;
+        std::vector<R> inProbabilities;
+
+        // Vertices with no outward weight, whose rank is spread uniformly.
+        std::vector<DataStructures::Graphs::VertexIndex> dangling;
+
+        std::vector<R> ranks;
+        std::vector<R> nextRanks;
+
+        // The number of source vertices per tile, and per vertex scratch for
+        // resuming the gather across tiles.
+        size_t tileSize;
+        std::vector<DataStructures::Graphs::EdgeIndex> tileCursors;
+
+        void initialise(const DataStructures::Graphs::CSRGraph<T, U>& G, bool weighted) {
+            using DataStructures::Graphs::EdgeIndex;
+            using DataStructures::Graphs::VertexIndex;
+
+            const auto N = G.getVertexCardinality();
+            keys.assign(G.getVertices().begin(), G.getVertices().end());
+
+            // Total outward weight of each vertex.
+            std::vector<R> outWeight(N, 0);
+            for (size_t v = 0; v < N; v++) {
+                const auto W = G.neighbourWeights(static_cast<VertexIndex>(v));
+                for (const auto w : W) {
+                    if (weighted && w < 0) {
+                        throw std::invalid_argument("PageRank requires non-negative weights.");
+                    }
+                    outWeight[v] += weighted ? static_cast<R>(w) : static_cast<R>(1);
+                }
+                if (outWeight[v] == 0) {
+                    dangling.push_back(static_cast<VertexIndex>(v));
+                }
+            }
+
+            // Count in edges, then scatter them into the transposed arrays.
+            inOffsets.assign(N + 1, 0);
+            for (const auto t : G.getTargets()) {
+                inOffsets[t + 1]++;
+            }
+            for (size_t v = 0; v < N; v++) {
+                inOffsets[v + 1] += inOffsets[v];
+            }
+
+            inSources.resize(G.getEdgeCardinality());
+            inProbabilities.resize(G.getEdgeCardinality());
+            // Scattering sources in increasing order leaves the in edges of
+            // each vertex sorted by source, which the tiled gather relies on.
+            std::vector<EdgeIndex> cursor(inOffsets.begin(), inOffsets.end() - 1);
+            for (size_t u = 0; u < N; u++) {
+                const auto Nu = G.neighbours(static_cast<VertexIndex>(u));
+                const auto Wu = G.neighbourWeights(static_cast<VertexIndex>(u));
+                for (size_t i = 0; i < Nu.size(); i++) {
+                    const auto e = cursor[Nu[i]]++;
+                    const auto w = weighted ? static_cast<R>(Wu[i]) : static_cast<R>(1);
+                    inSources[e] = static_cast<VertexIndex>(u);
+                    inProbabilities[e] = outWeight[u] > 0 ? w / outWeight[u] : 0;
+                }
+            }
+
+            reset();
+        }
+
+    public:
+        /**
+         * @brief Construct a new PageRank object over `G`.
+         *
+         * @param G The graph.
+         * @param damping The probability of following an edge, rather than
+         * teleporting.
+         * @param convergenceThreshold Iteration stops once the L1 change in
+         * rank is at most this.
+         * @param maxIterations The maximum number of iterations.
+         * @param weighted Whether edges are followed in proportion to their
+         * weight, rather than uniformly.
+         * @param numThreads The number of threads to use, 0 for the default.
+         */
+        PageRank(const DataStructures::Graphs::CSRGraph<T, U>& G,
+                 R damping = 0.85,
+                 R convergenceThreshold = 1e-6,
+                 unsigned int maxIterations = 100,
+                 bool weighted = false,
+                 unsigned int numThreads = 0) :
+            damping(damping),
+            convergenceThreshold(convergenceThreshold),
+            maxIterations(maxIterations),
+            numThreads(numThreads),
+            currentIteration(0),
+            tileSize(defaultTileBytes / sizeof(R)) {
+            initialise(G, weighted);
+        }
+
+        /**
+         * @brief Construct a new PageRank object over `G`.
+         *
+         * See the `CSRGraph` constructor for the parameters.
+         */
+        PageRank(const DataStructures::Graphs::Graph<T, U>& G,
+                 R damping = 0.85,
+                 R convergenceThreshold = 1e-6,
+                 unsigned int maxIterations = 100,
+                 bool weighted = false,
+                 unsigned int numThreads = 0) :
+            PageRank(DataStructures::Graphs::CSRGraph<T, U>(G, numThreads),
+                     damping, convergenceThreshold, maxIterations, weighted, numThreads) {
+            //
+        }
+
+        virtual ~PageRank() {
+            //
+        }
+
+        /**
+         * @brief The default size of the ranks gathered per tile, in bytes.
+         *
+         */
+        static constexpr size_t defaultTileBytes = size_t(1) << 18;
+
+        /**
+         * @brief Sets the number of source vertices gathered from per tile.
+         *
+         * @param size The tile size, at least 1.
+         */
+        void setTileSize(size_t size) {
+            if (size == 0) {
+                throw std::invalid_argument("Tile size must be positive.");
+            }
+            tileSize = size;
+        }
+
+        /**
+         * @brief Provides the number of source vertices gathered from per
+         * tile.
+         *
+         * @return size_t The tile size.
+         */
+        size_t getTileSize() const {
+            return tileSize;
+        }
+
+        /**
+         * @brief Performs a single power iteration.
+         *
+         * @return R The L1 norm of the change in rank.
+         */
+        virtual R step() {
+            const auto N = keys.size();
+            if (N == 0) {
+                residualHistory.push_back(0);
+                currentIteration++;
+                return 0;
+            }
+
+            // Rank held by dangling vertices is spread over every vertex.
+            R danglingRank = 0;
+            for (const auto v : dangling) {
+                danglingRank += ranks[v];
+            }
+            const R base = (1 - damping) / N + damping * danglingRank / N;
+
+            // Gather, one contiguous block of vertices per thread.
+            std::vector<R> blockResiduals(Concurrency::resolveThreadCount(numThreads), 0);
+            Concurrency::parallelForBlocks(0, N, [&](size_t t, size_t first, size_t last) {
+                if (tileSize >= N) {
+                    for (size_t v = first; v < last; v++) {
+                        R sum = 0;
+                        for (auto e = inOffsets[v]; e < inOffsets[v + 1]; e++) {
+                            sum += ranks[inSources[e]] * inProbabilities[e];
+                        }
+                        nextRanks[v] = sum;
+                    }
+                } else {
+                    std::copy(inOffsets.begin() + first, inOffsets.begin() + last, tileCursors.begin() + first);
+                    std::fill(nextRanks.begin() + first, nextRanks.begin() + last, 0);
+                    for (size_t tileStart = 0; tileStart < N; tileStart += tileSize) {
+                        const auto tileEnd = std::min(N, tileStart + tileSize);
+                        for (size_t v = first; v < last; v++) {
+                            R sum = 0;
+                            auto e = tileCursors[v];
+                            for (; e < inOffsets[v + 1] && inSources[e] < tileEnd; e++) {
+                                sum += ranks[inSources[e]] * inProbabilities[e];
+                            }
+                            tileCursors[v] = e;
+                            nextRanks[v] += sum;
+                        }
+                    }
+                }
+
+                R residual = 0;
+                for (size_t v = first; v < last; v++) {
+                    nextRanks[v] = base + damping * nextRanks[v];
+                    residual += std::abs(nextRanks[v] - ranks[v]);
+                }
+                blockResiduals[t] = residual;
+            }, numThreads);
+
+            ranks.swap(nextRanks);
+
+            R residual = 0;
+            for (const auto r : blockResiduals) {
+                residual += r;
+            }
+            residualHistory.push_back(residual);
+            currentIteration++;
+            return residual;
+        }
+
+        /**
+         * @brief Iterates until convergence, or until the maximum number of
+         * iterations is reached.
+         *
+         * @return true If the ranks converged.
+         * @return false Otherwise.
+         */
+        virtual bool run() {
+            while (!hasConverged() && currentIteration < maxIterations) {
+                step();
+            }
+            return hasConverged();
+        }
+
+        virtual bool hasConverged() const {
+            return !residualHistory.empty() && residualHistory.back() <= convergenceThreshold;
+        }
+
+        virtual R getConvergenceThreshold() const {
+            return convergenceThreshold;
+        }
+
+        virtual unsigned int getMaxIterations() const {
+            return maxIterations;
+        }
+
+        virtual unsigned int getCurrentIteration() const {
+            return currentIteration;
+        }
+
+        virtual const std::vector<R>& getResidualHistory() const {
+            return residualHistory;
+        }
+
+        /**
+         * @brief Restores the uniform initial ranks and clears the history.
+         *
+         */
+        virtual void reset() {
+            const auto N = keys.size();
+            ranks.assign(N, N > 0 ? static_cast<R>(1) / N : 0);
+            nextRanks.assign(N, 0);
+            tileCursors.assign(N, 0);
+            residualHistory.clear();
+            residualHistory.reserve(maxIterations);
+            currentIteration = 0;
+        }
+
+        /**
+         * @brief Provides the current ranks, indexed as the vertices of the
+         * `CSRGraph` that the ranks were computed over.
+         *
+         * @return std::span<const R> The rank of each vertex.
+         */
+        std::span<const R> getRankVector() const {
+            return ranks;
+        }
+
+        /**
+         * @brief Provides the current rank of each vertex.
+         *
+         * @return std::unordered_map<T, R> The rank of each vertex.
+         */
+        std::unordered_map<T, R> getRanks() const {
+            std::unordered_map<T, R> result;
+            result.reserve(keys.size());
+            for (size_t i = 0; i < keys.size(); i++) {
+                result.emplace(keys[i], ranks[i]);
+            }
+            return result;
+        }
+    };
+
+    /**
+     * @brief Computes the normalised out degree centrality of every vertex.
+     *
+     * Each out degree is divided by `V - 1`, the largest possible degree in a
+     * simple graph.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam R Centrality type.
+     * @param G The graph.
+     * @return std::unordered_map<T, R> The centrality of each vertex.
+     */
+    template<typename T, typename U = double, typename R = double>
+    inline std::unordered_map<T, R> degreeCentrality(const DataStructures::Graphs::Graph<T, U>& G) {
+        const auto N = G.getVertexCardinality();
+        const R scale = N > 1 ? static_cast<R>(1) / (N - 1) : 0;
+
+        std::unordered_map<T, R> result;
+        result.reserve(N);
+        for (const auto& v : G.getVertexRange()) {
+            result.emplace(v, G.getAdjacencyList(v).size() * scale);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Computes the normalised in degree centrality of every vertex.
+     *
+     * For undirected graphs this is equal to `degreeCentrality`.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam R Centrality type.
+     * @param G The graph.
+     * @return std::unordered_map<T, R> The centrality of each vertex.
+     */
+    template<typename T, typename U = double, typename R = double>
+    inline std::unordered_map<T, R> inDegreeCentrality(const DataStructures::Graphs::Graph<T, U>& G) {
+        const auto N = G.getVertexCardinality();
+        const R scale = N > 1 ? static_cast<R>(1) / (N - 1) : 0;
+
+        std::unordered_map<T, R> result;
+        result.reserve(N);
+        for (const auto& v : G.getVertexRange()) {
+            result.emplace(v, 0);
+        }
+        for (const auto& e : G.getEdgeRange()) {
+            result.at(e.target) += scale;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Computes the betweenness centrality of every vertex with
+     * Brandes' algorithm.
+     *
+     * Single source shortest path dependencies are accumulated in parallel,
+     * with each thread taking a contiguous block of source vertices and
+     * keeping its own partial sums. Shortest paths are by hop count unless
+     * `weighted` is set, in which case the (non-negative) edge weights are
+     * used; floating point path costs within a few units in the last place
+     * of each other count as equal. For undirected graphs each pair is
+     * counted once. Scores are not normalised.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam R Centrality type.
+     * @param G The graph.
+     * @param weighted Whether to use the edge weights as path lengths.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return std::vector<R> The centrality of each vertex, indexed as the
+     * vertices of `G`.
+     */
+    template<typename T, typename U = double, typename R = double>
+    inline std::vector<R> betweennessCentrality(const DataStructures::Graphs::CSRGraph<T, U>& G,
+                                                bool weighted = false,
+                                                unsigned int numThreads = 0) {
+        using DataStructures::Graphs::VertexIndex;
+
+        const auto N = G.getVertexCardinality();
+        std::vector<std::vector<R>> partials(Concurrency::resolveThreadCount(numThreads));
+
+        Concurrency::parallelForBlocks(0, N, [&](size_t t, size_t first, size_t last) {
+            auto& centrality = partials[t];
+            centrality.assign(N, 0);
+
+            // Per source scratch, reused across sources.
+            std::vector<U> distance(N);
+            std::vector<R> sigma(N);
+            std::vector<R> delta(N);
+            std::vector<std::vector<VertexIndex>> predecessors(N);
+            std::vector<VertexIndex> order;
+            order.reserve(N);
+
+            constexpr auto infinity = (std::numeric_limits<U>::max)();
+
+            // Equal length paths summed in a different order can differ in
+            // their last bits, so floating point costs are compared with a
+            // relative tolerance.
+            const auto sameCost = [](U a, U b) {
+                if constexpr (std::is_floating_point_v<U>) {
+                    return std::abs(a - b) <= 8 * std::numeric_limits<U>::epsilon() * std::max(std::abs(a), std::abs(b));
+                } else {
+                    return a == b;
+                }
+            };
+
+            for (size_t s = first; s < last; s++) {
+                std::fill(distance.begin(), distance.end(), infinity);
+                std::fill(sigma.begin(), sigma.end(), 0);
+                std::fill(delta.begin(), delta.end(), 0);
+                for (auto& p : predecessors) {
+                    p.clear();
+                }
+                order.clear();
+
+                distance[s] = 0;
+                sigma[s] = 1;
+
+                // Relaxes edge v -> u, recording shortest path predecessors.
+                auto relax = [&](VertexIndex v, VertexIndex u, U d) {
+                    if (distance[u] == infinity || (d < distance[u] && !sameCost(d, distance[u]))) {
+                        distance[u] = d;
+                        sigma[u] = 0;
+                        predecessors[u].clear();
+                    }
+                    if (sameCost(d, distance[u])) {
+                        sigma[u] += sigma[v];
+                        predecessors[u].push_back(v);
+                    }
+                };
+
+                if (!weighted) {
+                    // Breadth first; order doubles as the queue.
+                    order.push_back(static_cast<VertexIndex>(s));
+                    for (size_t head = 0; head < order.size(); head++) {
+                        const auto v = order[head];
+                        for (const auto u : G.neighbours(v)) {
+                            const auto unseen = distance[u] == infinity;
+                            relax(v, u, distance[v] + 1);
+                            if (unseen) {
+                                order.push_back(u);
+                            }
+                        }
+                    }
+                } else {
+                    // Dijkstra, with lazy deletion of stale queue entries.
+                    using Entry = std::pair<U, VertexIndex>;
+                    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> Q;
+                    std::vector<bool> settled(N, false);
+                    Q.emplace(0, static_cast<VertexIndex>(s));
+                    while (!Q.empty()) {
+                        const auto [d, v] = Q.top();
+                        Q.pop();
+                        if (settled[v]) {
+                            continue;
+                        }
+                        settled[v] = true;
+                        order.push_back(v);
+
+                        const auto Nv = G.neighbours(v);
+                        const auto Wv = G.neighbourWeights(v);
+                        for (size_t i = 0; i < Nv.size(); i++) {
+                            const auto u = Nv[i];
+                            if (settled[u]) {
+                                continue;
+                            }
+
+                            // Only improvements need (re-)queueing.
+                            const auto du = d + Wv[i];
+                            const auto improved = du < distance[u];
+                            relax(v, u, du);
+                            if (improved) {
+                                Q.emplace(du, u);
+                            }
+                        }
+                    }
+                }
+
+                // Accumulate dependencies in order of non-increasing distance.
+                for (auto it = order.rbegin(); it != order.rend(); ++it) {
+                    const auto w = *it;
+                    for (const auto v : predecessors[w]) {
+                        delta[v] += sigma[v] / sigma[w] * (1 + delta[w]);
+                    }
+                    if (w != s) {
+                        centrality[w] += delta[w];
+                    }
+                }
+            }
+        }, numThreads);
+
+        // Reduce the per thread partial sums.
+        std::vector<R> result(N, 0);
+        for (const auto& partial : partials) {
+            for (size_t v = 0; v < partial.size(); v++) {
+                result[v] += partial[v];
+            }
+        }
+
+        if (!G.isDirected()) {
+            for (auto& c : result) {
+                c /= 2;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Computes the betweenness centrality of every vertex with
+     * Brandes' algorithm.
+     *
+     * See the `CSRGraph` overload for details.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam R Centrality type.
+     * @param G The graph.
+     * @param weighted Whether to use the edge weights as path lengths.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return std::unordered_map<T, R> The centrality of each vertex.
+     */
+    template<typename T, typename U = double, typename R = double>
+    inline std::unordered_map<T, R> betweennessCentrality(const DataStructures::Graphs::Graph<T, U>& G,
+                                                          bool weighted = false,
+                                                          unsigned int numThreads = 0) {
+        const DataStructures::Graphs::CSRGraph<T, U> C(G, numThreads);
+        const auto scores = betweennessCentrality<T, U, R>(C, weighted, numThreads);
+
+        std::unordered_map<T, R> result;
+        result.reserve(scores.size());
+        for (size_t i = 0; i < scores.size(); i++) {
+            result.emplace(C.getVertices()[i], scores[i]);
+        }
+        return result;
+    }
+}
+
+#endif
@@ -0,0 +1,336 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_ALGORITHMS_CONNECTED_COMPONENTS
+#define CPP_UTILS_ALGORITHMS_CONNECTED_COMPONENTS
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <CPPUtils/Concurrency/Parallel.hpp>
+#include <CPPUtils/DataStructures/Graph.hpp>
+
+namespace CPPUtils::Algorithms {
+
+    /**
+     * @brief A lock-free disjoint set forest over the elements `[0, n)`.
+     *
+     * `find` and `unite` may be called concurrently from any number of
+     * threads. Roots are always linked towards the smaller index, so every
+     * parent pointer satisfies `parent[i] <= i` and the forest can never
+     * contain a cycle. Paths are shortened with path halving, where a failed
+     * compare-and-swap is harmless and simply skipped.
+     */
+    class ConcurrentUnionFind final {
+    private:
+        std::vector<std::atomic<size_t>> parent;
+
+    public:
+        /**
+         * @brief Construct a new Concurrent Union Find object with `n`
+         * singleton sets.
+         *
+         * @param n The number of elements.
+         */
+        explicit ConcurrentUnionFind(size_t n) :
+            parent(n) {
+            for (size_t i = 0; i < n; i++) {
+                parent[i].store(i, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Provides the number of elements in the forest.
+         *
+         * @return size_t The element count.
+         */
+        size_t size() const {
+            return parent.size();
+        }
+
+        /**
+         * @brief Finds the representative of the set containing `a`.
+         *
+         * @param a The query element.
+         * @return size_t The root of the set containing `a`.
+         */
+        size_t find(size_t a) {
+            while (true) {
+                auto p = parent[a].load(std::memory_order_acquire);
+                if (p == a) {
+                    return a;
+                }
+
+                // Path halving - point a at its grandparent.
+                const auto gp = parent[p].load(std::memory_order_acquire);
+                if (p != gp) {
+                    parent[a].compare_exchange_weak(p, gp,
+                                                    std::memory_order_release,
+                                                    std::memory_order_relaxed);
+                }
+                a = gp;
+            }
+        }
+
+        /**
+         * @brief Merges the sets containing `a` and `b`.
+         *
+         * @param a An element.
+         * @param b Another element.
+         * @return true If two distinct sets were merged by this call.
+         * @return false If `a` and `b` were already in the same set.
+         */
+        bool unite(size_t a, size_t b) {
+            while (true) {
+                a = find(a);
+                b = find(b);
+                if (a == b) {
+                    return false;
+                }
+
+                // Link the larger root beneath the smaller one.
+                if (a < b) {
+                    std::swap(a, b);
+                }
+
+                // Only succeeds if a is still a root, otherwise retry.
+                auto expected = a;
+                if (parent[a].compare_exchange_strong(expected, b,
+                                                      std::memory_order_acq_rel)) {
+                    return true;
+                }
+            }
+        }
+
+        /**
+         * @brief Determines if `a` and `b` are in the same set.
+         *
+         * @param a An element.
+         * @param b Another element.
+         * @return true If `a` and `b` share a root.
+         * @return false Otherwise.
+         */
+        bool sameSet(size_t a, size_t b) {
+            while (true) {
+                a = find(a);
+                b = find(b);
+                if (a == b) {
+                    return true;
+                }
+
+                // If a is still a root then the answer is linearisable.
+                if (parent[a].load(std::memory_order_acquire) == a) {
+                    return false;
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief A dense labelling of the vertices of a graph.
+     *
+     * Labels are contiguous, in the range `[0, numComponents)`.
+     *
+     * @tparam T Vertex type.
+     */
+    template<typename T>
+    struct ComponentLabelling final {
+        std::unordered_map<T, size_t> labels;
+        size_t numComponents = 0;
+    };
+
+    /**
+     * @brief Computes the connected components of `G`.
+     *
+     * Directed graphs are treated as undirected, so this provides the weakly
+     * connected components in that case. Edges are merged into a
+     * `ConcurrentUnionFind` in parallel, one block of source vertices per
+     * thread, after which the roots are compacted into dense labels.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return ComponentLabelling<T> The component of each vertex.
+     */
+    template<typename T, typename U = double>
+    inline ComponentLabelling<T> connectedComponents(
+        const DataStructures::Graphs::Graph<T, U>& G, unsigned int numThreads = 0) {
+        // Assign each vertex a dense index.
+        const auto vertices = G.getVertices();
+        const auto N = vertices.size();
+
+        std::unordered_map<T, size_t> index;
+        index.reserve(N);
+        for (size_t i = 0; i < N; i++) {
+            index.emplace(vertices[i], i);
+        }
+
+        // Merge the endpoints of every edge.
+        ConcurrentUnionFind sets(N);
+        Concurrency::parallelFor(0, N, [&](size_t i) {
+            for (const auto& e : G.getAdjacencyList(vertices[i])) {
+                sets.unite(i, index.at(e.getVertex()));
+            }
+        }, numThreads);
+
+        // Compact the roots into dense labels.
+        constexpr auto unset = (std::numeric_limits<size_t>::max)();
+        std::vector<size_t> rootLabels(N, unset);
+
+        ComponentLabelling<T> result;
+        result.labels.reserve(N);
+        for (size_t i = 0; i < N; i++) {
+            auto& label = rootLabels[sets.find(i)];
+            if (label == unset) {
+                label = result.numComponents++;
+            }
+            result.labels.emplace(vertices[i], label);
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Computes the strongly connected components of `G` with an
+     * iterative formulation of Tarjan's algorithm.
+     *
+     * Components are labelled in the order in which Tarjan's algorithm
+     * completes them, which is a reverse topological order of the
+     * condensation of `G`. For undirected graphs this is equivalent to
+     * `connectedComponents`.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @return ComponentLabelling<T> The strongly connected component of
+     * each vertex.
+     */
+    template<typename T, typename U = double>
+    inline ComponentLabelling<T> stronglyConnectedComponents(
+        const DataStructures::Graphs::Graph<T, U>& G) {
+        // Assign each vertex a dense index.
+        const auto vertices = G.getVertices();
+        const auto N = vertices.size();
+
+        std::unordered_map<T, size_t> index;
+        index.reserve(N);
+        for (size_t i = 0; i < N; i++) {
+            index.emplace(vertices[i], i);
+        }
+
+        constexpr auto unset = (std::numeric_limits<size_t>::max)();
+        std::vector<size_t> order(N, unset);
+        std::vector<size_t> lowLink(N, 0);
+        std::vector<size_t> labels(N, unset);
+        std::vector<bool> onStack(N, false);
+
+        // Tarjan's vertex stack, plus an explicit DFS stack of
+        // (vertex, next adjacency position) in place of recursion.
+        std::vector<size_t> S;
+        std::vector<std::pair<size_t, size_t>> dfs;
+
+        size_t counter = 0;
+        size_t numComponents = 0;
+        for (size_t root = 0; root < N; root++) {
+            if (order[root] != unset) {
+                continue;
+            }
+
+            dfs.emplace_back(root, 0);
+            while (!dfs.empty()) {
+                auto& [v, pos] = dfs.back();
+
+                // First visit to v.
+                if (pos == 0 && order[v] == unset) {
+                    order[v] = lowLink[v] = counter++;
+                    S.push_back(v);
+                    onStack[v] = true;
+                }
+
+                // Descend into the next unvisited neighbour, if any.
+                const auto& adj = G.getAdjacencyList(vertices[v]);
+                bool descended = false;
+                while (pos < adj.size()) {
+                    const auto u = index.at(adj[pos++].getVertex());
+                    if (order[u] == unset) {
+                        dfs.emplace_back(u, 0);
+                        descended = true;
+                        break;
+                    }
+                    if (onStack[u]) {
+                        lowLink[v] = (std::min)(lowLink[v], order[u]);
+                    }
+                }
+                if (descended) {
+                    continue;
+                }
+
+                // All neighbours done - v roots a component if no back edge
+                // escapes it.
+                const auto w = v;
+                if (lowLink[w] == order[w]) {
+                    size_t x;
+                    do {
+                        x = S.back();
+                        S.pop_back();
+                        onStack[x] = false;
+                        labels[x] = numComponents;
+                    } while (x != w);
+                    numComponents++;
+                }
+
+                // Propagate the low link to the parent.
+                dfs.pop_back();
+                if (!dfs.empty()) {
+                    const auto p = dfs.back().first;
+                    lowLink[p] = (std::min)(lowLink[p], lowLink[w]);
+                }
+            }
+        }
+
+        ComponentLabelling<T> result;
+        result.numComponents = numComponents;
+        result.labels.reserve(N);
+        for (size_t i = 0; i < N; i++) {
+            result.labels.emplace(vertices[i], labels[i]);
+        }
+        return result;
+    }
+}
+
+#endif
@@ -0,0 +1,1000 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_ALGORITHMS_CONTRACTION_HIERARCHIES
+#define CPP_UTILS_ALGORITHMS_CONTRACTION_HIERARCHIES
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <CPPUtils/Algorithms/SearchState.hpp>
+#include <CPPUtils/Concurrency/Parallel.hpp>
+#include <CPPUtils/DataStructures/CSRGraph.hpp>
+#include <CPPUtils/DataStructures/Graph.hpp>
+
+namespace CPPUtils::Algorithms {
+
+    /**
+     * @brief The fixed size header at the start of a contraction hierarchy
+     * file.
+     *
+     * The header is followed by the vertex keys, the ranks, and then the
+     * offsets, targets, middle vertices and weights of the upward and then
+     * the downward search graph. All values are stored in host byte order.
+     */
+    struct ContractionHierarchyFileHeader final {
+        static constexpr char expectedMagic[8] = { 'C', 'P', 'P', 'U', 'C', 'H', 'F', '\0' };
+        static constexpr std::uint32_t currentVersion = 1;
+
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t keySize;
+        std::uint32_t weightSize;
+        std::uint32_t reserved;
+        std::uint64_t numVertices;
+        std::uint64_t numUpwardArcs;
+        std::uint64_t numDownwardArcs;
+        std::uint64_t numShortcuts;
+    };
+
+    namespace Detail {
+
+        // An arc of the graph being contracted; `middle` is the vertex a
+        // shortcut bypasses.
+        template<typename U>
+        struct ContractionArc final {
+            DataStructures::Graphs::VertexIndex target;
+            DataStructures::Graphs::VertexIndex middle;
+            U weight;
+        };
+
+        template<typename U>
+        using ContractionArcs = std::vector<std::vector<ContractionArc<U>>>;
+
+        // Adds an arc, or lowers the weight of an existing one to the same
+        // target.
+        template<typename U>
+        inline void upsertArc(std::vector<ContractionArc<U>>& arcs, const ContractionArc<U>& arc) {
+            for (auto& existing : arcs) {
+                if (existing.target == arc.target) {
+                    if (arc.weight < existing.weight) {
+                        existing = arc;
+                    }
+                    return;
+                }
+            }
+            arcs.push_back(arc);
+        }
+
+        // A bounded Dijkstra search, used to look for paths that make a
+        // shortcut unnecessary.
+        template<typename U>
+        class WitnessSearch {
+            std::vector<U> costs;
+            std::vector<std::uint32_t> reachedIn;
+            std::uint32_t generation;
+            std::vector<std::pair<U, DataStructures::Graphs::VertexIndex>> heap;
+
+        public:
+            explicit WitnessSearch(size_t N) : costs(N), reachedIn(N, 0), generation(0) {
+                //
+            }
+
+            template<typename Usable>
+            void run(const ContractionArcs<U>& out,
+                     DataStructures::Graphs::VertexIndex source,
+                     Usable&& usable,
+                     U limit,
+                     size_t maxSettled) {
+                nextGeneration(generation, reachedIn);
+
+                heap.clear();
+                reachedIn[source] = generation;
+                costs[source] = 0;
+                heap.emplace_back(0, source);
+
+                size_t settled = 0;
+                while (!heap.empty()) {
+                    std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+                    const auto [cost, v] = heap.back();
+                    heap.pop_back();
+                    if (costs[v] < cost) {
+                        continue;
+                    }
+                    if (limit < cost || ++settled > maxSettled) {
+                        break;
+                    }
+
+                    for (const auto& arc : out[v]) {
+                        const auto x = arc.target;
+                        const auto next = cost + arc.weight;
+                        if (!usable(x) || limit < next) {
+                            continue;
+                        }
+                        if (reachedIn[x] != generation || next < costs[x]) {
+                            reachedIn[x] = generation;
+                            costs[x] = next;
+                            heap.emplace_back(next, x);
+                            std::push_heap(heap.begin(), heap.end(), std::greater<>());
+                        }
+                    }
+                }
+            }
+
+            // Whether a path to `v` costing at most `cost` was found.
+            bool hasWitness(DataStructures::Graphs::VertexIndex v, U cost) const {
+                return reachedIn[v] == generation && !(cost < costs[v]);
+            }
+        };
+    }
+
+    /**
+     * @brief A contraction hierarchy over a graph with non-negative weights,
+     * for fast point-to-point shortest path queries.
+     *
+     * Vertices are contracted in order of priority: the edge difference
+     * (shortcuts added less arcs removed) plus the number of neighbours
+     * already contracted, which spreads contraction evenly over the graph.
+     * Contracting a vertex adds a shortcut between each pair of its
+     * remaining neighbours, unless a bounded witness search finds a path
+     * at least as short that avoids it. Each round contracts, in parallel, a
+     * set of vertices that are not adjacent and each have lower priority
+     * than all of their neighbours.
+     *
+     * The result is an upward graph, of arcs to higher ranked vertices, and
+     * a downward graph, of reversed arcs from higher ranked vertices, which
+     * `ContractionHierarchyQuery` searches from the source and the target
+     * respectively.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     */
+    template<typename T, typename U = double>
+    class ContractionHierarchy {
+    public:
+        using VertexIndex = DataStructures::Graphs::VertexIndex;
+        using EdgeIndex = DataStructures::Graphs::EdgeIndex;
+
+        /**
+         * @brief Marks absent vertices, and arcs that are not shortcuts.
+         *
+         */
+        static constexpr VertexIndex invalidVertex = DataStructures::Graphs::CSRGraph<T, U>::invalidVertex;
+
+        /**
+         * @brief One of the two search graphs, in CSR form.
+         *
+         * `middles` holds the vertex each shortcut bypasses, or
+         * `invalidVertex` for original edges.
+         */
+        struct SearchGraph final {
+            std::vector<EdgeIndex> offsets;
+            std::vector<VertexIndex> targets;
+            std::vector<VertexIndex> middles;
+            std::vector<U> weights;
+
+            /**
+             * @brief Finds the arc from `v` to `u`.
+             *
+             * @param v The vertex whose arcs to search.
+             * @param u The arc target.
+             * @return EdgeIndex The arc, or the arc count if there is none.
+             */
+            EdgeIndex find(VertexIndex v, VertexIndex u) const {
+                for (auto e = offsets[v]; e < offsets[v + 1]; e++) {
+                    if (targets[e] == u) {
+                        return e;
+                    }
+                }
+                return targets.size();
+            }
+        };
+
+    protected:
+        std::vector<T> keys;
+        std::unordered_map<T, VertexIndex> lookup;
+        std::vector<VertexIndex> ranks;
+        SearchGraph upward;
+        SearchGraph downward;
+        size_t shortcutCount;
+
+        ContractionHierarchy() : shortcutCount(0) {
+            //
+        }
+
+        void buildLookup() {
+            lookup.clear();
+            lookup.reserve(keys.size());
+            for (size_t v = 0; v < keys.size(); v++) {
+                lookup.emplace(keys[v], static_cast<VertexIndex>(v));
+            }
+        }
+
+        void contract(const DataStructures::Graphs::CSRGraph<T, U>& G,
+                      unsigned int numThreads,
+                      size_t witnessSettleLimit) {
+            using Arc = Detail::ContractionArc<U>;
+
+            const auto N = G.getVertexCardinality();
+            Detail::ContractionArcs<U> out(N);
+            Detail::ContractionArcs<U> in(N);
+            for (VertexIndex u = 0; u < N; u++) {
+                const auto Nu = G.neighbours(u);
+                const auto Wu = G.neighbourWeights(u);
+                for (size_t i = 0; i < Nu.size(); i++) {
+                    if constexpr (std::is_signed_v<U>) {
+                        if (Wu[i] < 0) {
+                            throw std::invalid_argument("Contraction hierarchies require non-negative weights.");
+                        }
+                    }
+                    if (Nu[i] != u) {
+                        Detail::upsertArc(out[u], Arc{ Nu[i], invalidVertex, Wu[i] });
+                        Detail::upsertArc(in[Nu[i]], Arc{ u, invalidVertex, Wu[i] });
+                    }
+                }
+            }
+
+            // Remaining, being contracted this round, or contracted.
+            enum : std::uint8_t { REMAINING = 0, CONTRACTING = 1, CONTRACTED = 2 };
+            std::vector<std::uint8_t> state(N, REMAINING);
+            std::vector<std::int64_t> priorities(N, 0);
+            std::vector<std::uint32_t> contractedNeighbours(N, 0);
+            std::vector<std::uint8_t> dirty(N, 1);
+
+            const auto workers = Concurrency::resolveThreadCount(numThreads);
+            std::vector<Detail::WitnessSearch<U>> searches;
+            searches.reserve(workers);
+            for (unsigned int t = 0; t < workers; t++) {
+                searches.emplace_back(N);
+            }
+
+            // Calls `emit(u, x, weight)` for each shortcut needed to contract
+            // `v`, with witness searches avoiding `v` and non-remaining
+            // vertices.
+            const auto forEachShortcut = [&](VertexIndex v, Detail::WitnessSearch<U>& search, auto&& emit) {
+                const auto usable = [&](VertexIndex x) {
+                    return x != v && state[x] == REMAINING;
+                };
+
+                for (const auto& first : in[v]) {
+                    const auto u = first.target;
+                    if (state[u] != REMAINING) {
+                        continue;
+                    }
+
+                    bool any = false;
+                    U longest = 0;
+                    for (const auto& second : out[v]) {
+                        if (second.target != u && state[second.target] == REMAINING) {
+                            longest = any ? std::max(longest, second.weight) : second.weight;
+                            any = true;
+                        }
+                    }
+                    if (!any) {
+                        continue;
+                    }
+
+                    search.run(out, u, usable, first.weight + longest, witnessSettleLimit);
+                    for (const auto& second : out[v]) {
+                        const auto x = second.target;
+                        const auto weight = first.weight + second.weight;
+                        if (x != u && state[x] == REMAINING && !search.hasWitness(x, weight)) {
+                            emit(u, x, weight);
+                        }
+                    }
+                }
+            };
+
+            const auto remainingDegree = [&](VertexIndex v) {
+                std::int64_t degree = 0;
+                for (const auto* arcs : { &in[v], &out[v] }) {
+                    for (const auto& arc : *arcs) {
+                        degree += state[arc.target] == REMAINING ? 1 : 0;
+                    }
+                }
+                return degree;
+            };
+
+            // Orders by priority, breaking ties by a hash of the index so that
+            // equal priorities are not contracted in index order.
+            const auto before = [&](VertexIndex a, VertexIndex b) {
+                const auto mix = [](VertexIndex v) { return static_cast<std::uint32_t>(v * 2654435761u); };
+                return priorities[a] != priorities[b] ? priorities[a] < priorities[b] :
+                       mix(a) != mix(b) ? mix(a) < mix(b) : a < b;
+            };
+
+            struct Shortcut final {
+                VertexIndex from;
+                VertexIndex to;
+                VertexIndex middle;
+                U weight;
+            };
+
+            std::vector<VertexIndex> remaining(N);
+            for (VertexIndex v = 0; v < N; v++) {
+                remaining[v] = v;
+            }
+            std::vector<std::uint8_t> selected(N, 0);
+            std::vector<std::vector<Shortcut>> shortcuts(workers);
+            ranks.assign(N, 0);
+            VertexIndex nextRank = 0;
+            shortcutCount = 0;
+
+            while (!remaining.empty()) {
+                // Refresh the priorities of vertices whose neighbourhoods
+                // changed.
+                Concurrency::parallelForBlocks(0, remaining.size(), [&](size_t t, size_t first, size_t last) {
+                    for (auto i = first; i < last; i++) {
+                        const auto v = remaining[i];
+                        if (dirty[v]) {
+                            std::int64_t added = 0;
+                            forEachShortcut(v, searches[t], [&added](VertexIndex, VertexIndex, U) { added++; });
+                            priorities[v] = added - remainingDegree(v) + contractedNeighbours[v];
+                            dirty[v] = 0;
+                        }
+                    }
+                }, workers);
+
+                // Select the vertices that come before all of their
+                // remaining neighbours; no two are adjacent.
+                Concurrency::parallelFor(0, remaining.size(), [&](size_t i) {
+                    const auto v = remaining[i];
+                    bool minimal = true;
+                    for (const auto* arcs : { &in[v], &out[v] }) {
+                        for (const auto& arc : *arcs) {
+                            if (state[arc.target] == REMAINING && !before(v, arc.target)) {
+                                minimal = false;
+                            }
+                        }
+                    }
+                    selected[v] = minimal ? 1 : 0;
+                }, workers);
+
+                std::vector<VertexIndex> round;
+                for (const auto v : remaining) {
+                    if (selected[v]) {
+                        round.push_back(v);
+                        state[v] = CONTRACTING;
+                    }
+                }
+
+                // Find the shortcuts for the whole round in parallel; witness
+                // searches avoid every vertex being contracted, so that no
+                // two contractions rely on each other's paths.
+                Concurrency::parallelForBlocks(0, round.size(), [&](size_t t, size_t first, size_t last) {
+                    for (auto i = first; i < last; i++) {
+                        const auto v = round[i];
+                        forEachShortcut(v, searches[t], [&](VertexIndex u, VertexIndex x, U weight) {
+                            shortcuts[t].push_back({ u, x, v, weight });
+                        });
+                    }
+                }, workers);
+
+                for (auto& list : shortcuts) {
+                    for (const auto& s : list) {
+                        Detail::upsertArc(out[s.from], Arc{ s.to, s.middle, s.weight });
+                        Detail::upsertArc(in[s.to], Arc{ s.from, s.middle, s.weight });
+                        dirty[s.from] = 1;
+                        dirty[s.to] = 1;
+                    }
+                    shortcutCount += list.size();
+                    list.clear();
+                }
+
+                for (const auto v : round) {
+                    ranks[v] = nextRank++;
+                    state[v] = CONTRACTED;
+                    for (const auto* arcs : { &in[v], &out[v] }) {
+                        for (const auto& arc : *arcs) {
+                            if (state[arc.target] == REMAINING) {
+                                contractedNeighbours[arc.target]++;
+                                dirty[arc.target] = 1;
+                            }
+                        }
+                    }
+                }
+
+                std::erase_if(remaining, [&state](VertexIndex v) { return state[v] == CONTRACTED; });
+            }
+
+            // Split the arcs by rank into the two search graphs.
+            const auto build = [&](SearchGraph& S, bool up) {
+                S.offsets.assign(N + 1, 0);
+                for (VertexIndex u = 0; u < N; u++) {
+                    for (const auto& arc : out[u]) {
+                        const auto owner = up ? u : arc.target;
+                        if ((ranks[arc.target] > ranks[u]) == up) {
+                            S.offsets[owner + 1]++;
+                        }
+                    }
+                }
+                for (size_t v = 0; v < N; v++) {
+                    S.offsets[v + 1] += S.offsets[v];
+                }
+
+                const auto M = S.offsets[N];
+                S.targets.resize(M);
+                S.middles.resize(M);
+                S.weights.resize(M);
+                std::vector<EdgeIndex> cursor(S.offsets.begin(), S.offsets.end() - 1);
+                for (VertexIndex u = 0; u < N; u++) {
+                    for (const auto& arc : out[u]) {
+                        if ((ranks[arc.target] > ranks[u]) == up) {
+                            const auto slot = cursor[up ? u : arc.target]++;
+                            S.targets[slot] = up ? arc.target : u;
+                            S.middles[slot] = arc.middle;
+                            S.weights[slot] = arc.weight;
+                        }
+                    }
+                }
+            };
+            build(upward, true);
+            build(downward, false);
+        }
+
+    public:
+        /**
+         * @brief Construct a new Contraction Hierarchy object by contracting
+         * `G`.
+         *
+         * @param G The graph, with non-negative weights.
+         * @param numThreads The number of threads to use, 0 for the default.
+         * @param witnessSettleLimit The most vertices each witness search may
+         * settle; lower values contract faster but add more shortcuts.
+         */
+        explicit ContractionHierarchy(const DataStructures::Graphs::CSRGraph<T, U>& G,
+                                      unsigned int numThreads = 0,
+                                      size_t witnessSettleLimit = 500) :
+            keys(G.getVertices().begin(), G.getVertices().end()),
+            shortcutCount(0) {
+            buildLookup();
+            contract(G, numThreads, witnessSettleLimit);
+        }
+
+        /**
+         * @brief Construct a new Contraction Hierarchy object by contracting
+         * `G`.
+         *
+         * @param G The graph, with non-negative weights.
+         * @param numThreads The number of threads to use, 0 for the default.
+         * @param witnessSettleLimit The most vertices each witness search may
+         * settle.
+         */
+        explicit ContractionHierarchy(const DataStructures::Graphs::Graph<T, U>& G,
+                                      unsigned int numThreads = 0,
+                                      size_t witnessSettleLimit = 500) :
+            ContractionHierarchy(DataStructures::Graphs::CSRGraph<T, U>(G, numThreads), numThreads, witnessSettleLimit) {
+            //
+        }
+
+        ContractionHierarchy(const ContractionHierarchy&) = default;
+        ContractionHierarchy& operator=(const ContractionHierarchy&) = default;
+        ContractionHierarchy(ContractionHierarchy&&) noexcept = default;
+        ContractionHierarchy& operator=(ContractionHierarchy&&) noexcept = default;
+
+        virtual ~ContractionHierarchy() {
+            //
+        }
+
+        /**
+         * @brief Provides the number of vertices.
+         *
+         * @return size_t The vertex count.
+         */
+        size_t getVertexCardinality() const {
+            return keys.size();
+        }
+
+        /**
+         * @brief Provides the number of shortcuts added by contraction.
+         *
+         * @return size_t The shortcut count.
+         */
+        size_t getShortcutCount() const {
+            return shortcutCount;
+        }
+
+        /**
+         * @brief Provides the index of vertex `v`.
+         *
+         * @param v The vertex key.
+         * @return VertexIndex The index, or `invalidVertex`.
+         */
+        VertexIndex indexOf(const T& v) const {
+            const auto it = lookup.find(v);
+            return it == lookup.end() ? invalidVertex : it->second;
+        }
+
+        /**
+         * @brief Provides the key of the vertex at index `v`.
+         *
+         * @param v The vertex index.
+         * @return const T& The vertex key.
+         */
+        const T& vertexAt(VertexIndex v) const {
+            return keys[v];
+        }
+
+        /**
+         * @brief Provides the position of `v` in the contraction order.
+         *
+         * @param v The vertex index.
+         * @return VertexIndex The rank; higher ranks were contracted later.
+         */
+        VertexIndex getRank(VertexIndex v) const {
+            return ranks[v];
+        }
+
+        /**
+         * @brief Provides the arcs to higher ranked vertices.
+         *
+         * @return const SearchGraph& The upward graph.
+         */
+        const SearchGraph& getUpwardGraph() const {
+            return upward;
+        }
+
+        /**
+         * @brief Provides, for each vertex, the reversed arcs from higher
+         * ranked vertices.
+         *
+         * @return const SearchGraph& The downward graph.
+         */
+        const SearchGraph& getDownwardGraph() const {
+            return downward;
+        }
+
+        /**
+         * @brief Appends the original vertices along the hierarchy arc from
+         * `a` to `b` to `path`, excluding `a`.
+         *
+         * @param a The arc source.
+         * @param b The arc target.
+         * @param path Receives the vertices.
+         */
+        void unpack(VertexIndex a, VertexIndex b, std::vector<VertexIndex>& path) const {
+            std::vector<std::pair<VertexIndex, VertexIndex>> pending = { { a, b } };
+            while (!pending.empty()) {
+                const auto [x, y] = pending.back();
+                pending.pop_back();
+
+                // Arcs are stored at their lower ranked end.
+                const auto& S = ranks[y] > ranks[x] ? upward : downward;
+                const auto owner = ranks[y] > ranks[x] ? x : y;
+                const auto e = S.find(owner, owner == x ? y : x);
+                if (e == S.targets.size()) {
+                    throw std::invalid_argument("No hierarchy arc between the vertices.");
+                }
+
+                const auto middle = S.middles[e];
+                if (middle == invalidVertex) {
+                    path.push_back(y);
+                } else {
+                    pending.emplace_back(middle, y);
+                    pending.emplace_back(x, middle);
+                }
+            }
+        }
+
+        /**
+         * @brief Writes the hierarchy to `path`.
+         *
+         * @param path The output file path.
+         */
+        void save(const std::string& path) const {
+            static_assert(std::is_trivially_copyable_v<T>, "Vertex type must be trivially copyable.");
+            static_assert(std::is_trivially_copyable_v<U>, "Weight type must be trivially copyable.");
+
+            ContractionHierarchyFileHeader header{};
+            std::memcpy(header.magic, ContractionHierarchyFileHeader::expectedMagic, sizeof(header.magic));
+            header.version = ContractionHierarchyFileHeader::currentVersion;
+            header.keySize = sizeof(T);
+            header.weightSize = sizeof(U);
+            header.numVertices = keys.size();
+            header.numUpwardArcs = upward.targets.size();
+            header.numDownwardArcs = downward.targets.size();
+            header.numShortcuts = shortcutCount;
+
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                throw std::runtime_error("Unable to open file for writing: " + path);
+            }
+
+            const auto write = [&file](const auto& values) {
+                file.write(reinterpret_cast<const char*>(values.data()),
+                           static_cast<std::streamsize>(values.size() * sizeof(values[0])));
+            };
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            write(keys);
+            write(ranks);
+            for (const auto* S : { &upward, &downward }) {
+                write(S->offsets);
+                write(S->targets);
+                write(S->middles);
+                write(S->weights);
+            }
+
+            if (!file) {
+                throw std::runtime_error("Unable to write contraction hierarchy file: " + path);
+            }
+        }
+
+        /**
+         * @brief Reads a hierarchy written by `save`.
+         *
+         * @param path The input file path.
+         * @return ContractionHierarchy The hierarchy.
+         */
+        static ContractionHierarchy load(const std::string& path) {
+            static_assert(std::is_trivially_copyable_v<T>, "Vertex type must be trivially copyable.");
+            static_assert(std::is_trivially_copyable_v<U>, "Weight type must be trivially copyable.");
+
+            std::ifstream file(path, std::ios::binary);
+            if (!file) {
+                throw std::runtime_error("Unable to open file for reading: " + path);
+            }
+
+            ContractionHierarchyFileHeader header;
+            if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+                throw std::runtime_error("Contraction hierarchy file is truncated: " + path);
+            }
+            if (std::memcmp(header.magic, ContractionHierarchyFileHeader::expectedMagic, sizeof(header.magic)) != 0) {
+                throw std::runtime_error("Not a contraction hierarchy file: " + path);
+            }
+            if (header.version != ContractionHierarchyFileHeader::currentVersion) {
+                throw std::runtime_error("Unsupported contraction hierarchy file version: " + path);
+            }
+            if (header.keySize != sizeof(T) || header.weightSize != sizeof(U)) {
+                throw std::runtime_error("Contraction hierarchy file vertex or weight type mismatch: " + path);
+            }
+
+            // Check the sizes against the file before allocating. With N
+            // below 2^32 the per vertex bytes can't overflow; the arc counts
+            // are bounded by division before anything is multiplied.
+            const auto N = header.numVertices;
+            const auto start = file.tellg();
+            file.seekg(0, std::ios::end);
+            const auto available = static_cast<std::uint64_t>(file.tellg() - start);
+            file.seekg(start);
+            if (N >= invalidVertex) {
+                throw std::runtime_error("Contraction hierarchy file is corrupt: " + path);
+            }
+            const std::uint64_t vertexBytes = N * (sizeof(T) + sizeof(VertexIndex)) + 2 * (N + 1) * sizeof(EdgeIndex);
+            const std::uint64_t arcBytes = 2 * sizeof(VertexIndex) + sizeof(U);
+            const auto maxArcs = vertexBytes <= available ? (available - vertexBytes) / arcBytes : 0;
+            if (vertexBytes > available || header.numUpwardArcs > maxArcs ||
+                header.numDownwardArcs > maxArcs - header.numUpwardArcs ||
+                vertexBytes + (header.numUpwardArcs + header.numDownwardArcs) * arcBytes != available) {
+                throw std::runtime_error("Contraction hierarchy file is corrupt: " + path);
+            }
+
+            ContractionHierarchy H;
+            const auto read = [&file](auto& values, std::uint64_t count) {
+                values.resize(count);
+                file.read(reinterpret_cast<char*>(values.data()),
+                          static_cast<std::streamsize>(count * sizeof(values[0])));
+            };
+            read(H.keys, N);
+            read(H.ranks, N);
+            for (auto [S, M] : { std::pair{ &H.upward, header.numUpwardArcs },
+                                 std::pair{ &H.downward, header.numDownwardArcs } }) {
+                read(S->offsets, N + 1);
+                read(S->targets, M);
+                read(S->middles, M);
+                read(S->weights, M);
+            }
+            if (!file) {
+                throw std::runtime_error("Contraction hierarchy file is truncated: " + path);
+            }
+
+            // Ranks must be a permutation, as they order the unpacking.
+            std::vector<bool> ranked(N, false);
+            for (const auto r : H.ranks) {
+                if (r >= N || ranked[r]) {
+                    throw std::runtime_error("Contraction hierarchy file is corrupt: " + path);
+                }
+                ranked[r] = true;
+            }
+
+            // Reject arrays that would send a query out of bounds, and
+            // shortcuts whose middle isn't ranked below both ends, which
+            // could unpack forever.
+            for (auto [S, M] : { std::pair{ &H.upward, header.numUpwardArcs },
+                                 std::pair{ &H.downward, header.numDownwardArcs } }) {
+                if (S->offsets.front() != 0 || S->offsets.back() != M ||
+                    !std::is_sorted(S->offsets.begin(), S->offsets.end())) {
+                    throw std::runtime_error("Contraction hierarchy file is corrupt: " + path);
+                }
+                for (VertexIndex a = 0; a < N; a++) {
+                    for (auto e = S->offsets[a]; e < S->offsets[a + 1]; e++) {
+                        const auto b = S->targets[e];
+                        const auto middle = S->middles[e];
+                        if (b >= N || (middle != invalidVertex &&
+                                       (middle >= N || H.ranks[middle] >= (std::min)(H.ranks[a], H.ranks[b])))) {
+                            throw std::runtime_error("Contraction hierarchy file is corrupt: " + path);
+                        }
+                    }
+                }
+            }
+
+            H.shortcutCount = header.numShortcuts;
+            H.buildLookup();
+            return H;
+        }
+    };
+
+    /**
+     * @brief Reusable state for shortest path queries on a
+     * `ContractionHierarchy`.
+     *
+     * Runs Dijkstra upward from the source and, on the downward graph,
+     * upward from the target, each until its least key reaches the best
+     * meeting cost. State is reset lazily between queries by generation
+     * stamps. Not thread safe; use one query object per thread.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     */
+    template<typename T, typename U = double>
+    class ContractionHierarchyQuery {
+    public:
+        using VertexIndex = DataStructures::Graphs::VertexIndex;
+
+        /**
+         * @brief The cost of a target that was not reached.
+         *
+         */
+        static constexpr U infinity = Detail::infinityOf<U>();
+
+    protected:
+        using Hierarchy = ContractionHierarchy<T, U>;
+        using HeapEntry = std::pair<U, VertexIndex>;
+
+        struct Side final {
+            const typename Hierarchy::SearchGraph* graph;
+            std::vector<U> costs;
+            std::vector<VertexIndex> parents;
+            std::vector<std::uint32_t> reachedIn;
+            std::vector<std::uint32_t> settledIn;
+            std::vector<HeapEntry> heap;
+        };
+
+        const Hierarchy& H;
+        Side forward;
+        Side backward;
+        std::uint32_t generation;
+        U best;
+        VertexIndex meeting;
+        size_t settledCount;
+
+        void start(Side& side, VertexIndex v) {
+            side.heap.clear();
+            side.reachedIn[v] = generation;
+            side.costs[v] = 0;
+            side.parents[v] = v;
+            side.heap.emplace_back(0, v);
+        }
+
+        void expand(Side& self, const Side& other) {
+            std::pop_heap(self.heap.begin(), self.heap.end(), std::greater<>());
+            const auto [cost, v] = self.heap.back();
+            self.heap.pop_back();
+            if (self.settledIn[v] == generation || self.costs[v] < cost) {
+                return;
+            }
+            self.settledIn[v] = generation;
+            settledCount++;
+
+            if (other.reachedIn[v] == generation && cost + other.costs[v] < best) {
+                best = cost + other.costs[v];
+                meeting = v;
+            }
+
+            const auto& S = *self.graph;
+            for (auto e = S.offsets[v]; e < S.offsets[v + 1]; e++) {
+                const auto u = S.targets[e];
+                const auto next = cost + S.weights[e];
+                if (self.reachedIn[u] != generation || next < self.costs[u]) {
+                    self.reachedIn[u] = generation;
+                    self.costs[u] = next;
+                    self.parents[u] = v;
+                    self.heap.emplace_back(next, u);
+                    std::push_heap(self.heap.begin(), self.heap.end(), std::greater<>());
+                }
+            }
+        }
+
+    public:
+        /**
+         * @brief Construct a new Contraction Hierarchy Query object for `H`.
+         *
+         * `H` must outlive the query object.
+         *
+         * @param H The hierarchy to query.
+         */
+        explicit ContractionHierarchyQuery(const Hierarchy& H) :
+            H(H),
+            generation(0),
+            best(infinity),
+            meeting(Hierarchy::invalidVertex),
+            settledCount(0) {
+            const auto N = H.getVertexCardinality();
+            for (auto* side : { &forward, &backward }) {
+                side->costs.resize(N);
+                side->parents.resize(N);
+                side->reachedIn.assign(N, 0);
+                side->settledIn.assign(N, 0);
+            }
+            forward.graph = &H.getUpwardGraph();
+            backward.graph = &H.getDownwardGraph();
+        }
+
+        virtual ~ContractionHierarchyQuery() {
+            //
+        }
+
+        /**
+         * @brief Finds a shortest path from `source` to `target`.
+         *
+         * @param source The starting vertex.
+         * @param target The goal vertex.
+         * @return true If `target` is reachable.
+         * @return false Otherwise.
+         */
+        bool search(VertexIndex source, VertexIndex target) {
+            best = infinity;
+            meeting = Hierarchy::invalidVertex;
+            settledCount = 0;
+            if (source >= H.getVertexCardinality() || target >= H.getVertexCardinality()) {
+                return false;
+            }
+
+            Detail::nextGeneration(generation, forward.reachedIn, forward.settledIn,
+                                   backward.reachedIn, backward.settledIn);
+
+            start(forward, source);
+            start(backward, target);
+
+            // Each side continues while its least key could still improve on
+            // the best meeting; the side with the smaller key goes first.
+            while (true) {
+                const bool forwardLive = !forward.heap.empty() && forward.heap.front().first < best;
+                const bool backwardLive = !backward.heap.empty() && backward.heap.front().first < best;
+                if (!forwardLive && !backwardLive) {
+                    break;
+                }
+
+                if (forwardLive && (!backwardLive || !(backward.heap.front().first < forward.heap.front().first))) {
+                    expand(forward, backward);
+                } else {
+                    expand(backward, forward);
+                }
+            }
+            return meeting != Hierarchy::invalidVertex;
+        }
+
+        /**
+         * @brief Provides the cost of the path found by the last search.
+         *
+         * @return U The cost, or `infinity` if no path was found.
+         */
+        U getCost() const {
+            return best;
+        }
+
+        /**
+         * @brief Provides the number of vertices settled by the last search.
+         *
+         * @return size_t The settled vertex count.
+         */
+        size_t getSettledCount() const {
+            return settledCount;
+        }
+
+        /**
+         * @brief Writes the path found by the last search into `path`, with
+         * shortcuts unpacked into original edges.
+         *
+         * @param path Receives the path, source first; empty if no path was
+         * found.
+         */
+        void getPath(std::vector<VertexIndex>& path) const {
+            path.clear();
+            if (meeting == Hierarchy::invalidVertex) {
+                return;
+            }
+
+            // The hierarchy arcs from the source up to the meeting vertex,
+            // then down to the target.
+            std::vector<VertexIndex> hops;
+            for (auto v = meeting; ; v = forward.parents[v]) {
+                hops.push_back(v);
+                if (forward.parents[v] == v) {
+                    break;
+                }
+            }
+            std::reverse(hops.begin(), hops.end());
+            for (auto v = meeting; backward.parents[v] != v; ) {
+                v = backward.parents[v];
+                hops.push_back(v);
+            }
+
+            path.push_back(hops.front());
+            for (size_t i = 1; i < hops.size(); i++) {
+                H.unpack(hops[i - 1], hops[i], path);
+            }
+        }
+
+        /**
+         * @brief Provides the path found by the last search.
+         *
+         * @return std::vector<VertexIndex> The path, source first; empty if
+         * no path was found.
+         */
+        std::vector<VertexIndex> getPath() const {
+            std::vector<VertexIndex> path;
+            getPath(path);
+            return path;
+        }
+
+        /**
+         * @brief Finds a shortest path between two vertex keys.
+         *
+         * @param source The starting vertex.
+         * @param sink The goal vertex.
+         * @return std::vector<T> The path, source first; empty if there is
+         * none.
+         */
+        std::vector<T> findPath(const T& source, const T& sink) {
+            std::vector<T> path;
+            if (search(H.indexOf(source), H.indexOf(sink))) {
+                for (const auto v : getPath()) {
+                    path.push_back(H.vertexAt(v));
+                }
+            }
+            return path;
+        }
+    };
+}
+
+#endif
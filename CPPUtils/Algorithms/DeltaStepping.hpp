@@ -0,0 +1,295 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_ALGORITHMS_DELTA_STEPPING
+#define CPP_UTILS_ALGORITHMS_DELTA_STEPPING
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <CPPUtils/Algorithms/SearchState.hpp>
+#include <CPPUtils/Concurrency/Parallel.hpp>
+#include <CPPUtils/DataStructures/CSRGraph.hpp>
+#include <CPPUtils/DataStructures/Graph.hpp>
+
+namespace CPPUtils::Algorithms {
+
+    namespace Detail {
+
+        // Lowers `target` to `value` if that is smaller; true if it did.
+        template<typename V>
+        inline bool atomicMin(V& target, V value) {
+            std::atomic_ref<V> ref(target);
+            auto current = ref.load(std::memory_order_relaxed);
+            while (value < current) {
+                if (ref.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // The mean edge weight, a reasonable bucket width when none is given.
+        template<typename T, typename U>
+        inline U defaultDelta(const DataStructures::Graphs::CSRGraph<T, U>& G) {
+            const auto W = G.getWeights();
+            if (W.empty()) {
+                return 1;
+            }
+
+            long double sum = 0;
+            for (const auto w : W) {
+                sum += w;
+            }
+            const auto mean = static_cast<U>(sum / W.size());
+            return mean > 0 ? mean : static_cast<U>(1);
+        }
+    }
+
+    /**
+     * @brief Computes the cost of the shortest path from `source` to every
+     * vertex, with parallel delta-stepping.
+     *
+     * Tentative costs are kept in buckets of width `delta`. The lowest
+     * non-empty bucket is settled by repeatedly relaxing the light edges
+     * (weight at most `delta`) of its vertices in parallel, which may refill
+     * it, and then relaxing their heavy edges once. Costs are lowered with
+     * atomic compare and swap, and each thread collects the vertices it
+     * improved, which are then filed into buckets. The costs are exactly
+     * those of Dijkstra's algorithm.
+     *
+     * While settling one bucket, no cost can land more than
+     * ceil(maxWeight / delta) buckets beyond it, so the buckets are a
+     * cyclic array of that many plus one, whatever the largest cost. If a
+     * few very heavy edges would make that array too large, it is capped,
+     * and buckets beyond it are held sparsely until it reaches them; runs
+     * of empty buckets are skipped.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph, with non-negative weights.
+     * @param source The source vertex.
+     * @param delta The bucket width, 0 for the mean edge weight.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return std::vector<U> The cost of each vertex, by index; infinity (or
+     * the maximum for integer weights) where unreachable.
+     */
+    template<typename T, typename U>
+    inline std::vector<U> deltaStepping(const DataStructures::Graphs::CSRGraph<T, U>& G,
+                                        DataStructures::Graphs::VertexIndex source,
+                                        U delta = 0,
+                                        unsigned int numThreads = 0) {
+        using DataStructures::Graphs::VertexIndex;
+
+        constexpr auto infinity = Detail::infinityOf<U>();
+
+        const auto N = G.getVertexCardinality();
+        std::vector<U> costs(N, infinity);
+        if (source >= N) {
+            return costs;
+        }
+        if constexpr (std::is_signed_v<U>) {
+            const auto W = G.getWeights();
+            if (delta < 0 || std::any_of(W.begin(), W.end(), [](U w) { return w < 0; })) {
+                throw std::invalid_argument("Delta-stepping requires non-negative weights.");
+            }
+        }
+        if (delta == 0) {
+            delta = Detail::defaultDelta(G);
+        }
+
+        const auto workers = Concurrency::resolveThreadCount(numThreads);
+
+        // Bucket vertices per relaxation thread.
+        constexpr size_t grain = 1024;
+
+        const auto bucketOf = [delta](U cost) {
+            return static_cast<size_t>(cost / delta);
+        };
+
+        // The live buckets span at most this many; costs that round past
+        // it, or lie beyond the cap, go to the sparse overflow instead.
+        constexpr size_t maxWindow = size_t(1) << 16;
+        const auto W = G.getWeights();
+        const auto maxWeight = W.empty() ? U(0) : *std::max_element(W.begin(), W.end());
+        const auto ratio = std::ceil(static_cast<long double>(maxWeight) / static_cast<long double>(delta));
+        const auto C = ratio < maxWindow ? static_cast<size_t>(ratio) + 1 : maxWindow;
+
+        std::vector<std::vector<VertexIndex>> window(C);
+        std::map<size_t, std::vector<VertexIndex>> overflow;
+        size_t windowSize = 0;
+        size_t current = 0;
+        std::vector<std::vector<VertexIndex>> improved(workers);
+
+        // The bucket each vertex was last filed in; entries elsewhere are
+        // stale. Marks deduplicate vertices within one filing or frontier,
+        // and settled vertices within one bucket.
+        std::vector<size_t> filedIn(N, 0);
+        std::vector<size_t> marks(N, 0);
+        std::vector<size_t> settledIn(N, 0);
+        size_t stamp = 0;
+
+        // Bucket b lives in window slot b % C while it is within C of the
+        // current bucket.
+        const auto file = [&](VertexIndex u, size_t b) {
+            filedIn[u] = b;
+            if (b < current + C) {
+                window[b % C].push_back(u);
+                windowSize++;
+            } else {
+                overflow[b].push_back(u);
+            }
+        };
+
+        // Relaxes the light or heavy edges of `vertices` in parallel, then
+        // files the improved vertices into buckets no lower than `lowest`;
+        // that only corrects rounding, as costs never fall below it.
+        const auto relax = [&](const std::vector<VertexIndex>& vertices, bool light, size_t lowest) {
+            Concurrency::parallelForBlocks(0, vertices.size(), [&](size_t t, size_t first, size_t last) {
+                auto& out = improved[t];
+                for (auto i = first; i < last; i++) {
+                    const auto v = vertices[i];
+                    const auto cost = std::atomic_ref<U>(costs[v]).load(std::memory_order_relaxed);
+                    const auto Nv = G.neighbours(v);
+                    const auto Wv = G.neighbourWeights(v);
+                    for (size_t j = 0; j < Nv.size(); j++) {
+                        if ((Wv[j] <= delta) == light && Detail::atomicMin(costs[Nv[j]], cost + Wv[j])) {
+                            out.push_back(Nv[j]);
+                        }
+                    }
+                }
+            }, Concurrency::threadsForWork(vertices.size(), grain, workers));
+
+            stamp++;
+            for (auto& out : improved) {
+                for (const auto u : out) {
+                    if (marks[u] != stamp) {
+                        marks[u] = stamp;
+                        file(u, std::max(bucketOf(costs[u]), lowest));
+                    }
+                }
+                out.clear();
+            }
+        };
+
+        costs[source] = 0;
+        file(source, 0);
+
+        std::vector<VertexIndex> frontier;
+        std::vector<VertexIndex> settled;
+        for (;; current++) {
+            // Skip straight to the first overflow bucket if the window has
+            // run dry, and pull in any overflow buckets it now reaches.
+            if (windowSize == 0) {
+                if (overflow.empty()) {
+                    break;
+                }
+                current = overflow.begin()->first;
+            }
+            while (!overflow.empty() && overflow.begin()->first < current + C) {
+                auto node = overflow.extract(overflow.begin());
+                auto& slot = window[node.key() % C];
+                slot.insert(slot.end(), node.mapped().begin(), node.mapped().end());
+                windowSize += node.mapped().size();
+            }
+
+            const auto i = current;
+            auto& bucket = window[i % C];
+            settled.clear();
+            while (!bucket.empty()) {
+                stamp++;
+                frontier.clear();
+                for (const auto v : bucket) {
+                    if (filedIn[v] == i && marks[v] != stamp) {
+                        marks[v] = stamp;
+                        frontier.push_back(v);
+                        if (settledIn[v] != i + 1) {
+                            settledIn[v] = i + 1;
+                            settled.push_back(v);
+                        }
+                    }
+                }
+
+                // Light edges may refill this bucket.
+                windowSize -= bucket.size();
+                bucket.clear();
+                relax(frontier, true, i);
+            }
+
+            // Heavy edges always leave the bucket, so one pass suffices.
+            relax(settled, false, i + 1);
+        }
+
+        return costs;
+    }
+
+    /**
+     * @brief Computes the cost of the shortest path from `source` to every
+     * vertex, with parallel delta-stepping.
+     *
+     * The graph is frozen into CSR form first.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph, with non-negative weights.
+     * @param source The source vertex.
+     * @param delta The bucket width, 0 for the mean edge weight.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return std::unordered_map<T, U> The cost of each vertex; infinity (or
+     * the maximum for integer weights) where unreachable.
+     */
+    template<typename T, typename U>
+    inline std::unordered_map<T, U> deltaStepping(const DataStructures::Graphs::Graph<T, U>& G,
+                                                  const T& source,
+                                                  U delta = 0,
+                                                  unsigned int numThreads = 0) {
+        const DataStructures::Graphs::CSRGraph<T, U> C(G, numThreads);
+        const auto costs = deltaStepping(C, C.indexOf(source), delta, numThreads);
+
+        std::unordered_map<T, U> result;
+        result.reserve(costs.size());
+        for (size_t i = 0; i < costs.size(); i++) {
+            result.emplace(C.getVertices()[i], costs[i]);
+        }
+        return result;
+    }
+}
+
+#endif
@@ -0,0 +1,308 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_ALGORITHMS_DISTANCE_MATRIX
+#define CPP_UTILS_ALGORITHMS_DISTANCE_MATRIX
+
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <CPPUtils/Algorithms/AStarSearchContext.hpp>
+#include <CPPUtils/Concurrency/Parallel.hpp>
+#include <CPPUtils/DataStructures/CSRGraph.hpp>
+#include <CPPUtils/DataStructures/Graph.hpp>
+
+namespace CPPUtils::Algorithms {
+
+    /**
+     * @brief A dense, row-major table of shortest path costs, one row per
+     * source and one column per target.
+     *
+     * @tparam V Cost type.
+     */
+    template<typename V>
+    struct DistanceMatrix final {
+        size_t rows = 0;
+        size_t columns = 0;
+        std::vector<V> values;
+
+        /**
+         * @brief Provides the cost from source `i` to target `j`.
+         *
+         * @param i The source row.
+         * @param j The target column.
+         * @return V The cost, or infinity if there is no path.
+         */
+        V operator()(size_t i, size_t j) const {
+            return values[i * columns + j];
+        }
+
+        /**
+         * @brief Provides the costs from source `i` to every target.
+         *
+         * @param i The source row.
+         * @return std::span<const V> The row.
+         */
+        std::span<const V> row(size_t i) const {
+            return std::span<const V>(values).subspan(i * columns, columns);
+        }
+    };
+
+    /**
+     * @brief Reusable state for finding the costs from one source to many
+     * targets with a single Dijkstra search.
+     *
+     * The search stops as soon as every target has been settled. Targets
+     * are marked in a dense array that is cleared again after each query, in
+     * time proportional to the number of targets. Not thread safe; use one
+     * object per thread.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam V Cost type.
+     */
+    template<typename T, typename U = double, typename V = U>
+    class OneToManySearch {
+    protected:
+        AStarSearchContext<T, U, V> context;
+
+        // How many times each vertex appears among the current targets.
+        std::vector<std::uint32_t> multiplicity;
+
+    public:
+        /**
+         * @brief Construct a new One To Many Search object for `G`.
+         *
+         * `G` must outlive the search object.
+         *
+         * @param G The graph to search.
+         */
+        explicit OneToManySearch(const DataStructures::Graphs::CSRGraph<T, U>& G) :
+            context(G),
+            multiplicity(G.getVertexCardinality(), 0) {
+            //
+        }
+
+        virtual ~OneToManySearch() {
+            //
+        }
+
+        /**
+         * @brief Writes the cost from `source` to each of `targets` into
+         * `distances`.
+         *
+         * @param source The source vertex.
+         * @param targets The target vertices; may repeat.
+         * @param distances Receives one cost per target, or infinity where
+         * there is no path.
+         */
+        void search(DataStructures::Graphs::VertexIndex source,
+                    std::span<const DataStructures::Graphs::VertexIndex> targets,
+                    std::span<V> distances) {
+            if (distances.size() != targets.size()) {
+                throw std::invalid_argument("There must be one distance per target.");
+            }
+
+            size_t remaining = 0;
+            for (const auto t : targets) {
+                if (t < multiplicity.size()) {
+                    multiplicity[t]++;
+                    remaining++;
+                }
+            }
+
+            if (remaining > 0) {
+                context.search(source,
+                               [&](DataStructures::Graphs::VertexIndex v) {
+                                   remaining -= multiplicity[v];
+                                   return remaining == 0;
+                               },
+                               [](DataStructures::Graphs::VertexIndex) { return static_cast<V>(0); });
+            }
+
+            for (size_t j = 0; j < targets.size(); j++) {
+                const auto t = targets[j];
+                distances[j] = remaining > 0 && !context.wasSettled(t) ?
+                               AStarSearchContext<T, U, V>::infinity :
+                               context.getCost(t);
+                if (t < multiplicity.size()) {
+                    multiplicity[t] = 0;
+                }
+            }
+        }
+
+        /**
+         * @brief Provides the cost from `source` to each of `targets`.
+         *
+         * @param source The source vertex.
+         * @param targets The target vertices; may repeat.
+         * @return std::vector<V> One cost per target, or infinity where
+         * there is no path.
+         */
+        std::vector<V> search(DataStructures::Graphs::VertexIndex source,
+                              std::span<const DataStructures::Graphs::VertexIndex> targets) {
+            std::vector<V> distances(targets.size());
+            search(source, targets, distances);
+            return distances;
+        }
+
+        /**
+         * @brief Provides the search context, from which paths to the
+         * targets of the last query can be read.
+         *
+         * @return const AStarSearchContext<T, U, V>& The context.
+         */
+        const AStarSearchContext<T, U, V>& getContext() const {
+            return context;
+        }
+    };
+
+    /**
+     * @brief Writes the cost from each of `sources` to each of `targets`
+     * into the row-major buffer `distances`.
+     *
+     * Sources are shared out between threads, each of which runs one
+     * one-to-many search per source with its own reusable search state. Any
+     * row-major buffer will do, such as the data of a
+     * `LinearAlgebra::Matrix`.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam V Cost type.
+     * @param G The graph to search.
+     * @param sources The source vertices, one per row.
+     * @param targets The target vertices, one per column.
+     * @param distances Receives the costs; infinity where there is no path.
+     * @param numThreads The number of threads to use, 0 for the default.
+     */
+    template<typename T, typename U, typename V>
+    inline void manyToMany(const DataStructures::Graphs::CSRGraph<T, U>& G,
+                           std::span<const DataStructures::Graphs::VertexIndex> sources,
+                           std::span<const DataStructures::Graphs::VertexIndex> targets,
+                           std::span<V> distances,
+                           unsigned int numThreads = 0) {
+        if (distances.size() != sources.size() * targets.size()) {
+            throw std::invalid_argument("There must be one distance per source and target pair.");
+        }
+
+        Concurrency::parallelForBlocks(0, sources.size(), [&](size_t, size_t first, size_t last) {
+            OneToManySearch<T, U, V> search(G);
+            for (auto i = first; i < last; i++) {
+                search.search(sources[i], targets, distances.subspan(i * targets.size(), targets.size()));
+            }
+        }, numThreads);
+    }
+
+    /**
+     * @brief Provides the cost from each of `sources` to each of `targets`.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph to search.
+     * @param sources The source vertices, one per row.
+     * @param targets The target vertices, one per column.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return DistanceMatrix<U> The costs; infinity where there is no path.
+     */
+    template<typename T, typename U>
+    inline DistanceMatrix<U> manyToMany(const DataStructures::Graphs::CSRGraph<T, U>& G,
+                                        std::span<const DataStructures::Graphs::VertexIndex> sources,
+                                        std::span<const DataStructures::Graphs::VertexIndex> targets,
+                                        unsigned int numThreads = 0) {
+        DistanceMatrix<U> D;
+        D.rows = sources.size();
+        D.columns = targets.size();
+        D.values.resize(D.rows * D.columns);
+        manyToMany(G, sources, targets, std::span<U>(D.values), numThreads);
+        return D;
+    }
+
+    /**
+     * @brief Provides the cost from each of `sources` to each of `targets`.
+     *
+     * The graph is frozen into CSR form first. Unknown vertices have no
+     * paths.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph to search.
+     * @param sources The source vertices, one per row.
+     * @param targets The target vertices, one per column.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return DistanceMatrix<U> The costs; infinity where there is no path.
+     */
+    template<typename T, typename U>
+    inline DistanceMatrix<U> manyToMany(const DataStructures::Graphs::Graph<T, U>& G,
+                                        const std::vector<T>& sources,
+                                        const std::vector<T>& targets,
+                                        unsigned int numThreads = 0) {
+        const DataStructures::Graphs::CSRGraph<T, U> C(G, numThreads);
+        const auto indices = [&C](const std::vector<T>& keys) {
+            std::vector<DataStructures::Graphs::VertexIndex> result;
+            result.reserve(keys.size());
+            for (const auto& key : keys) {
+                result.push_back(C.indexOf(key));
+            }
+            return result;
+        };
+
+        const auto s = indices(sources);
+        const auto t = indices(targets);
+        return manyToMany(C,
+                          std::span<const DataStructures::Graphs::VertexIndex>(s),
+                          std::span<const DataStructures::Graphs::VertexIndex>(t),
+                          numThreads);
+    }
+
+    /**
+     * @brief Provides the cost from `source` to each of `targets`, with a
+     * single search.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph to search.
+     * @param source The source vertex.
+     * @param targets The target vertices.
+     * @return std::vector<U> One cost per target; infinity where there is
+     * no path.
+     */
+    template<typename T, typename U>
+    inline std::vector<U> oneToMany(const DataStructures::Graphs::Graph<T, U>& G,
+                                    const T& source,
+                                    const std::vector<T>& targets) {
+        return manyToMany(G, std::vector<T>{ source }, targets, 1).values;
+    }
+}
+
+#endif
@@ -0,0 +1,313 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_ALGORITHMS_GRAPH_PARTITIONING
+#define CPP_UTILS_ALGORITHMS_GRAPH_PARTITIONING
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <CPPUtils/Concurrency/Parallel.hpp>
+#include <CPPUtils/DataStructures/CSRGraph.hpp>
+#include <CPPUtils/DataStructures/Graph.hpp>
+
+namespace CPPUtils::Algorithms {
+
+    /**
+     * @brief One part of a partitioned graph.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     */
+    template<typename T, typename U = double>
+    struct GraphPart final {
+        // The vertices owned by this part, and the edges between them.
+        DataStructures::Graphs::Graph<T, U> subgraph;
+
+        // Owned vertices with at least one edge to another part.
+        std::vector<T> boundary;
+
+        // Vertices owned by other parts that owned vertices have edges to,
+        // with the part that owns each of them.
+        std::unordered_map<T, size_t> ghosts;
+
+        // Outward edges from owned vertices to ghost vertices.
+        std::vector<DataStructures::Graphs::WeightedEdge<T, U>> cutEdges;
+    };
+
+    /**
+     * @brief A partitioning of a graph into `k` parts.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     */
+    template<typename T, typename U = double>
+    struct GraphPartitioning final {
+        // The part that owns each vertex.
+        std::unordered_map<T, size_t> assignment;
+
+        // The parts, indexed by part number.
+        std::vector<GraphPart<T, U>> parts;
+
+        // The number of edges with endpoints in different parts. Each
+        // undirected edge is counted once.
+        size_t edgeCut = 0;
+    };
+
+    /**
+     * @brief Partitions the vertices of `G` into `k` balanced parts with a
+     * small edge cut, by size constrained label propagation.
+     *
+     * Parts are seeded with contiguous runs of a breadth first ordering of
+     * the vertices. Each round then finds, in parallel, the vertices with
+     * more neighbours in another part than in their own, and moves each of
+     * them to its best part, provided that the part stays within
+     * `(1 + imbalance) * V / k` vertices and the move still helps. Edge
+     * direction is ignored and every edge counts equally, regardless of its
+     * weight.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @param k The number of parts.
+     * @param imbalance The permitted relative excess of the largest part.
+     * @param maxIterations The maximum number of label propagation rounds.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return std::vector<std::uint32_t> The part of each vertex, indexed as
+     * the vertices of `G`.
+     */
+    template<typename T, typename U = double>
+    inline std::vector<std::uint32_t> partitionVertices(const DataStructures::Graphs::CSRGraph<T, U>& G,
+                                                        size_t k,
+                                                        double imbalance = 0.05,
+                                                        unsigned int maxIterations = 20,
+                                                        unsigned int numThreads = 0) {
+        using DataStructures::Graphs::VertexIndex;
+
+        if (k == 0) {
+            throw std::invalid_argument("Cannot partition into zero parts.");
+        }
+
+        const auto N = G.getVertexCardinality();
+        std::vector<std::uint32_t> part(N, 0);
+        if (N == 0 || k == 1) {
+            return part;
+        }
+
+        const auto adjacency = DataStructures::Graphs::undirectedAdjacency(G);
+        const auto& offsets = adjacency.offsets;
+        const auto& targets = adjacency.targets;
+
+        // Breadth first order, so that the seed parts are contiguous.
+        std::vector<VertexIndex> order;
+        order.reserve(N);
+        std::vector<bool> seen(N, false);
+        for (size_t root = 0; root < N; root++) {
+            if (seen[root]) {
+                continue;
+            }
+            seen[root] = true;
+            order.push_back(static_cast<VertexIndex>(root));
+            for (size_t head = order.size() - 1; head < order.size(); head++) {
+                const auto v = order[head];
+                for (auto e = offsets[v]; e < offsets[v + 1]; e++) {
+                    if (!seen[targets[e]]) {
+                        seen[targets[e]] = true;
+                        order.push_back(targets[e]);
+                    }
+                }
+            }
+        }
+
+        std::vector<size_t> sizes(k, 0);
+        for (size_t i = 0; i < N; i++) {
+            const auto p = static_cast<std::uint32_t>(i * k / N);
+            part[order[i]] = p;
+            sizes[p]++;
+        }
+
+        const auto capacity = static_cast<size_t>(std::ceil((1.0 + imbalance) * N / k));
+
+        // The part with the most neighbours of v, and that neighbour count,
+        // using counts as scratch.
+        auto bestPart = [&](VertexIndex v, std::vector<size_t>& counts,
+                            std::vector<std::uint32_t>& touched) {
+            touched.clear();
+            for (auto e = offsets[v]; e < offsets[v + 1]; e++) {
+                const auto p = part[targets[e]];
+                if (counts[p]++ == 0) {
+                    touched.push_back(p);
+                }
+            }
+
+            auto best = part[v];
+            auto bestCount = counts[best];
+            const auto own = bestCount;
+            for (const auto p : touched) {
+                if (counts[p] > bestCount) {
+                    best = p;
+                    bestCount = counts[p];
+                }
+            }
+            for (const auto p : touched) {
+                counts[p] = 0;
+            }
+            return std::make_pair(best, bestCount - own);
+        };
+
+        std::vector<std::uint32_t> proposal(N);
+        for (unsigned int iteration = 0; iteration < maxIterations; iteration++) {
+            // Find candidate moves in parallel against a fixed assignment.
+            Concurrency::parallelForBlocks(0, N, [&](size_t, size_t first, size_t last) {
+                std::vector<size_t> counts(k, 0);
+                std::vector<std::uint32_t> touched;
+                for (size_t v = first; v < last; v++) {
+                    proposal[v] = bestPart(static_cast<VertexIndex>(v), counts, touched).first;
+                }
+            }, numThreads);
+
+            // Apply them in order, rechecking the gain and the balance.
+            size_t moves = 0;
+            std::vector<size_t> counts(k, 0);
+            std::vector<std::uint32_t> touched;
+            for (size_t v = 0; v < N; v++) {
+                if (proposal[v] == part[v]) {
+                    continue;
+                }
+
+                const auto [best, gain] = bestPart(static_cast<VertexIndex>(v), counts, touched);
+                if (gain == 0 || sizes[best] + 1 > capacity) {
+                    continue;
+                }
+
+                sizes[part[v]]--;
+                sizes[best]++;
+                part[v] = best;
+                moves++;
+            }
+
+            if (moves == 0) {
+                break;
+            }
+        }
+
+        return part;
+    }
+
+    /**
+     * @brief Partitions `G` into `k` balanced parts with a small edge cut,
+     * and extracts each part as a standalone subgraph with its boundary and
+     * ghost vertex tables.
+     *
+     * See `partitionVertices` for the partitioning method. The subgraphs are
+     * independent, so they may be processed concurrently, one per thread or
+     * per NUMA node, exchanging values for ghost vertices between rounds.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @param k The number of parts.
+     * @param imbalance The permitted relative excess of the largest part.
+     * @param maxIterations The maximum number of label propagation rounds.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return GraphPartitioning<T, U> The parts.
+     */
+    template<typename T, typename U = double>
+    inline GraphPartitioning<T, U> partitionGraph(const DataStructures::Graphs::Graph<T, U>& G,
+                                                  size_t k,
+                                                  double imbalance = 0.05,
+                                                  unsigned int maxIterations = 20,
+                                                  unsigned int numThreads = 0) {
+        using DataStructures::Graphs::VertexIndex;
+
+        const DataStructures::Graphs::CSRGraph<T, U> C(G, numThreads);
+        const auto part = partitionVertices(C, k, imbalance, maxIterations, numThreads);
+        const auto N = C.getVertexCardinality();
+
+        GraphPartitioning<T, U> result;
+        result.assignment.reserve(N);
+        result.parts.resize(k);
+        for (auto& p : result.parts) {
+            // Self-loops are stored once or twice according to the policy,
+            // so the halving below only holds under the same policy.
+            p.subgraph = G.emptyCopy();
+        }
+
+        for (size_t v = 0; v < N; v++) {
+            result.assignment.emplace(C.vertexAt(static_cast<VertexIndex>(v)), part[v]);
+            result.parts[part[v]].subgraph.addVertex(C.vertexAt(static_cast<VertexIndex>(v)));
+        }
+
+        // Distribute the edges. Undirected edges are stored in both
+        // directions, so add internal ones from one end only.
+        for (size_t v = 0; v < N; v++) {
+            auto& owner = result.parts[part[v]];
+            const auto& a = C.vertexAt(static_cast<VertexIndex>(v));
+            const auto Nv = C.neighbours(static_cast<VertexIndex>(v));
+            const auto Wv = C.neighbourWeights(static_cast<VertexIndex>(v));
+
+            bool isBoundary = false;
+            size_t selfLoops = 0;
+            for (size_t i = 0; i < Nv.size(); i++) {
+                const auto u = Nv[i];
+                const auto& b = C.vertexAt(u);
+
+                if (part[u] == part[v]) {
+                    if (G.isDirected() || v < u || (v == u && selfLoops++ % 2 == 0)) {
+                        owner.subgraph.addEdge(a, b, Wv[i]);
+                    }
+                    continue;
+                }
+
+                isBoundary = true;
+                owner.ghosts.emplace(b, part[u]);
+                owner.cutEdges.push_back({ a, b, Wv[i] });
+                if (G.isDirected() || v < u) {
+                    result.edgeCut++;
+                }
+            }
+
+            if (isBoundary) {
+                owner.boundary.push_back(a);
+            }
+        }
+
+        return result;
+    }
+}
+
+#endif
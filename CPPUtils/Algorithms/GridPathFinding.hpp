@@ -0,0 +1,562 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_ALGORITHMS_GRID_PATH_FINDING
+#define CPP_UTILS_ALGORITHMS_GRID_PATH_FINDING
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <CPPUtils/Algorithms/SearchState.hpp>
+
+namespace CPPUtils::Algorithms {
+
+    /**
+     * @brief A cell of a grid.
+     *
+     */
+    struct GridPoint final {
+        std::int32_t x;
+        std::int32_t y;
+
+        bool operator==(const GridPoint&) const = default;
+    };
+
+    /**
+     * @brief Which neighbouring cells a step may move to.
+     *
+     * Diagonal steps may not cut corners: both cells beside a diagonal step
+     * must be open.
+     */
+    enum class GridConnectivity : short {
+        FOUR = 4,
+        EIGHT = 8
+    };
+
+    /**
+     * @brief A 2D grid of open and wall cells, with the walls packed one bit
+     * per cell, row by row.
+     *
+     */
+    class OccupancyGrid {
+    protected:
+        size_t width;
+        size_t height;
+        size_t wordsPerRow;
+        std::vector<std::uint64_t> walls;
+
+    public:
+        /**
+         * @brief Construct a new Occupancy Grid object with every cell open.
+         *
+         * @param width The number of columns.
+         * @param height The number of rows.
+         */
+        OccupancyGrid(size_t width, size_t height) :
+            width(width),
+            height(height),
+            wordsPerRow((width + 63) / 64),
+            walls(wordsPerRow * height, 0) {
+            if (width * height > (std::numeric_limits<std::uint32_t>::max)()) {
+                throw std::invalid_argument("Grid is too large.");
+            }
+        }
+
+        /**
+         * @brief Construct a new Occupancy Grid object from a contiguous,
+         * row-major array of cells.
+         *
+         * @tparam C Cell type.
+         * @tparam IsWall Callable type, `bool(const C&)`.
+         * @param cells The cells, `width * height` of them.
+         * @param width The number of columns.
+         * @param height The number of rows.
+         * @param isWall Determines whether a cell is a wall.
+         */
+        template<typename C, typename IsWall>
+        OccupancyGrid(std::span<const C> cells, size_t width, size_t height, IsWall&& isWall) :
+            OccupancyGrid(width, height) {
+            if (cells.size() != width * height) {
+                throw std::invalid_argument("There must be width * height cells.");
+            }
+
+            for (size_t y = 0; y < height; y++) {
+                for (size_t x = 0; x < width; x++) {
+                    if (isWall(cells[y * width + x])) {
+                        walls[y * wordsPerRow + x / 64] |= std::uint64_t(1) << (x % 64);
+                    }
+                }
+            }
+        }
+
+        virtual ~OccupancyGrid() {
+            //
+        }
+
+        /**
+         * @brief Provides the number of columns.
+         *
+         * @return size_t The width.
+         */
+        size_t getWidth() const {
+            return width;
+        }
+
+        /**
+         * @brief Provides the number of rows.
+         *
+         * @return size_t The height.
+         */
+        size_t getHeight() const {
+            return height;
+        }
+
+        /**
+         * @brief Determines if `p` lies within the grid.
+         *
+         * @param p The cell.
+         * @return true If `p` is in bounds.
+         * @return false Otherwise.
+         */
+        bool contains(GridPoint p) const {
+            return p.x >= 0 && p.y >= 0 &&
+                   static_cast<size_t>(p.x) < width && static_cast<size_t>(p.y) < height;
+        }
+
+        /**
+         * @brief Determines if `p` is an open cell within the grid.
+         *
+         * @param p The cell.
+         * @return true If `p` can be entered.
+         * @return false If `p` is a wall or out of bounds.
+         */
+        bool isOpen(GridPoint p) const {
+            if (!contains(p)) {
+                return false;
+            }
+            const auto x = static_cast<size_t>(p.x);
+            return ((walls[static_cast<size_t>(p.y) * wordsPerRow + x / 64] >> (x % 64)) & 1) == 0;
+        }
+
+        /**
+         * @brief Makes `p` a wall, or opens it.
+         *
+         * @param p The cell, which must be in bounds.
+         * @param wall Whether the cell is a wall.
+         */
+        void setWall(GridPoint p, bool wall) {
+            if (!contains(p)) {
+                throw std::out_of_range("Cell is outside the grid.");
+            }
+
+            const auto x = static_cast<size_t>(p.x);
+            auto& word = walls[static_cast<size_t>(p.y) * wordsPerRow + x / 64];
+            const auto bit = std::uint64_t(1) << (x % 64);
+            word = wall ? (word | bit) : (word & ~bit);
+        }
+
+        /**
+         * @brief Provides the index of `p` in row-major order.
+         *
+         * @param p The cell, which must be in bounds.
+         * @return std::uint32_t The index.
+         */
+        std::uint32_t indexOf(GridPoint p) const {
+            return static_cast<std::uint32_t>(static_cast<size_t>(p.y) * width + static_cast<size_t>(p.x));
+        }
+
+        /**
+         * @brief Provides the cell at row-major index `i`.
+         *
+         * @param i The index.
+         * @return GridPoint The cell.
+         */
+        GridPoint pointAt(std::uint32_t i) const {
+            return { static_cast<std::int32_t>(i % width), static_cast<std::int32_t>(i / width) };
+        }
+    };
+
+    /**
+     * @brief Reusable state for shortest path searches on an
+     * `OccupancyGrid`, without building a graph.
+     *
+     * Orthogonal steps cost 1 and diagonal steps the square root of 2.
+     * `findPath` runs A*, with the Manhattan or octile distance as its
+     * heuristic. `jumpPointSearch` runs Jump Point Search on the 8-connected
+     * grid, which only queues cells where a straight or diagonal run must
+     * turn, and finds paths of the same cost. As with `AStarSearchContext`,
+     * per-cell state is dense and reset lazily by generation stamps. Not
+     * thread safe; use one context per thread.
+     */
+    class GridSearchContext {
+    public:
+        /**
+         * @brief The cost of a cell that was not reached.
+         *
+         */
+        static constexpr double infinity = std::numeric_limits<double>::infinity();
+
+    protected:
+        static constexpr double diagonalCost = 1.4142135623730951;
+
+        using HeapEntry = std::pair<double, std::uint32_t>;
+
+        const OccupancyGrid& grid;
+
+        std::vector<double> costs;
+        std::vector<std::uint32_t> parents;
+        std::vector<std::uint32_t> reachedIn;
+        std::vector<std::uint32_t> settledIn;
+        std::uint32_t generation;
+
+        std::vector<HeapEntry> heap;
+        size_t settledCount;
+        double pathCost;
+
+        static double octile(GridPoint a, GridPoint b) {
+            const auto dx = static_cast<double>(std::abs(a.x - b.x));
+            const auto dy = static_cast<double>(std::abs(a.y - b.y));
+            return std::max(dx, dy) + (diagonalCost - 1.0) * std::min(dx, dy);
+        }
+
+        static double manhattan(GridPoint a, GridPoint b) {
+            return static_cast<double>(std::abs(a.x - b.x) + std::abs(a.y - b.y));
+        }
+
+        static std::int32_t sign(std::int32_t v) {
+            return (v > 0) - (v < 0);
+        }
+
+        bool beginQuery(GridPoint start, GridPoint goal) {
+            heap.clear();
+            settledCount = 0;
+            pathCost = infinity;
+
+            Detail::nextGeneration(generation, reachedIn, settledIn);
+            return grid.isOpen(start) && grid.isOpen(goal);
+        }
+
+        void reach(std::uint32_t v, std::uint32_t parent, double cost, double priority) {
+            reachedIn[v] = generation;
+            costs[v] = cost;
+            parents[v] = parent;
+            heap.emplace_back(priority, v);
+            std::push_heap(heap.begin(), heap.end(), std::greater<>());
+        }
+
+        // Pops the next unsettled cell, or returns false.
+        bool settleNext(std::uint32_t& v) {
+            while (!heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+                v = heap.back().second;
+                heap.pop_back();
+                if (settledIn[v] != generation) {
+                    settledIn[v] = generation;
+                    settledCount++;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Whether a step by (dx, dy) from `p` is allowed.
+        bool canStep(GridPoint p, std::int32_t dx, std::int32_t dy) const {
+            if (!grid.isOpen({ p.x + dx, p.y + dy })) {
+                return false;
+            }
+            return dx == 0 || dy == 0 || (grid.isOpen({ p.x + dx, p.y }) && grid.isOpen({ p.x, p.y + dy }));
+        }
+
+        // Follows parents back from the goal, filling in the cells between
+        // jump points, which are always in a straight or diagonal line.
+        std::vector<GridPoint> tracePath(std::uint32_t goal) const {
+            std::vector<GridPoint> path = { grid.pointAt(goal) };
+            for (auto v = goal; parents[v] != v; v = parents[v]) {
+                const auto to = grid.pointAt(parents[v]);
+                auto p = path.back();
+                const auto dx = sign(to.x - p.x);
+                const auto dy = sign(to.y - p.y);
+                while (!(p == to)) {
+                    p = { p.x + dx, p.y + dy };
+                    path.push_back(p);
+                }
+            }
+            std::reverse(path.begin(), path.end());
+            return path;
+        }
+
+        // Runs straight from `p`, away from its parent by (dx, 0) or (0, dy),
+        // until the goal, a cell with a forced neighbour, or a wall.
+        bool jumpStraight(GridPoint& p, std::int32_t dx, std::int32_t dy, GridPoint goal) const {
+            while (true) {
+                p = { p.x + dx, p.y + dy };
+                if (!grid.isOpen(p)) {
+                    return false;
+                }
+                if (p == goal) {
+                    return true;
+                }
+
+                // A side cell that was blocked behind us is open here, so it
+                // can only be reached optimally through this cell.
+                if (dx != 0) {
+                    if ((grid.isOpen({ p.x, p.y - 1 }) && !grid.isOpen({ p.x - dx, p.y - 1 })) ||
+                        (grid.isOpen({ p.x, p.y + 1 }) && !grid.isOpen({ p.x - dx, p.y + 1 }))) {
+                        return true;
+                    }
+                } else {
+                    if ((grid.isOpen({ p.x - 1, p.y }) && !grid.isOpen({ p.x - 1, p.y - dy })) ||
+                        (grid.isOpen({ p.x + 1, p.y }) && !grid.isOpen({ p.x + 1, p.y - dy }))) {
+                        return true;
+                    }
+                }
+            }
+        }
+
+        // Runs from `p` in direction (dx, dy), which may be diagonal, and
+        // stores the next jump point in `p`.
+        bool jump(GridPoint& p, std::int32_t dx, std::int32_t dy, GridPoint goal) const {
+            if (dx == 0 || dy == 0) {
+                return jumpStraight(p, dx, dy, goal);
+            }
+
+            while (true) {
+                if (!canStep(p, dx, dy)) {
+                    return false;
+                }
+                p = { p.x + dx, p.y + dy };
+                if (p == goal) {
+                    return true;
+                }
+
+                // A diagonal cell is a jump point if either straight run
+                // from it finds one.
+                auto q = p;
+                if (jumpStraight(q, dx, 0, goal)) {
+                    return true;
+                }
+                q = p;
+                if (jumpStraight(q, 0, dy, goal)) {
+                    return true;
+                }
+            }
+        }
+
+    public:
+        /**
+         * @brief Construct a new Grid Search Context object for `grid`.
+         *
+         * `grid` must outlive the context; walls may change between
+         * searches.
+         *
+         * @param grid The grid to search.
+         */
+        explicit GridSearchContext(const OccupancyGrid& grid) :
+            grid(grid),
+            costs(grid.getWidth() * grid.getHeight()),
+            parents(grid.getWidth() * grid.getHeight()),
+            reachedIn(grid.getWidth() * grid.getHeight(), 0),
+            settledIn(grid.getWidth() * grid.getHeight(), 0),
+            generation(0),
+            settledCount(0),
+            pathCost(infinity) {
+            //
+        }
+
+        virtual ~GridSearchContext() {
+            //
+        }
+
+        /**
+         * @brief Finds a shortest path from `start` to `goal` with A*.
+         *
+         * @param start The starting cell.
+         * @param goal The goal cell.
+         * @param connectivity The allowed steps.
+         * @return std::vector<GridPoint> The path, start first; empty if
+         * there is none.
+         */
+        std::vector<GridPoint> findPath(GridPoint start,
+                                        GridPoint goal,
+                                        GridConnectivity connectivity = GridConnectivity::EIGHT) {
+            if (!beginQuery(start, goal)) {
+                return {};
+            }
+
+            const bool diagonal = connectivity == GridConnectivity::EIGHT;
+            const auto h = [diagonal, goal](GridPoint p) {
+                return diagonal ? octile(p, goal) : manhattan(p, goal);
+            };
+
+            const auto s = grid.indexOf(start);
+            const auto t = grid.indexOf(goal);
+            reach(s, s, 0, h(start));
+
+            std::uint32_t v;
+            while (settleNext(v)) {
+                if (v == t) {
+                    pathCost = costs[v];
+                    return tracePath(v);
+                }
+
+                const auto p = grid.pointAt(v);
+                for (std::int32_t dy = -1; dy <= 1; dy++) {
+                    for (std::int32_t dx = -1; dx <= 1; dx++) {
+                        if ((dx == 0 && dy == 0) || (!diagonal && dx != 0 && dy != 0) || !canStep(p, dx, dy)) {
+                            continue;
+                        }
+
+                        const GridPoint q = { p.x + dx, p.y + dy };
+                        const auto u = grid.indexOf(q);
+                        const auto cost = costs[v] + (dx != 0 && dy != 0 ? diagonalCost : 1.0);
+                        if (settledIn[u] != generation && (reachedIn[u] != generation || cost < costs[u])) {
+                            reach(u, v, cost, cost + h(q));
+                        }
+                    }
+                }
+            }
+            return {};
+        }
+
+        /**
+         * @brief Finds a shortest path from `start` to `goal` on the
+         * 8-connected grid, with Jump Point Search.
+         *
+         * @param start The starting cell.
+         * @param goal The goal cell.
+         * @return std::vector<GridPoint> The path, every cell included,
+         * start first; empty if there is none.
+         */
+        std::vector<GridPoint> jumpPointSearch(GridPoint start, GridPoint goal) {
+            if (!beginQuery(start, goal)) {
+                return {};
+            }
+
+            const auto s = grid.indexOf(start);
+            const auto t = grid.indexOf(goal);
+            reach(s, s, 0, octile(start, goal));
+
+            std::uint32_t v;
+            std::int32_t directions[8][2];
+            while (settleNext(v)) {
+                if (v == t) {
+                    pathCost = costs[v];
+                    return tracePath(v);
+                }
+
+                // Prune the directions to those a shortest path through the
+                // parent could need to continue in.
+                const auto p = grid.pointAt(v);
+                size_t count = 0;
+                const auto add = [&](std::int32_t dx, std::int32_t dy) {
+                    if (canStep(p, dx, dy)) {
+                        directions[count][0] = dx;
+                        directions[count][1] = dy;
+                        count++;
+                    }
+                };
+
+                if (parents[v] == v) {
+                    for (std::int32_t dy = -1; dy <= 1; dy++) {
+                        for (std::int32_t dx = -1; dx <= 1; dx++) {
+                            if (dx != 0 || dy != 0) {
+                                add(dx, dy);
+                            }
+                        }
+                    }
+                } else {
+                    const auto from = grid.pointAt(parents[v]);
+                    const auto dx = sign(p.x - from.x);
+                    const auto dy = sign(p.y - from.y);
+                    if (dx != 0 && dy != 0) {
+                        add(dx, 0);
+                        add(0, dy);
+                        add(dx, dy);
+                    } else if (dx != 0) {
+                        add(dx, 0);
+                        add(0, 1);
+                        add(0, -1);
+                        add(dx, 1);
+                        add(dx, -1);
+                    } else {
+                        add(0, dy);
+                        add(1, 0);
+                        add(-1, 0);
+                        add(1, dy);
+                        add(-1, dy);
+                    }
+                }
+
+                for (size_t i = 0; i < count; i++) {
+                    auto q = p;
+                    if (!jump(q, directions[i][0], directions[i][1], goal)) {
+                        continue;
+                    }
+
+                    const auto u = grid.indexOf(q);
+                    const auto cost = costs[v] + octile(p, q);
+                    if (settledIn[u] != generation && (reachedIn[u] != generation || cost < costs[u])) {
+                        reach(u, v, cost, cost + octile(q, goal));
+                    }
+                }
+            }
+            return {};
+        }
+
+        /**
+         * @brief Provides the cost of the path found by the last search.
+         *
+         * @return double The cost, or `infinity` if no path was found.
+         */
+        double getCost() const {
+            return pathCost;
+        }
+
+        /**
+         * @brief Provides the number of cells settled by the last search.
+         *
+         * @return size_t The settled cell count.
+         */
+        size_t getSettledCount() const {
+            return settledCount;
+        }
+    };
+}
+
+#endif
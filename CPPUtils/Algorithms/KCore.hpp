@@ -0,0 +1,203 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_ALGORITHMS_K_CORE
+#define CPP_UTILS_ALGORITHMS_K_CORE
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include <CPPUtils/Concurrency/Parallel.hpp>
+#include <CPPUtils/DataStructures/CSRGraph.hpp>
+#include <CPPUtils/DataStructures/Graph.hpp>
+
+namespace CPPUtils::Algorithms {
+
+    /**
+     * @brief Computes the core number of every vertex; the largest k such
+     * that the vertex belongs to the k-core, the maximal subgraph in which
+     * every vertex has degree at least k.
+     *
+     * Edge direction, weights, parallel edges and self loops are ignored.
+     *
+     * Vertices are peeled level by level. At level k, every remaining vertex
+     * of degree at most k is removed in parallel, decrementing the degrees
+     * of its remaining neighbours atomically; a neighbour whose degree falls
+     * to k joins the next frontier at the same level. When a level is
+     * exhausted, k jumps to the smallest remaining degree.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return std::vector<std::uint32_t> The core number of each vertex, by
+     * index.
+     */
+    template<typename T, typename U>
+    inline std::vector<std::uint32_t> coreNumbers(const DataStructures::Graphs::CSRGraph<T, U>& G,
+                                                  unsigned int numThreads = 0) {
+        using DataStructures::Graphs::VertexIndex;
+
+        const auto A = DataStructures::Graphs::simpleUndirectedAdjacency(G, numThreads);
+        const auto N = G.getVertexCardinality();
+        const auto workers = Concurrency::resolveThreadCount(numThreads);
+
+        // Frontier vertices per peeling thread.
+        constexpr size_t grain = 1024;
+
+        std::vector<std::atomic<std::uint32_t>> degree(N);
+        std::vector<std::uint8_t> removed(N, 0);
+        std::vector<std::uint32_t> core(N, 0);
+        Concurrency::parallelFor(0, N, [&](size_t v) {
+            degree[v].store(static_cast<std::uint32_t>(A.offsets[v + 1] - A.offsets[v]),
+                            std::memory_order_relaxed);
+        }, numThreads);
+
+        std::vector<VertexIndex> frontier;
+        std::vector<std::vector<VertexIndex>> next(workers);
+        size_t remaining = N;
+        std::uint32_t k = 0;
+        while (remaining > 0) {
+            // Start the level with every remaining vertex at or below k.
+            frontier.clear();
+            std::uint32_t lowest = (std::numeric_limits<std::uint32_t>::max)();
+            for (size_t v = 0; v < N; v++) {
+                if (removed[v]) {
+                    continue;
+                }
+                const auto d = degree[v].load(std::memory_order_relaxed);
+                if (d <= k) {
+                    frontier.push_back(static_cast<VertexIndex>(v));
+                } else {
+                    lowest = (std::min)(lowest, d);
+                }
+            }
+
+            if (frontier.empty()) {
+                k = lowest;
+                continue;
+            }
+
+            while (!frontier.empty()) {
+                for (const auto v : frontier) {
+                    removed[v] = 1;
+                    core[v] = k;
+                }
+                remaining -= frontier.size();
+
+                // Exactly one decrement takes a neighbour from k + 1 to k.
+                Concurrency::parallelForBlocks(0, frontier.size(), [&](size_t t, size_t first, size_t last) {
+                    next[t].clear();
+                    for (size_t i = first; i < last; i++) {
+                        const auto v = frontier[i];
+                        for (auto e = A.offsets[v]; e < A.offsets[v + 1]; e++) {
+                            const auto u = A.targets[e];
+                            if (removed[u]) {
+                                continue;
+                            }
+                            if (degree[u].fetch_sub(1, std::memory_order_relaxed) == k + 1) {
+                                next[t].push_back(u);
+                            }
+                        }
+                    }
+                }, Concurrency::threadsForWork(frontier.size(), grain, workers));
+
+                frontier.clear();
+                for (auto& n : next) {
+                    frontier.insert(frontier.end(), n.begin(), n.end());
+                    n.clear();
+                }
+            }
+            k++;
+        }
+        return core;
+    }
+
+    /**
+     * @brief Computes the core number of every vertex.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return std::unordered_map<T, std::uint32_t> The core number of each
+     * vertex.
+     */
+    template<typename T, typename U>
+    inline std::unordered_map<T, std::uint32_t> coreNumbers(const DataStructures::Graphs::Graph<T, U>& G,
+                                                            unsigned int numThreads = 0) {
+        const DataStructures::Graphs::CSRGraph<T, U> C(G, numThreads);
+        const auto cores = coreNumbers(C, numThreads);
+
+        std::unordered_map<T, std::uint32_t> result;
+        result.reserve(cores.size());
+        for (size_t i = 0; i < cores.size(); i++) {
+            result.emplace(C.getVertices()[i], cores[i]);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Provides the vertices of the k-core of a graph.
+     *
+     * @param cores The core number of each vertex, from `coreNumbers`.
+     * @param k The core order.
+     * @return std::vector<DataStructures::Graphs::VertexIndex> The vertices
+     * whose core number is at least `k`, in index order.
+     */
+    inline std::vector<DataStructures::Graphs::VertexIndex> kCoreVertices(
+        const std::vector<std::uint32_t>& cores, std::uint32_t k) {
+        std::vector<DataStructures::Graphs::VertexIndex> result;
+        for (size_t v = 0; v < cores.size(); v++) {
+            if (cores[v] >= k) {
+                result.push_back(static_cast<DataStructures::Graphs::VertexIndex>(v));
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Provides the degeneracy of a graph; its largest core number.
+     *
+     * @param cores The core number of each vertex, from `coreNumbers`.
+     * @return std::uint32_t The degeneracy, or 0 for an empty graph.
+     */
+    inline std::uint32_t degeneracy(const std::vector<std::uint32_t>& cores) {
+        return cores.empty() ? 0 : *std::max_element(cores.begin(), cores.end());
+    }
+}
+
+#endif
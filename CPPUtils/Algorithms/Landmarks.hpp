@@ -0,0 +1,655 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_ALGORITHMS_LANDMARKS
+#define CPP_UTILS_ALGORITHMS_LANDMARKS
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <CPPUtils/Algorithms/SearchState.hpp>
+#include <CPPUtils/Concurrency/Parallel.hpp>
+#include <CPPUtils/DataStructures/CSRGraph.hpp>
+#include <CPPUtils/DataStructures/Graph.hpp>
+
+namespace CPPUtils::Algorithms {
+
+    /**
+     * @brief How landmarks are chosen.
+     *
+     */
+    enum class LandmarkSelection : short {
+        // Each landmark is the vertex farthest from those already chosen.
+        FARTHEST = 0,
+
+        // Each landmark is a leaf of a shortest path tree from a random
+        // root, in the subtree whose vertices the existing landmarks bound
+        // worst (Goldberg and Harrelson's "avoid" method).
+        AVOID = 1
+    };
+
+    /**
+     * @brief The fixed size header at the start of a landmarks file.
+     *
+     * The header is followed by the vertex keys, the landmark vertex
+     * indices, the distances from the landmarks and, for directed graphs,
+     * the distances to the landmarks. All values are stored in host byte
+     * order.
+     */
+    struct LandmarksFileHeader final {
+        static constexpr char expectedMagic[8] = { 'C', 'P', 'P', 'U', 'A', 'L', 'T', '\0' };
+        static constexpr std::uint32_t currentVersion = 1;
+
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t keySize;
+        std::uint32_t costSize;
+        std::uint32_t directed;
+        std::uint64_t numVertices;
+        std::uint64_t numLandmarks;
+    };
+
+    namespace Detail {
+
+        // Dijkstra from `source` over all of `G`. Writes costs, shortest
+        // path tree parents, and the vertices in the order settled.
+        template<typename T, typename U, typename V>
+        inline void landmarkSearch(const DataStructures::Graphs::CSRGraph<T, U>& G,
+                                   DataStructures::Graphs::VertexIndex source,
+                                   V infinity,
+                                   std::vector<V>& costs,
+                                   std::vector<DataStructures::Graphs::VertexIndex>& parents,
+                                   std::vector<DataStructures::Graphs::VertexIndex>& order) {
+            using VertexIndex = DataStructures::Graphs::VertexIndex;
+            using HeapEntry = std::pair<V, VertexIndex>;
+
+            costs.assign(G.getVertexCardinality(), infinity);
+            parents.resize(G.getVertexCardinality());
+            order.clear();
+
+            std::vector<HeapEntry> heap = { { 0, source } };
+            costs[source] = 0;
+            parents[source] = source;
+            while (!heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+                const auto [cost, v] = heap.back();
+                heap.pop_back();
+                if (costs[v] < cost) {
+                    continue;
+                }
+                order.push_back(v);
+
+                const auto Nv = G.neighbours(v);
+                const auto Wv = G.neighbourWeights(v);
+                for (size_t i = 0; i < Nv.size(); i++) {
+                    const auto u = Nv[i];
+                    const auto next = cost + static_cast<V>(Wv[i]);
+                    if (next < costs[u]) {
+                        costs[u] = next;
+                        parents[u] = v;
+                        heap.emplace_back(next, u);
+                        std::push_heap(heap.begin(), heap.end(), std::greater<>());
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Landmark distances for the ALT (A*, landmarks and triangle
+     * inequality) heuristic.
+     *
+     * A few landmark vertices are chosen and the shortest path costs from
+     * each of them (and, for directed graphs, to each of them) are stored
+     * for every vertex. By the triangle inequality, `d(L, t) - d(L, v)` and
+     * `d(v, L) - d(t, L)` are lower bounds on `d(v, t)` for every landmark
+     * `L`, and the largest of them is an admissible heuristic. Bounds
+     * involving unreachable vertices are skipped. The estimate is therefore
+     * consistent on every edge into a vertex that can still reach the
+     * target, which is enough for A* guided by it to find shortest paths.
+     *
+     * Distances are stored vertex-major, so one estimate reads two short
+     * contiguous runs.
+     *
+     * Edge weights must be non-negative.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam V Cost type.
+     */
+    template<typename T, typename U = double, typename V = U>
+    class Landmarks {
+    public:
+        using VertexIndex = DataStructures::Graphs::VertexIndex;
+
+        /**
+         * @brief The stored distance between vertices with no path.
+         *
+         */
+        static constexpr V infinity = Detail::infinityOf<V>();
+
+    protected:
+        std::vector<T> keys;
+        std::unordered_map<T, VertexIndex> lookup;
+        std::vector<VertexIndex> landmarks;
+        bool directed;
+
+        // Entry `v * landmarks.size() + i` is the cost from landmark i to
+        // `v`, and from `v` to landmark i; the latter only when directed.
+        std::vector<V> fromLandmarks;
+        std::vector<V> toLandmarks;
+
+        Landmarks() : directed(false) {
+            //
+        }
+
+        void buildLookup() {
+            lookup.clear();
+            lookup.reserve(keys.size());
+            for (size_t v = 0; v < keys.size(); v++) {
+                lookup.emplace(keys[v], static_cast<VertexIndex>(v));
+            }
+        }
+
+        // A lower bound on the cost from `v` to `t` from the distances of
+        // the landmarks chosen so far, which are landmark-major.
+        static V lowerBound(const std::vector<std::vector<V>>& distances, bool undirected, VertexIndex v, VertexIndex t) {
+            V bound = 0;
+            for (const auto& D : distances) {
+                if (D[v] == infinity || D[t] == infinity) {
+                    continue;
+                }
+                if (D[t] > D[v]) {
+                    bound = std::max<V>(bound, D[t] - D[v]);
+                } else if (undirected) {
+                    bound = std::max<V>(bound, D[v] - D[t]);
+                }
+            }
+            return bound;
+        }
+
+        void select(const DataStructures::Graphs::CSRGraph<T, U>& G,
+                    size_t numLandmarks,
+                    LandmarkSelection selection,
+                    unsigned int seed,
+                    std::vector<std::vector<V>>& distances) {
+            const auto N = static_cast<VertexIndex>(G.getVertexCardinality());
+            std::mt19937 rng(seed);
+            std::uniform_int_distribution<VertexIndex> randomVertex(0, N - 1);
+
+            std::vector<V> costs;
+            std::vector<VertexIndex> parents;
+            std::vector<VertexIndex> order;
+            std::vector<bool> isLandmark(N, false);
+
+            // The least cost from any landmark to each vertex.
+            std::vector<V> nearest(N, infinity);
+
+            // The vertex farthest from every landmark so far, preferring
+            // vertices no landmark reaches; invalid if all are landmarks.
+            const auto farthest = [&]() {
+                VertexIndex best = DataStructures::Graphs::CSRGraph<T, U>::invalidVertex;
+                for (VertexIndex v = 0; v < N; v++) {
+                    if (!isLandmark[v] && (best == DataStructures::Graphs::CSRGraph<T, U>::invalidVertex ||
+                                           nearest[v] > nearest[best])) {
+                        best = v;
+                    }
+                }
+                return best;
+            };
+
+            // Shortest path tree sizes and, for each vertex, its child with
+            // the largest size.
+            std::vector<double> sizes;
+            std::vector<VertexIndex> heaviestChild;
+            std::vector<bool> coversLandmark;
+
+            while (landmarks.size() < numLandmarks) {
+                VertexIndex chosen = DataStructures::Graphs::CSRGraph<T, U>::invalidVertex;
+                if (landmarks.empty()) {
+                    // Start from the vertex farthest from a random one.
+                    const auto root = randomVertex(rng);
+                    Detail::landmarkSearch(G, root, infinity, costs, parents, order);
+                    chosen = order.back();
+                } else if (selection == LandmarkSelection::AVOID) {
+                    const auto root = randomVertex(rng);
+                    Detail::landmarkSearch(G, root, infinity, costs, parents, order);
+
+                    // A vertex's weight is how far the current bound from
+                    // the root falls short; sizes sum weights over
+                    // subtrees, and are zero for subtrees holding a landmark.
+                    sizes.assign(N, 0);
+                    heaviestChild.assign(N, DataStructures::Graphs::CSRGraph<T, U>::invalidVertex);
+                    coversLandmark.assign(N, false);
+                    for (auto it = order.rbegin(); it != order.rend(); it++) {
+                        const auto v = *it;
+                        coversLandmark[v] = coversLandmark[v] || isLandmark[v];
+                        if (coversLandmark[v]) {
+                            sizes[v] = 0;
+                        } else {
+                            sizes[v] += static_cast<double>(costs[v] - lowerBound(distances, !directed, root, v));
+                        }
+
+                        const auto p = parents[v];
+                        if (p != v) {
+                            sizes[p] += sizes[v];
+                            coversLandmark[p] = coversLandmark[p] || coversLandmark[v];
+                            if (sizes[v] > 0 && (heaviestChild[p] == DataStructures::Graphs::CSRGraph<T, U>::invalidVertex ||
+                                                 sizes[v] > sizes[heaviestChild[p]])) {
+                                heaviestChild[p] = v;
+                            }
+                        }
+                    }
+
+                    // Descend from the largest subtree to a leaf.
+                    auto v = *std::max_element(order.begin(), order.end(), [&](VertexIndex a, VertexIndex b) {
+                        return sizes[a] < sizes[b];
+                    });
+                    if (sizes[v] > 0) {
+                        while (heaviestChild[v] != DataStructures::Graphs::CSRGraph<T, U>::invalidVertex) {
+                            v = heaviestChild[v];
+                        }
+                        chosen = v;
+                    } else {
+                        chosen = farthest();
+                    }
+                } else {
+                    chosen = farthest();
+                }
+
+                if (chosen == DataStructures::Graphs::CSRGraph<T, U>::invalidVertex || isLandmark[chosen]) {
+                    break;
+                }
+
+                Detail::landmarkSearch(G, chosen, infinity, costs, parents, order);
+                for (VertexIndex v = 0; v < N; v++) {
+                    nearest[v] = std::min(nearest[v], costs[v]);
+                }
+                isLandmark[chosen] = true;
+                landmarks.push_back(chosen);
+                distances.push_back(costs);
+            }
+        }
+
+        // Lays landmark-major distances out vertex-major.
+        void interleave(const std::vector<std::vector<V>>& distances, std::vector<V>& out) const {
+            const auto K = landmarks.size();
+            out.resize(keys.size() * K);
+            for (size_t v = 0; v < keys.size(); v++) {
+                for (size_t i = 0; i < K; i++) {
+                    out[v * K + i] = distances[i][v];
+                }
+            }
+        }
+
+    public:
+        /**
+         * @brief Construct a new Landmarks object for `G`, choosing up to
+         * `numLandmarks` landmarks.
+         *
+         * @param G The graph.
+         * @param numLandmarks The number of landmarks; fewer are chosen if
+         * the graph has fewer vertices.
+         * @param selection How landmarks are chosen.
+         * @param numThreads The number of worker threads, or 0 for all
+         * available, used for the distances to the landmarks.
+         * @param seed Seeds the random choices.
+         */
+        explicit Landmarks(const DataStructures::Graphs::CSRGraph<T, U>& G,
+                           size_t numLandmarks = 16,
+                           LandmarkSelection selection = LandmarkSelection::AVOID,
+                           unsigned int numThreads = 0,
+                           unsigned int seed = 0) :
+            keys(G.getVertices().begin(), G.getVertices().end()),
+            directed(G.isDirected()) {
+            if constexpr (std::is_signed_v<U>) {
+                const auto W = G.getWeights();
+                if (std::any_of(W.begin(), W.end(), [](U w) { return w < 0; })) {
+                    throw std::invalid_argument("Landmarks require non-negative edge weights.");
+                }
+            }
+
+            buildLookup();
+            if (keys.empty() || numLandmarks == 0) {
+                return;
+            }
+
+            std::vector<std::vector<V>> distances;
+            select(G, std::min(numLandmarks, keys.size()), selection, seed, distances);
+            interleave(distances, fromLandmarks);
+
+            if (directed) {
+                // Costs to each landmark are costs from it on the transpose.
+                const auto R = DataStructures::Graphs::transpose(G);
+                Concurrency::parallelForBlocks(0, landmarks.size(), [&](size_t, size_t first, size_t last) {
+                    std::vector<VertexIndex> parents;
+                    std::vector<VertexIndex> order;
+                    for (size_t i = first; i < last; i++) {
+                        Detail::landmarkSearch(R, landmarks[i], infinity, distances[i], parents, order);
+                    }
+                }, numThreads);
+                interleave(distances, toLandmarks);
+            }
+        }
+
+        /**
+         * @brief Construct a new Landmarks object for `G`, choosing up to
+         * `numLandmarks` landmarks.
+         *
+         * Vertex indices are those of the CSR form of `G`.
+         *
+         * @param G The graph.
+         * @param numLandmarks The number of landmarks.
+         * @param selection How landmarks are chosen.
+         * @param numThreads The number of worker threads, or 0 for all
+         * available.
+         * @param seed Seeds the random choices.
+         */
+        explicit Landmarks(const DataStructures::Graphs::Graph<T, U>& G,
+                           size_t numLandmarks = 16,
+                           LandmarkSelection selection = LandmarkSelection::AVOID,
+                           unsigned int numThreads = 0,
+                           unsigned int seed = 0) :
+            Landmarks(DataStructures::Graphs::CSRGraph<T, U>(G, numThreads), numLandmarks, selection, numThreads, seed) {
+            //
+        }
+
+        Landmarks(const Landmarks&) = default;
+        Landmarks& operator=(const Landmarks&) = default;
+        Landmarks(Landmarks&&) noexcept = default;
+        Landmarks& operator=(Landmarks&&) noexcept = default;
+
+        virtual ~Landmarks() {
+            //
+        }
+
+        /**
+         * @brief Provides the number of vertices.
+         *
+         * @return size_t The vertex count.
+         */
+        size_t getVertexCardinality() const {
+            return keys.size();
+        }
+
+        /**
+         * @brief Provides the landmarks, as vertex indices.
+         *
+         * @return std::span<const VertexIndex> The landmarks, in the order
+         * chosen.
+         */
+        std::span<const VertexIndex> getLandmarks() const {
+            return landmarks;
+        }
+
+        /**
+         * @brief Provides the index of the vertex with key `v`.
+         *
+         * @param v The vertex key.
+         * @return VertexIndex The index, or `CSRGraph::invalidVertex`.
+         */
+        VertexIndex indexOf(const T& v) const {
+            const auto it = lookup.find(v);
+            return it == lookup.end() ? DataStructures::Graphs::CSRGraph<T, U>::invalidVertex : it->second;
+        }
+
+        /**
+         * @brief Provides the key of the vertex at index `v`.
+         *
+         * @param v The vertex index.
+         * @return const T& The key.
+         */
+        const T& vertexAt(VertexIndex v) const {
+            return keys.at(v);
+        }
+
+        /**
+         * @brief Provides the stored cost from landmark `i` to `v`.
+         *
+         * @param i The landmark's position in `getLandmarks`.
+         * @param v The vertex index.
+         * @return V The cost, or `infinity`.
+         */
+        V getDistanceFrom(size_t i, VertexIndex v) const {
+            return fromLandmarks.at(static_cast<size_t>(v) * landmarks.size() + i);
+        }
+
+        /**
+         * @brief Provides the stored cost from `v` to landmark `i`.
+         *
+         * @param i The landmark's position in `getLandmarks`.
+         * @param v The vertex index.
+         * @return V The cost, or `infinity`.
+         */
+        V getDistanceTo(size_t i, VertexIndex v) const {
+            return directed ? toLandmarks.at(static_cast<size_t>(v) * landmarks.size() + i) : getDistanceFrom(i, v);
+        }
+
+        /**
+         * @brief Estimates the cost from `v` to `t`, never overestimating.
+         *
+         * Vertex indices are those of the graph the landmarks were built
+         * from, so the landmarks can serve as the heuristic of an
+         * `AStarSearchContext` or `BidirectionalSearchContext` over the same
+         * `CSRGraph`.
+         *
+         * @param v The vertex index.
+         * @param t The target vertex index.
+         * @return V A lower bound on the cost of a path from `v` to `t`.
+         */
+        V estimate(VertexIndex v, VertexIndex t) const {
+            const auto K = landmarks.size();
+            const V* Fv = fromLandmarks.data() + static_cast<size_t>(v) * K;
+            const V* Ft = fromLandmarks.data() + static_cast<size_t>(t) * K;
+
+            V bound = 0;
+            for (size_t i = 0; i < K; i++) {
+                if (Fv[i] == infinity || Ft[i] == infinity) {
+                    continue;
+                }
+                if (Ft[i] > Fv[i]) {
+                    bound = std::max<V>(bound, Ft[i] - Fv[i]);
+                } else if (!directed) {
+                    bound = std::max<V>(bound, Fv[i] - Ft[i]);
+                }
+            }
+
+            if (directed) {
+                const V* Tv = toLandmarks.data() + static_cast<size_t>(v) * K;
+                const V* Tt = toLandmarks.data() + static_cast<size_t>(t) * K;
+                for (size_t i = 0; i < K; i++) {
+                    if (Tv[i] != infinity && Tt[i] != infinity && Tv[i] > Tt[i]) {
+                        bound = std::max<V>(bound, Tv[i] - Tt[i]);
+                    }
+                }
+            }
+            return bound;
+        }
+
+        /**
+         * @brief Estimates the cost from `v` to `t`; see `estimate`.
+         *
+         * @param v The vertex index.
+         * @param t The target vertex index.
+         * @return V A lower bound on the cost of a path from `v` to `t`.
+         */
+        V operator()(VertexIndex v, VertexIndex t) const {
+            return estimate(v, t);
+        }
+
+        /**
+         * @brief Provides a heuristic towards `target` for `AStarSearch`.
+         *
+         * `AStarSearch` passes the vertex being expanded and the neighbour
+         * being queued; the estimate is from the neighbour to `target`. The
+         * landmarks must outlive the heuristic.
+         *
+         * @param target The goal vertex key.
+         * @return std::function<V(T, T)> The heuristic; zero everywhere if
+         * `target` is unknown.
+         */
+        std::function<V(T, T)> heuristicTo(const T& target) const {
+            const auto t = indexOf(target);
+            if (t == DataStructures::Graphs::CSRGraph<T, U>::invalidVertex) {
+                return [](T, T) { return static_cast<V>(0); };
+            }
+
+            return [this, t](T, T u) {
+                const auto v = indexOf(u);
+                return v == DataStructures::Graphs::CSRGraph<T, U>::invalidVertex ? static_cast<V>(0) : estimate(v, t);
+            };
+        }
+
+        /**
+         * @brief Writes the landmarks to `path` in binary form.
+         *
+         * @param path The output file path.
+         */
+        void save(const std::string& path) const {
+            static_assert(std::is_trivially_copyable_v<T>, "Vertex type must be trivially copyable.");
+            static_assert(std::is_trivially_copyable_v<V>, "Cost type must be trivially copyable.");
+
+            LandmarksFileHeader header{};
+            std::memcpy(header.magic, LandmarksFileHeader::expectedMagic, sizeof(header.magic));
+            header.version = LandmarksFileHeader::currentVersion;
+            header.keySize = sizeof(T);
+            header.costSize = sizeof(V);
+            header.directed = directed ? 1 : 0;
+            header.numVertices = keys.size();
+            header.numLandmarks = landmarks.size();
+
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                throw std::runtime_error("Unable to open file for writing: " + path);
+            }
+
+            const auto write = [&file](const auto& values) {
+                file.write(reinterpret_cast<const char*>(values.data()),
+                           static_cast<std::streamsize>(values.size() * sizeof(values[0])));
+            };
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            write(keys);
+            write(landmarks);
+            write(fromLandmarks);
+            write(toLandmarks);
+
+            if (!file) {
+                throw std::runtime_error("Unable to write landmarks file: " + path);
+            }
+        }
+
+        /**
+         * @brief Reads landmarks written by `save`.
+         *
+         * @param path The input file path.
+         * @return Landmarks The landmarks.
+         */
+        static Landmarks load(const std::string& path) {
+            static_assert(std::is_trivially_copyable_v<T>, "Vertex type must be trivially copyable.");
+            static_assert(std::is_trivially_copyable_v<V>, "Cost type must be trivially copyable.");
+
+            std::ifstream file(path, std::ios::binary);
+            if (!file) {
+                throw std::runtime_error("Unable to open file for reading: " + path);
+            }
+
+            LandmarksFileHeader header;
+            if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+                throw std::runtime_error("Landmarks file is truncated: " + path);
+            }
+            if (std::memcmp(header.magic, LandmarksFileHeader::expectedMagic, sizeof(header.magic)) != 0) {
+                throw std::runtime_error("Not a landmarks file: " + path);
+            }
+            if (header.version != LandmarksFileHeader::currentVersion) {
+                throw std::runtime_error("Unsupported landmarks file version: " + path);
+            }
+            if (header.keySize != sizeof(T) || header.costSize != sizeof(V)) {
+                throw std::runtime_error("Landmarks file vertex or cost type mismatch: " + path);
+            }
+
+            // Check the sizes against the file before allocating. With N and
+            // K below 2^32 neither the keys and landmarks nor one row of the
+            // tables can overflow; the row count is bounded by division
+            // before it is multiplied.
+            const auto N = header.numVertices;
+            const auto K = header.numLandmarks;
+            const auto start = file.tellg();
+            file.seekg(0, std::ios::end);
+            const auto available = static_cast<std::uint64_t>(file.tellg() - start);
+            file.seekg(start);
+            if (N >= DataStructures::Graphs::CSRGraph<T, U>::invalidVertex || K > N || header.directed > 1) {
+                throw std::runtime_error("Landmarks file is corrupt: " + path);
+            }
+            const std::uint64_t leadingBytes = N * sizeof(T) + K * sizeof(VertexIndex);
+            const std::uint64_t rowBytes = (header.directed ? 2 : 1) * K * sizeof(V);
+            if (leadingBytes > available || (rowBytes > 0 && N > (available - leadingBytes) / rowBytes) ||
+                leadingBytes + N * rowBytes != available) {
+                throw std::runtime_error("Landmarks file is corrupt: " + path);
+            }
+
+            Landmarks L;
+            L.directed = header.directed == 1;
+            const auto read = [&file](auto& values, std::uint64_t count) {
+                values.resize(count);
+                file.read(reinterpret_cast<char*>(values.data()),
+                          static_cast<std::streamsize>(count * sizeof(values[0])));
+            };
+            read(L.keys, N);
+            read(L.landmarks, K);
+            read(L.fromLandmarks, N * K);
+            read(L.toLandmarks, L.directed ? N * K : 0);
+            if (!file) {
+                throw std::runtime_error("Landmarks file is truncated: " + path);
+            }
+            if (std::any_of(L.landmarks.begin(), L.landmarks.end(), [N](VertexIndex v) { return v >= N; })) {
+                throw std::runtime_error("Landmarks file is corrupt: " + path);
+            }
+
+            L.buildLookup();
+            return L;
+        }
+    };
+}
+
+#endif
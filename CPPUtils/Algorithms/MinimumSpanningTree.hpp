@@ -0,0 +1,324 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_ALGORITHMS_MINIMUM_SPANNING_TREE
+#define CPP_UTILS_ALGORITHMS_MINIMUM_SPANNING_TREE
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <CPPUtils/Algorithms/ConnectedComponents.hpp>
+#include <CPPUtils/Concurrency/Parallel.hpp>
+#include <CPPUtils/DataStructures/CSRGraph.hpp>
+#include <CPPUtils/DataStructures/Graph.hpp>
+
+namespace CPPUtils::Algorithms {
+
+    /**
+     * @brief A minimum spanning forest; one minimum spanning tree per
+     * connected component.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     */
+    template<typename T, typename U = double>
+    struct SpanningForest final {
+        std::vector<DataStructures::Graphs::WeightedEdge<T, U>> edges;
+        U totalWeight = 0;
+        size_t numTrees = 0;
+    };
+
+    namespace Detail {
+
+        template<typename U>
+        struct IndexedEdge final {
+            DataStructures::Graphs::VertexIndex a;
+            DataStructures::Graphs::VertexIndex b;
+            U weight;
+        };
+
+        /**
+         * @brief Lists the edges of `G` once each, ignoring direction and
+         * skipping self loops.
+         *
+         * @tparam T Vertex type.
+         * @tparam U Weight type.
+         * @param G The graph.
+         * @param numThreads The number of threads to use.
+         * @return std::vector<IndexedEdge<U>> The edges.
+         */
+        template<typename T, typename U>
+        inline std::vector<IndexedEdge<U>> spanningCandidates(const DataStructures::Graphs::CSRGraph<T, U>& G,
+                                                              unsigned int numThreads) {
+            using DataStructures::Graphs::VertexIndex;
+
+            // Undirected edges are stored at both ends; keep the a < b copy.
+            const auto keep = [&G](size_t v, VertexIndex u) {
+                return G.isDirected() ? u != v : v < u;
+            };
+
+            const auto N = G.getVertexCardinality();
+            std::vector<size_t> offsets(N + 1, 0);
+            Concurrency::parallelFor(0, N, [&](size_t v) {
+                for (const auto u : G.neighbours(static_cast<VertexIndex>(v))) {
+                    offsets[v + 1] += keep(v, u) ? 1 : 0;
+                }
+            }, numThreads);
+
+            for (size_t v = 0; v < N; v++) {
+                offsets[v + 1] += offsets[v];
+            }
+
+            std::vector<IndexedEdge<U>> edges(offsets[N]);
+            Concurrency::parallelFor(0, N, [&](size_t v) {
+                const auto Nv = G.neighbours(static_cast<VertexIndex>(v));
+                const auto Wv = G.neighbourWeights(static_cast<VertexIndex>(v));
+                auto k = offsets[v];
+                for (size_t i = 0; i < Nv.size(); i++) {
+                    if (keep(v, Nv[i])) {
+                        edges[k++] = { static_cast<VertexIndex>(v), Nv[i], Wv[i] };
+                    }
+                }
+            }, numThreads);
+            return edges;
+        }
+
+        template<typename T, typename U>
+        inline SpanningForest<T, U> toSpanningForest(const DataStructures::Graphs::CSRGraph<T, U>& G,
+                                                     const std::vector<IndexedEdge<U>>& edges) {
+            SpanningForest<T, U> forest;
+            forest.edges.reserve(edges.size());
+            for (const auto& e : edges) {
+                forest.edges.push_back({ G.vertexAt(e.a), G.vertexAt(e.b), e.weight });
+                forest.totalWeight += e.weight;
+            }
+            forest.numTrees = G.getVertexCardinality() - edges.size();
+            return forest;
+        }
+    }
+
+    /**
+     * @brief Computes a minimum spanning forest with Kruskal's algorithm.
+     *
+     * Edge direction is ignored. The edges are sorted by weight in parallel,
+     * then scanned in order, keeping each edge that joins two different
+     * trees of a union-find forest.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return SpanningForest<T, U> The forest.
+     */
+    template<typename T, typename U>
+    inline SpanningForest<T, U> kruskal(const DataStructures::Graphs::CSRGraph<T, U>& G,
+                                        unsigned int numThreads = 0) {
+        auto edges = Detail::spanningCandidates(G, numThreads);
+        Concurrency::parallelSort(edges.begin(), edges.end(),
+            [](const Detail::IndexedEdge<U>& x, const Detail::IndexedEdge<U>& y) {
+                return x.weight < y.weight;
+            }, numThreads);
+
+        const auto N = G.getVertexCardinality();
+        ConcurrentUnionFind sets(N);
+        std::vector<Detail::IndexedEdge<U>> tree;
+        for (const auto& e : edges) {
+            // A spanning tree of N vertices has N - 1 edges.
+            if (tree.size() + 1 >= N) {
+                break;
+            }
+            if (sets.unite(e.a, e.b)) {
+                tree.push_back(e);
+            }
+        }
+        return Detail::toSpanningForest(G, tree);
+    }
+
+    /**
+     * @brief Computes a minimum spanning forest with Kruskal's algorithm.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return SpanningForest<T, U> The forest.
+     */
+    template<typename T, typename U>
+    inline SpanningForest<T, U> kruskal(const DataStructures::Graphs::Graph<T, U>& G,
+                                        unsigned int numThreads = 0) {
+        return kruskal(DataStructures::Graphs::CSRGraph<T, U>(G, numThreads), numThreads);
+    }
+
+    /**
+     * @brief Computes a minimum spanning forest with Borůvka's algorithm.
+     *
+     * Edge direction is ignored. Each round, every edge between two trees
+     * offers itself to both trees in parallel, each tree keeping its
+     * lightest offer through an atomic compare-and-swap. Ties are broken by
+     * edge index, so the lightest edges never form a cycle and can all be
+     * merged into a `ConcurrentUnionFind` in parallel. Edges that have
+     * become internal to a tree are then dropped. The number of trees at
+     * least halves each round.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return SpanningForest<T, U> The forest.
+     */
+    template<typename T, typename U>
+    inline SpanningForest<T, U> boruvka(const DataStructures::Graphs::CSRGraph<T, U>& G,
+                                        unsigned int numThreads = 0) {
+        const auto edges = Detail::spanningCandidates(G, numThreads);
+        const auto N = G.getVertexCardinality();
+        const auto workers = Concurrency::resolveThreadCount(numThreads);
+
+        constexpr auto none = (std::numeric_limits<std::uint64_t>::max)();
+        const auto lighter = [&edges](std::uint64_t x, std::uint64_t y) {
+            return y == none || edges[x].weight < edges[y].weight ||
+                   (!(edges[y].weight < edges[x].weight) && x < y);
+        };
+        const auto offer = [&lighter](std::atomic<std::uint64_t>& slot, std::uint64_t e) {
+            auto current = slot.load(std::memory_order_relaxed);
+            while (lighter(e, current) &&
+                   !slot.compare_exchange_weak(current, e, std::memory_order_relaxed)) {
+                //
+            }
+        };
+
+        ConcurrentUnionFind sets(N);
+        std::vector<std::atomic<std::uint64_t>> lightest(N);
+        std::vector<std::uint8_t> selected(edges.size(), 0);
+
+        // The edges still joining two different trees.
+        std::vector<std::uint64_t> active(edges.size());
+        Concurrency::parallelFor(0, edges.size(), [&](size_t e) {
+            active[e] = e;
+        }, numThreads);
+
+        std::vector<std::vector<std::uint64_t>> kept(workers);
+        while (!active.empty()) {
+            Concurrency::parallelFor(0, N, [&](size_t v) {
+                lightest[v].store(none, std::memory_order_relaxed);
+            }, numThreads);
+
+            // Offer each edge to the trees at both of its ends.
+            Concurrency::parallelFor(0, active.size(), [&](size_t i) {
+                const auto e = active[i];
+                const auto ra = sets.find(edges[e].a);
+                const auto rb = sets.find(edges[e].b);
+                if (ra != rb) {
+                    offer(lightest[ra], e);
+                    offer(lightest[rb], e);
+                }
+            }, numThreads);
+
+            // Merge along every tree's lightest edge. When two trees pick the
+            // same edge, only the first unite succeeds.
+            Concurrency::parallelFor(0, N, [&](size_t v) {
+                const auto e = lightest[v].load(std::memory_order_relaxed);
+                if (e != none && sets.unite(edges[e].a, edges[e].b)) {
+                    selected[e] = 1;
+                }
+            }, numThreads);
+
+            // Drop edges that are now internal to a tree.
+            Concurrency::parallelForBlocks(0, active.size(), [&](size_t t, size_t first, size_t last) {
+                kept[t].clear();
+                for (size_t i = first; i < last; i++) {
+                    const auto e = active[i];
+                    if (!sets.sameSet(edges[e].a, edges[e].b)) {
+                        kept[t].push_back(e);
+                    }
+                }
+            }, numThreads);
+
+            active.clear();
+            for (auto& k : kept) {
+                active.insert(active.end(), k.begin(), k.end());
+                k.clear();
+            }
+        }
+
+        std::vector<Detail::IndexedEdge<U>> tree;
+        for (size_t e = 0; e < edges.size(); e++) {
+            if (selected[e]) {
+                tree.push_back(edges[e]);
+            }
+        }
+        return Detail::toSpanningForest(G, tree);
+    }
+
+    /**
+     * @brief Computes a minimum spanning forest with Borůvka's algorithm.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return SpanningForest<T, U> The forest.
+     */
+    template<typename T, typename U>
+    inline SpanningForest<T, U> boruvka(const DataStructures::Graphs::Graph<T, U>& G,
+                                        unsigned int numThreads = 0) {
+        return boruvka(DataStructures::Graphs::CSRGraph<T, U>(G, numThreads), numThreads);
+    }
+
+    /**
+     * @brief Builds an undirected graph from a spanning forest.
+     *
+     * Every vertex of `G` is included, so isolated vertices remain as single
+     * vertex trees.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph that the forest spans.
+     * @param forest The forest.
+     * @return DataStructures::Graphs::Graph<T, U> The forest as a graph.
+     */
+    template<typename T, typename U>
+    inline DataStructures::Graphs::Graph<T, U> spanningForestGraph(const DataStructures::Graphs::Graph<T, U>& G,
+                                                                   const SpanningForest<T, U>& forest) {
+        DataStructures::Graphs::Graph<T, U> result;
+        for (const auto& v : G.getVertexRange()) {
+            result.addVertex(v);
+        }
+        for (const auto& e : forest.edges) {
+            result.addEdge(e.source, e.target, e.weight);
+        }
+        return result;
+    }
+}
+
+#endif
@@ -33,18 +33,29 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef CPP_UTILS_ALGORITHMS_PATH_FINDING
 #define CPP_UTILS_ALGORITHMS_PATH_FINDING
 
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <map>
+#include <memory>
 #include <queue>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include <CPPUtils/Algorithms/SearchState.hpp>
 #include <CPPUtils/DataStructures/Graph.hpp>
+#include <CPPUtils/DataStructures/PriorityQueues.hpp>
 
 namespace CPPUtils::Algorithms {
 
-    template<typename T, typename U = double>
-    using Graph = CPPUtils::DataStructures::Graphs::Graph<T, U>;
+    template<typename T, typename U = double, typename A = std::allocator<std::byte>>
+    using Graph = CPPUtils::DataStructures::Graphs::Graph<T, U, A>;
 
     template<typename T, typename U = double>
     using RankedVertex = std::pair<U, T>;
@@ -53,7 +64,9 @@ namespace CPPUtils::Algorithms {
     struct VertexCostPriority final {
         bool operator()(const RankedVertex<T, U>& a,
                         const RankedVertex<T, U>& b) const {
-            return a.first < b.first;
+            // std::priority_queue pops its greatest element, so ranking
+            // the lower cost as greater makes it a min-heap.
+            return a.first > b.first;
         }
     };
 
@@ -62,116 +75,545 @@ namespace CPPUtils::Algorithms {
                                                     std::vector<RankedVertex<T, U>>,
                                                     VertexCostPriority<T, U>>;
 
-    template<typename T>
-    inline std::vector<T> getPath(std::map<T, T> path, const T& src, const T& sink) {
-        // Start at the sink vertex.
-        std::vector<T> reversedPath = { sink };
-
-        // While there are traversals to check.
-        while (!path.empty()) {
-            // Get the last appended (to the output path) vertex.
-            const auto& v = reversedPath.back();
+    /**
+     * @brief A map from each vertex to the vertex it was reached from, such
+     * as `std::map<T, T>` or `std::unordered_map<T, T>`.
+     *
+     */
+    template<typename Map, typename T>
+    concept ParentMap = requires(const Map& parents, const T& v) {
+        { parents.find(v) == parents.end() } -> std::convertible_to<bool>;
+        { parents.find(v)->second } -> std::convertible_to<const T&>;
+        { parents.size() } -> std::convertible_to<size_t>;
+    };
 
-            // If the last vertex added does not exist as a key, then we can 
-            // traverse no further.
-            if (path.find(v) == path.end()) {
-                return {};
+    /**
+     * @brief Walks the breadcrumbs in `parents` back from `sink` to `src`,
+     * writing the path into `path` and reusing its storage.
+     *
+     * @tparam T Vertex type.
+     * @tparam Map Parent map type.
+     * @param parents Maps each vertex to the vertex it was reached from.
+     * @param src The source vertex.
+     * @param sink The final vertex.
+     * @param path Receives the path, source first; empty if the
+     * breadcrumbs do not lead from `sink` to `src`.
+     * @return true If a path was found.
+     * @return false Otherwise.
+     */
+    template<typename T, ParentMap<T> Map>
+    inline bool getPath(const Map& parents, const T& src, const T& sink, std::vector<T>& path) {
+        path.clear();
+        path.push_back(sink);
+
+        // A path visits each breadcrumb at most once, which bounds the walk
+        // should the breadcrumbs contain a cycle.
+        for (size_t hops = 0; path.back() != src; hops++) {
+            const auto it = parents.find(path.back());
+            if (it == parents.end() || hops == parents.size()) {
+                path.clear();
+                return false;
             }
+            path.push_back(it->second);
+        }
 
-            // Store the node u traversed to from v.
-            const auto& u = path.at(v);
-            reversedPath.push_back(u);
+        std::reverse(path.begin(), path.end());
+        return true;
+    }
 
-            // If u is the source node, we have reconstructed the path.
-            if (u == src) {
-                break;
-            }
+    /**
+     * @brief Walks a parent array back from `sink` to `src`, writing the
+     * path into `path` and reusing its storage.
+     *
+     * @tparam I Vertex index type.
+     * @param parents The vertex each vertex was reached from, by index.
+     * @param src The source vertex.
+     * @param sink The final vertex.
+     * @param path Receives the path, source first; empty if the parents do
+     * not lead from `sink` to `src`.
+     * @return true If a path was found.
+     * @return false Otherwise.
+     */
+    template<std::integral I>
+    inline bool getPath(const std::vector<I>& parents, I src, I sink, std::vector<I>& path) {
+        path.clear();
+        if (static_cast<size_t>(sink) >= parents.size()) {
+            return false;
+        }
 
-            // Remove for next iteration.
-            path.erase(v);
+        path.push_back(sink);
+        for (size_t hops = 0; path.back() != src; hops++) {
+            const auto v = path.back();
+            const auto u = parents[static_cast<size_t>(v)];
+            if (u == v || static_cast<size_t>(u) >= parents.size() || hops == parents.size()) {
+                path.clear();
+                return false;
+            }
+            path.push_back(u);
         }
 
-        // What we actually have is the path in reverse, so we just need to reverse it.
-        std::reverse(reversedPath.begin(), reversedPath.end());
-        return reversedPath;
+        std::reverse(path.begin(), path.end());
+        return true;
     }
 
-    template<typename T, typename U = double, typename V = double>
-    inline std::vector<T> AStarSearch(const Graph<T, U>& G,
-                                      const T& startingVertex,
-                                      std::function<bool(T)> goalTest,
-                                      std::function<V(T, T)> heuristic) {
-        // Sanity check the starting vertex.
-        if (!G.vertexExists(startingVertex)) {
-            return {};
+    /**
+     * @brief Provides the path the breadcrumbs in `parents` lead along from
+     * `src` to `sink`.
+     *
+     * @tparam T Vertex type.
+     * @tparam Map Parent map type.
+     * @param parents Maps each vertex to the vertex it was reached from.
+     * @param src The source vertex.
+     * @param sink The final vertex.
+     * @return std::vector<T> The path, source first; empty if there is none.
+     */
+    template<typename T, ParentMap<T> Map>
+    inline std::vector<T> getPath(const Map& parents, const T& src, const T& sink) {
+        std::vector<T> path;
+        getPath(parents, src, sink, path);
+        return path;
+    }
+
+    /**
+     * @brief The priority queue used to order the search frontier.
+     * 
+     */
+    enum class PriorityQueueType : short {
+        // A binary heap; improved vertices are inserted again, and stale
+        // entries skipped when popped.
+        BINARY_HEAP = 0,
+
+        // A 4-ary heap holding each vertex once, with decrease-key.
+        INDEXED_DARY_HEAP = 1,
+
+        // A radix heap; integer costs and monotone priorities only, as for
+        // Dijkstra's algorithm or a consistent heuristic.
+        RADIX_HEAP = 2
+    };
+
+    /**
+     * @brief A heuristic of zero everywhere, which turns A* into Dijkstra's
+     * algorithm.
+     *
+     * `AStarSearch` recognises this type and skips the heuristic entirely.
+     */
+    struct ZeroHeuristic final {
+        template<typename T>
+        constexpr int operator()(const T&, const T&) const noexcept {
+            return 0;
         }
+    };
 
-        // Vertices to visit.
-        VertexPriorityQueue<T, V> Q;
+    namespace Detail {
 
-        // Vertices along the path from start to goal.
-        std::map<T, T> path;
+        // Frontiers over dense search ids; push inserts or lowers priority.
+        template<typename V>
+        class BinaryHeapFrontier {
+            VertexPriorityQueue<std::uint32_t, V> Q;
 
-        // Cumulative costs - key set also determines visited vertices.
-        std::unordered_map<T, V> cumulativeCosts;
-        for (const auto& v : G.getVertices()) {
-            cumulativeCosts[v] = (std::numeric_limits<V>::max)();
-        }
+        public:
+            void push(std::uint32_t v, V priority) {
+                Q.emplace(priority, v);
+            }
+
+            std::uint32_t pop() {
+                const auto v = Q.top().second;
+                Q.pop();
+                return v;
+            }
+
+            bool empty() const {
+                return Q.empty();
+            }
+        };
+
+        template<typename V>
+        class IndexedHeapFrontier {
+            DataStructures::PriorityQueues::IndexedDaryHeap<V, 4> Q;
+
+        public:
+            void push(std::uint32_t v, V priority) {
+                if (v >= Q.capacity()) {
+                    Q.reserve(2 * (static_cast<size_t>(v) + 1));
+                }
+                Q.pushOrDecrease(v, priority);
+            }
+
+            std::uint32_t pop() {
+                return Q.pop().second;
+            }
+
+            bool empty() const {
+                return Q.empty();
+            }
+        };
+
+        template<std::integral V>
+        class RadixHeapFrontier {
+            DataStructures::PriorityQueues::RadixHeap<V> Q;
 
-        // Start by adding the starting vertex, with cost 0.
-        Q.emplace(0.0, startingVertex);
-        cumulativeCosts[startingVertex] = 0.0;
+        public:
+            void push(std::uint32_t v, V priority) {
+                Q.push(v, priority);
+            }
 
-        // While we still have vertices to visit.
-        while (!Q.empty()) {
-            // Get the current lowest cost vertex.
-            const auto v = Q.top().second;
-            Q.pop();
+            std::uint32_t pop() {
+                return Q.pop().second;
+            }
 
-            // Test if this vertex satisfies the goal state.
-            if (goalTest(v)) {
-                return getPath(path, startingVertex, v);
+            bool empty() const {
+                return Q.empty();
             }
+        };
 
-            // Evaluate the move cost for each neighbour.
-            for (const auto& n : G.getAdjacencyList(v)) {
-                // Compute the cost of moving to neighbour u of v.
-                const auto& u = n.getVertex();
-                const auto cost = cumulativeCosts.at(v) + n.getWeight();
+        // Runs A* to the first goal vertex settled, writing its cost and,
+        // if `WithPath`, the path to it. Without the path, no breadcrumbs
+        // are kept at all.
+        template<bool WithPath, typename T, typename U, typename V, typename GoalTest, typename Heuristic, typename Frontier, typename A>
+        inline bool AStarSearch(const Graph<T, U, A>& G,
+                                const T& startingVertex,
+                                GoalTest& goalTest,
+                                Heuristic& heuristic,
+                                Frontier& Q,
+                                V& goalCost,
+                                std::vector<T>& path) {
+            // Vertices are given dense ids as they are reached, so that the
+            // costs, breadcrumbs and settled flags are plain arrays.
+            std::unordered_map<T, std::uint32_t> ids;
+            std::vector<T> keys;
+            std::vector<V> costs;
+            std::vector<std::uint32_t> parents;
+            std::vector<bool> settled;
+            const auto idOf = [&](const T& v) -> std::uint32_t {
+                const auto [it, inserted] = ids.try_emplace(v, static_cast<std::uint32_t>(keys.size()));
+                if (inserted) {
+                    keys.push_back(v);
+                    costs.push_back((std::numeric_limits<V>::max)());
+                    if constexpr (WithPath) {
+                        parents.push_back(it->second);
+                    }
+                    settled.push_back(false);
+                }
+                return it->second;
+            };
+
+            // Start by adding the starting vertex, with cost 0.
+            const auto s = idOf(startingVertex);
+            costs[s] = 0;
+            Q.push(s, 0);
+
+            // While we still have vertices to visit.
+            while (!Q.empty()) {
+                // Get the current lowest cost vertex, skipping stale entries.
+                const auto v = Q.pop();
+                if (settled[v]) {
+                    continue;
+                }
+                settled[v] = true;
+
+                // Test if this vertex satisfies the goal state; if so, follow
+                // the breadcrumbs back to the start.
+                const T key = keys[v];
+                if (goalTest(key)) {
+                    goalCost = costs[v];
+                    if constexpr (WithPath) {
+                        path.assign(1, key);
+                        for (auto u = v; parents[u] != u; u = parents[u]) {
+                            path.push_back(keys[parents[u]]);
+                        }
+                        std::reverse(path.begin(), path.end());
+                    }
+                    return true;
+                }
 
-                // If this neighbour cost is lower.
-                const auto uCumulative = cumulativeCosts.at(u);
-                if (cost < uCumulative) {
-                    // Push the vertex with the sum of these two costs.
-                    Q.emplace(cost + uCumulative, u);
+                // Evaluate the move cost for each neighbour.
+                for (const auto& n : G.getAdjacencyList(key)) {
+                    const auto u = idOf(n.getVertex());
+                    if (settled[u]) {
+                        continue;
+                    }
+
+                    // If this neighbour cost is lower, update it and queue
+                    // the neighbour by cost plus heuristic.
+                    const auto cost = costs[v] + static_cast<V>(n.getWeight());
+                    if (cost < costs[u]) {
+                        costs[u] = cost;
+                        if constexpr (WithPath) {
+                            parents[u] = v;
+                        }
+                        if constexpr (std::is_same_v<std::remove_cv_t<Heuristic>, ZeroHeuristic>) {
+                            Q.push(u, cost);
+                        } else {
+                            Q.push(u, cost + static_cast<V>(heuristic(key, n.getVertex())));
+                        }
+                    }
+                }
+            }
+            return false;
+        }
 
-                    // Update cost.
-                    cumulativeCosts[u] = cost + heuristic(v, u);
+        template<bool WithPath, typename T, typename U, typename V, typename GoalTest, typename Heuristic, typename A>
+        inline bool runAStarSearch(const Graph<T, U, A>& G,
+                                   const T& startingVertex,
+                                   GoalTest& goalTest,
+                                   Heuristic& heuristic,
+                                   PriorityQueueType queueType,
+                                   V& goalCost,
+                                   std::vector<T>& path) {
+            goalCost = Detail::infinityOf<V>();
+            path.clear();
+
+            // Sanity check the starting vertex.
+            if (!G.vertexExists(startingVertex)) {
+                return false;
+            }
 
-                    // Add the vertex traversal - think of a breadcrumb path.
-                    path[u] = v;
+            switch (queueType) {
+            case PriorityQueueType::BINARY_HEAP: {
+                BinaryHeapFrontier<V> Q;
+                return AStarSearch<WithPath, T, U>(G, startingVertex, goalTest, heuristic, Q, goalCost, path);
+            }
+            case PriorityQueueType::INDEXED_DARY_HEAP: {
+                IndexedHeapFrontier<V> Q;
+                return AStarSearch<WithPath, T, U>(G, startingVertex, goalTest, heuristic, Q, goalCost, path);
+            }
+            case PriorityQueueType::RADIX_HEAP:
+                if constexpr (std::is_integral_v<V>) {
+                    RadixHeapFrontier<V> Q;
+                    return AStarSearch<WithPath, T, U>(G, startingVertex, goalTest, heuristic, Q, goalCost, path);
+                } else {
+                    throw std::invalid_argument("The radix heap requires integer costs.");
                 }
             }
+            throw std::invalid_argument("Unknown priority queue type.");
+        }
+
+        template<typename T, typename U, typename V, typename GoalTest, typename Heuristic, typename A>
+        inline std::vector<T> AStarSearchPath(const Graph<T, U, A>& G,
+                                              const T& startingVertex,
+                                              GoalTest& goalTest,
+                                              Heuristic& heuristic,
+                                              PriorityQueueType queueType) {
+            V cost;
+            std::vector<T> path;
+            runAStarSearch<true>(G, startingVertex, goalTest, heuristic, queueType, cost, path);
+            return path;
         }
-        return {};
     }
 
-    template<typename T, typename U = double>
-    inline std::vector<T> dijkstra(const Graph<T, U>& G,
+    /**
+     * @brief Searches from `startingVertex` for a vertex satisfying
+     * `goalTest`, expanding vertices in order of cost plus `heuristic`.
+     * 
+     * `heuristic(v, u)` is added to the cost of reaching `u` from `v`.
+     * 
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam V Cost type.
+     * @tparam A Allocator type of the graph.
+     * @param G The graph to search.
+     * @param startingVertex The starting vertex.
+     * @param goalTest The goal test.
+     * @param heuristic The cost estimate.
+     * @param queueType The frontier priority queue.
+     * @return std::vector<T> The path to the goal, or empty if none.
+     */
+    template<typename T, typename U = double, typename V = double, typename A>
+    inline std::vector<T> AStarSearch(const Graph<T, U, A>& G,
+                                      const T& startingVertex,
+                                      std::function<bool(T)> goalTest,
+                                      std::function<V(T, T)> heuristic,
+                                      PriorityQueueType queueType = PriorityQueueType::INDEXED_DARY_HEAP) {
+        return Detail::AStarSearchPath<T, U, V>(G, startingVertex, goalTest, heuristic, queueType);
+    }
+
+    /**
+     * @brief Searches from `startingVertex` for a vertex satisfying
+     * `goalTest`, expanding vertices in order of cost plus `heuristic`,
+     * writing the path into `path`.
+     * 
+     * As above, but reuses the caller's buffer, so repeated searches need
+     * not allocate a new path each time.
+     * 
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam V Cost type.
+     * @tparam A Allocator type of the graph.
+     * @param G The graph to search.
+     * @param startingVertex The starting vertex.
+     * @param goalTest The goal test.
+     * @param heuristic The cost estimate.
+     * @param path Receives the path to the goal; emptied if there is none.
+     * @param queueType The frontier priority queue.
+     * @return true If a goal was reached.
+     * @return false Otherwise.
+     */
+    template<typename T, typename U = double, typename V = double, typename A>
+    inline bool AStarSearch(const Graph<T, U, A>& G,
+                            const T& startingVertex,
+                            std::function<bool(T)> goalTest,
+                            std::function<V(T, T)> heuristic,
+                            std::vector<T>& path,
+                            PriorityQueueType queueType = PriorityQueueType::INDEXED_DARY_HEAP) {
+        V cost;
+        return Detail::runAStarSearch<true>(G, startingVertex, goalTest, heuristic, queueType, cost, path);
+    }
+
+    /**
+     * @brief Searches from `startingVertex` for a vertex satisfying
+     * `goalTest`, expanding vertices in order of cost plus `heuristic`.
+     * 
+     * As above, but the goal test and heuristic are called directly rather
+     * than through `std::function`, so they can be inlined into the search
+     * loop. Passing `ZeroHeuristic` removes the heuristic altogether.
+     * 
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam V Cost type.
+     * @tparam GoalTest Callable type, `bool(const T&)`.
+     * @tparam Heuristic Callable type, `V(const T&, const T&)`.
+     * @tparam A Allocator type of the graph.
+     * @param G The graph to search.
+     * @param startingVertex The starting vertex.
+     * @param goalTest The goal test.
+     * @param heuristic The cost estimate.
+     * @param queueType The frontier priority queue.
+     * @return std::vector<T> The path to the goal, or empty if none.
+     */
+    template<typename T, typename U = double, typename V = double, typename GoalTest, typename Heuristic, typename A>
+        requires std::predicate<GoalTest&, const T&> &&
+                 std::convertible_to<std::invoke_result_t<Heuristic&, const T&, const T&>, V>
+    inline std::vector<T> AStarSearch(const Graph<T, U, A>& G,
+                                      const T& startingVertex,
+                                      GoalTest&& goalTest,
+                                      Heuristic&& heuristic,
+                                      PriorityQueueType queueType = PriorityQueueType::INDEXED_DARY_HEAP) {
+        return Detail::AStarSearchPath<T, U, V>(G, startingVertex, goalTest, heuristic, queueType);
+    }
+
+    /**
+     * @brief Searches from `startingVertex` for a vertex satisfying
+     * `goalTest`, with directly called callables, writing the path into
+     * `path`.
+     * 
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam V Cost type.
+     * @tparam GoalTest Callable type, `bool(const T&)`.
+     * @tparam Heuristic Callable type, `V(const T&, const T&)`.
+     * @tparam A Allocator type of the graph.
+     * @param G The graph to search.
+     * @param startingVertex The starting vertex.
+     * @param goalTest The goal test.
+     * @param heuristic The cost estimate.
+     * @param path Receives the path to the goal; emptied if there is none.
+     * @param queueType The frontier priority queue.
+     * @return true If a goal was reached.
+     * @return false Otherwise.
+     */
+    template<typename T, typename U = double, typename V = double, typename GoalTest, typename Heuristic, typename A>
+        requires std::predicate<GoalTest&, const T&> &&
+                 std::convertible_to<std::invoke_result_t<Heuristic&, const T&, const T&>, V>
+    inline bool AStarSearch(const Graph<T, U, A>& G,
+                            const T& startingVertex,
+                            GoalTest&& goalTest,
+                            Heuristic&& heuristic,
+                            std::vector<T>& path,
+                            PriorityQueueType queueType = PriorityQueueType::INDEXED_DARY_HEAP) {
+        V cost;
+        return Detail::runAStarSearch<true>(G, startingVertex, goalTest, heuristic, queueType, cost, path);
+    }
+
+    template<typename T, typename U = double, typename A>
+    inline std::vector<T> dijkstra(const Graph<T, U, A>& G,
                                    const T& src,
-                                   const T& sink) {
+                                   const T& sink,
+                                   PriorityQueueType queueType = PriorityQueueType::INDEXED_DARY_HEAP) {
         // Goal state test; if a given vertex is the sink vertex.
         auto g = [sink](const T& a) -> bool {
             return a == sink;
         };
 
-        // A constant heuristic of 0.
-        constexpr auto h = [](const T&, const T&) -> U {
-            return 0;
-        };
+        // Run A* with the above goal test and no heuristic.
+        return AStarSearch<T, U, U>(G, src, g, ZeroHeuristic(), queueType);
+    }
+
+    /**
+     * @brief Finds a shortest path from `src` to `sink`, writing it into
+     * `path`.
+     * 
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam A Allocator type of the graph.
+     * @param G The graph to search.
+     * @param src The source vertex.
+     * @param sink The sink vertex.
+     * @param path Receives the path; emptied if `sink` is unreachable.
+     * @param queueType The frontier priority queue.
+     * @return true If `sink` is reachable.
+     * @return false Otherwise.
+     */
+    template<typename T, typename U = double, typename A>
+    inline bool dijkstra(const Graph<T, U, A>& G,
+                         const T& src,
+                         const T& sink,
+                         std::vector<T>& path,
+                         PriorityQueueType queueType = PriorityQueueType::INDEXED_DARY_HEAP) {
+        return AStarSearch<T, U, U>(G, src, [&sink](const T& a) { return a == sink; }, ZeroHeuristic(), path, queueType);
+    }
+
+    /**
+     * @brief Provides the cost of the path `AStarSearch` would find, without
+     * keeping breadcrumbs or building the path.
+     * 
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam V Cost type.
+     * @tparam GoalTest Callable type, `bool(const T&)`.
+     * @tparam Heuristic Callable type, `V(const T&, const T&)`.
+     * @tparam A Allocator type of the graph.
+     * @param G The graph to search.
+     * @param startingVertex The starting vertex.
+     * @param goalTest The goal test.
+     * @param heuristic The cost estimate.
+     * @param queueType The frontier priority queue.
+     * @return V The cost of reaching the goal; infinity, or the maximum
+     * value of `V`, if no goal is reachable.
+     */
+    template<typename T, typename U = double, typename V = double, typename GoalTest, typename Heuristic, typename A>
+        requires std::predicate<GoalTest&, const T&> &&
+                 std::convertible_to<std::invoke_result_t<Heuristic&, const T&, const T&>, V>
+    inline V AStarSearchCost(const Graph<T, U, A>& G,
+                             const T& startingVertex,
+                             GoalTest&& goalTest,
+                             Heuristic&& heuristic,
+                             PriorityQueueType queueType = PriorityQueueType::INDEXED_DARY_HEAP) {
+        V cost;
+        std::vector<T> unused;
+        Detail::runAStarSearch<false>(G, startingVertex, goalTest, heuristic, queueType, cost, unused);
+        return cost;
+    }
 
-        // Run A* with the above goal test and nought heuristic.
-        return AStarSearch<T, U, U>(G, src, g, h);
+    /**
+     * @brief Provides the cost of a shortest path from `src` to `sink`,
+     * without building the path.
+     * 
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam A Allocator type of the graph.
+     * @param G The graph to search.
+     * @param src The source vertex.
+     * @param sink The sink vertex.
+     * @param queueType The frontier priority queue.
+     * @return U The cost; infinity, or the maximum value of `U`, if `sink`
+     * is unreachable.
+     */
+    template<typename T, typename U = double, typename A>
+    inline U dijkstraCost(const Graph<T, U, A>& G,
+                          const T& src,
+                          const T& sink,
+                          PriorityQueueType queueType = PriorityQueueType::INDEXED_DARY_HEAP) {
+        return AStarSearchCost<T, U, U>(G, src, [&sink](const T& a) { return a == sink; }, ZeroHeuristic(), queueType);
     }
 }
 
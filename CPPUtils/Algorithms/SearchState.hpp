@@ -0,0 +1,62 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_ALGORITHMS_SEARCH_STATE
+#define CPP_UTILS_ALGORITHMS_SEARCH_STATE
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace CPPUtils::Algorithms::Detail {
+
+    // The cost of an unreached vertex: infinity where `V` has one, else its
+    // largest value.
+    template<typename V>
+    constexpr V infinityOf() {
+        return std::numeric_limits<V>::has_infinity ? std::numeric_limits<V>::infinity() :
+                                                      (std::numeric_limits<V>::max)();
+    }
+
+    // Advances the generation that per-vertex `stamps` are compared against,
+    // so search state is reset lazily between queries. On wrap around, stale
+    // stamps could alias the new generation, so they are cleared.
+    template<typename... Stamps>
+    inline void nextGeneration(std::uint32_t& generation, Stamps&... stamps) {
+        if (++generation == 0) {
+            (std::fill(stamps.begin(), stamps.end(), 0), ...);
+            generation = 1;
+        }
+    }
+}
+
+#endif
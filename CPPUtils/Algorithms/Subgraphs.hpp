@@ -0,0 +1,386 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_ALGORITHMS_SUBGRAPHS
+#define CPP_UTILS_ALGORITHMS_SUBGRAPHS
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <CPPUtils/DataStructures/CSRGraph.hpp>
+#include <CPPUtils/DataStructures/Graph.hpp>
+
+namespace CPPUtils::Algorithms {
+
+    /**
+     * @brief Extracts k-hop neighbourhoods and induced subgraphs from a
+     * `CSRGraph`, reusing its scratch space between queries.
+     *
+     * Membership is tracked with a visited bitset, plus a table mapping
+     * member vertices to their index in the result. Only the entries touched
+     * by a query are reset afterwards, so each query costs time in
+     * proportion to the part of the graph it explores rather than to the
+     * size of the graph. Results are written in bulk into compact CSR
+     * arrays.
+     *
+     * Not thread safe; use one extractor per thread.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     */
+    template<typename T, typename U = double>
+    class SubgraphExtractor {
+    public:
+        using VertexIndex = DataStructures::Graphs::VertexIndex;
+        using EdgeIndex = DataStructures::Graphs::EdgeIndex;
+
+    private:
+        const DataStructures::Graphs::CSRGraph<T, U>& G;
+
+        std::vector<std::uint64_t> visited;
+        std::vector<VertexIndex> localIndex;
+        std::vector<VertexIndex> members;
+
+        bool isVisited(VertexIndex v) const {
+            return (visited[v >> 6] >> (v & 63)) & 1;
+        }
+
+        bool visit(VertexIndex v) {
+            if (isVisited(v)) {
+                return false;
+            }
+            visited[v >> 6] |= std::uint64_t(1) << (v & 63);
+            localIndex[v] = static_cast<VertexIndex>(members.size());
+            members.push_back(v);
+            return true;
+        }
+
+        void reset() {
+            for (const auto v : members) {
+                visited[v >> 6] = 0;
+                localIndex[v] = DataStructures::Graphs::CSRGraph<T, U>::invalidVertex;
+            }
+            members.clear();
+        }
+
+        void collectKHop(VertexIndex source, unsigned int k) {
+            if (source >= G.getVertexCardinality()) {
+                return;
+            }
+
+            // Members double as the BFS queue; each layer is a contiguous run.
+            visit(source);
+            size_t layerBegin = 0;
+            for (unsigned int hop = 0; hop < k && layerBegin < members.size(); hop++) {
+                const auto layerEnd = members.size();
+                for (size_t i = layerBegin; i < layerEnd; i++) {
+                    for (const auto u : G.neighbours(members[i])) {
+                        visit(u);
+                    }
+                }
+                layerBegin = layerEnd;
+            }
+        }
+
+        DataStructures::Graphs::CSRGraph<T, U> buildInduced() const {
+            const auto N = members.size();
+            std::vector<T> keys(N);
+            std::vector<EdgeIndex> offsets(N + 1, 0);
+            for (size_t i = 0; i < N; i++) {
+                keys[i] = G.vertexAt(members[i]);
+                for (const auto u : G.neighbours(members[i])) {
+                    offsets[i + 1] += isVisited(u) ? 1 : 0;
+                }
+                offsets[i + 1] += offsets[i];
+            }
+
+            std::vector<VertexIndex> targets(offsets[N]);
+            std::vector<U> weights(offsets[N]);
+            std::vector<std::pair<VertexIndex, U>> row;
+            for (size_t i = 0; i < N; i++) {
+                const auto Nv = G.neighbours(members[i]);
+                const auto Wv = G.neighbourWeights(members[i]);
+                row.clear();
+                for (size_t j = 0; j < Nv.size(); j++) {
+                    if (isVisited(Nv[j])) {
+                        row.emplace_back(localIndex[Nv[j]], Wv[j]);
+                    }
+                }
+
+                // Relabelling doesn't preserve the order of targets.
+                std::stable_sort(row.begin(), row.end(), [](const auto& a, const auto& b) {
+                    return a.first < b.first;
+                });
+
+                auto pos = offsets[i];
+                for (const auto& [u, w] : row) {
+                    targets[pos] = u;
+                    weights[pos] = w;
+                    pos++;
+                }
+            }
+
+            return DataStructures::Graphs::CSRGraph<T, U>(G.isDirected(), std::move(keys), std::move(offsets),
+                                                          std::move(targets), std::move(weights));
+        }
+
+    public:
+        /**
+         * @brief Construct a new Subgraph Extractor object for `G`.
+         *
+         * `G` must outlive the extractor.
+         *
+         * @param G The graph to extract from.
+         */
+        explicit SubgraphExtractor(const DataStructures::Graphs::CSRGraph<T, U>& G) :
+            G(G),
+            visited((G.getVertexCardinality() + 63) / 64, 0),
+            localIndex(G.getVertexCardinality(), DataStructures::Graphs::CSRGraph<T, U>::invalidVertex) {
+            //
+        }
+
+        /**
+         * @brief Provides the vertices within `k` hops of `source`,
+         * following outward edges.
+         *
+         * @param source The centre vertex.
+         * @param k The maximum number of hops.
+         * @return std::vector<VertexIndex> The vertices in breadth first
+         * order, starting with `source`; empty if `source` is invalid.
+         */
+        std::vector<VertexIndex> kHopVertices(VertexIndex source, unsigned int k) {
+            collectKHop(source, k);
+            auto result = members;
+            reset();
+            return result;
+        }
+
+        /**
+         * @brief Extracts the subgraph induced by the vertices within `k`
+         * hops of `source`.
+         *
+         * @param source The centre vertex.
+         * @param k The maximum number of hops.
+         * @return DataStructures::Graphs::CSRGraph<T, U> The subgraph, with
+         * vertices in breadth first order.
+         */
+        DataStructures::Graphs::CSRGraph<T, U> kHopSubgraph(VertexIndex source, unsigned int k) {
+            collectKHop(source, k);
+            auto result = buildInduced();
+            reset();
+            return result;
+        }
+
+        /**
+         * @brief Extracts the subgraph induced by `vertices`; every edge
+         * between two of them.
+         *
+         * Invalid and repeated vertices are ignored.
+         *
+         * @param vertices The vertex set.
+         * @return DataStructures::Graphs::CSRGraph<T, U> The subgraph, with
+         * vertices in the order given.
+         */
+        DataStructures::Graphs::CSRGraph<T, U> induced(std::span<const VertexIndex> vertices) {
+            for (const auto v : vertices) {
+                if (v < G.getVertexCardinality()) {
+                    visit(v);
+                }
+            }
+            auto result = buildInduced();
+            reset();
+            return result;
+        }
+    };
+
+    /**
+     * @brief Provides the vertices within `k` hops of `source`, following
+     * outward edges.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @param source The centre vertex.
+     * @param k The maximum number of hops.
+     * @return std::vector<T> The vertices in breadth first order, starting
+     * with `source`; empty if `source` is not in `G`.
+     */
+    template<typename T, typename U>
+    inline std::vector<T> kHopNeighbourhood(const DataStructures::Graphs::Graph<T, U>& G,
+                                            const T& source,
+                                            unsigned int k) {
+        if (!G.vertexExists(source)) {
+            return {};
+        }
+
+        // The result doubles as the BFS queue; each layer is a contiguous run.
+        std::vector<T> result{ source };
+        std::unordered_set<T> visited{ source };
+        size_t layerBegin = 0;
+        for (unsigned int hop = 0; hop < k && layerBegin < result.size(); hop++) {
+            const auto layerEnd = result.size();
+            for (size_t i = layerBegin; i < layerEnd; i++) {
+                for (const auto& e : G.getAdjacencyList(result[i])) {
+                    if (visited.insert(e.getVertex()).second) {
+                        result.push_back(e.getVertex());
+                    }
+                }
+            }
+            layerBegin = layerEnd;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Extracts the subgraph induced by `vertices` as a `CSRGraph`.
+     *
+     * Vertices not in `G`, and repeats, are ignored.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @param vertices The vertex set.
+     * @return DataStructures::Graphs::CSRGraph<T, U> The subgraph, with
+     * vertices in the order given.
+     */
+    template<typename T, typename U>
+    inline DataStructures::Graphs::CSRGraph<T, U> inducedSubgraphCSR(const DataStructures::Graphs::Graph<T, U>& G,
+                                                                     std::type_identity_t<std::span<const T>> vertices) {
+        using DataStructures::Graphs::EdgeIndex;
+        using DataStructures::Graphs::VertexIndex;
+
+        std::vector<T> keys;
+        std::unordered_map<T, VertexIndex> index;
+        index.reserve(vertices.size());
+        for (const auto& v : vertices) {
+            if (G.vertexExists(v) && index.emplace(v, static_cast<VertexIndex>(keys.size())).second) {
+                keys.push_back(v);
+            }
+        }
+
+        const auto N = keys.size();
+        std::vector<EdgeIndex> offsets(N + 1, 0);
+        std::vector<VertexIndex> targets;
+        std::vector<U> weights;
+        std::vector<std::pair<VertexIndex, U>> row;
+        for (size_t i = 0; i < N; i++) {
+            row.clear();
+            for (const auto& e : G.getAdjacencyList(keys[i])) {
+                const auto it = index.find(e.getVertex());
+                if (it != index.end()) {
+                    row.emplace_back(it->second, e.getWeight());
+                }
+            }
+            std::stable_sort(row.begin(), row.end(), [](const auto& a, const auto& b) {
+                return a.first < b.first;
+            });
+
+            for (const auto& [u, w] : row) {
+                targets.push_back(u);
+                weights.push_back(w);
+            }
+            offsets[i + 1] = targets.size();
+        }
+
+        return DataStructures::Graphs::CSRGraph<T, U>(G.isDirected(), std::move(keys), std::move(offsets),
+                                                      std::move(targets), std::move(weights));
+    }
+
+    /**
+     * @brief Extracts the subgraph induced by `vertices`; every edge between
+     * two of them.
+     *
+     * The result is directed if `G` is. Vertices not in `G` are ignored.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @param vertices The vertex set.
+     * @return DataStructures::Graphs::Graph<T, U> The subgraph.
+     */
+    template<typename T, typename U>
+    inline DataStructures::Graphs::Graph<T, U> inducedSubgraph(const DataStructures::Graphs::Graph<T, U>& G,
+                                                               std::type_identity_t<std::span<const T>> vertices) {
+        using DataStructures::Graphs::Graph;
+        using DataStructures::Graphs::VertexIndex;
+
+        // Undirected edges are stored at both ends; adding one from each end
+        // would double it, so go via the dense indices of the CSR form.
+        const auto C = inducedSubgraphCSR(G, vertices);
+        // Self-loops are stored once or twice according to the policy, so
+        // the halving below only holds under the same policy.
+        Graph<T, U> result = G.emptyCopy();
+        for (const auto& v : C.getVertices()) {
+            result.addVertex(v);
+        }
+
+        for (size_t v = 0; v < C.getVertexCardinality(); v++) {
+            const auto Nv = C.neighbours(static_cast<VertexIndex>(v));
+            const auto Wv = C.neighbourWeights(static_cast<VertexIndex>(v));
+            size_t selfLoops = 0;
+            for (size_t i = 0; i < Nv.size(); i++) {
+                const auto u = Nv[i];
+                if (G.isDirected() || v < u || (v == u && selfLoops++ % 2 == 0)) {
+                    result.addEdge(C.vertexAt(static_cast<VertexIndex>(v)), C.vertexAt(u), Wv[i]);
+                }
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Extracts the subgraph induced by the vertices within `k` hops
+     * of `source`.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @param source The centre vertex.
+     * @param k The maximum number of hops.
+     * @return DataStructures::Graphs::Graph<T, U> The subgraph.
+     */
+    template<typename T, typename U>
+    inline DataStructures::Graphs::Graph<T, U> kHopSubgraph(const DataStructures::Graphs::Graph<T, U>& G,
+                                                            const T& source,
+                                                            unsigned int k) {
+        const auto vertices = kHopNeighbourhood(G, source, k);
+        return inducedSubgraph(G, vertices);
+    }
+}
+
+#endif
@@ -0,0 +1,360 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_ALGORITHMS_TRIANGLES
+#define CPP_UTILS_ALGORITHMS_TRIANGLES
+
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CPP_UTILS_TRIANGLES_SSE2
+#endif
+
+#include <CPPUtils/Concurrency/Parallel.hpp>
+#include <CPPUtils/DataStructures/CSRGraph.hpp>
+#include <CPPUtils/DataStructures/Graph.hpp>
+
+namespace CPPUtils::Algorithms {
+
+    namespace Detail {
+
+        /**
+         * @brief Counts the common elements of two sorted, duplicate free
+         * ranges with a scalar merge.
+         *
+         * @param a The first range.
+         * @param b The second range.
+         * @return size_t The size of the intersection.
+         */
+        inline size_t intersectionSizeScalar(std::span<const DataStructures::Graphs::VertexIndex> a,
+                                             std::span<const DataStructures::Graphs::VertexIndex> b) {
+            size_t i = 0;
+            size_t j = 0;
+            size_t count = 0;
+            while (i < a.size() && j < b.size()) {
+                if (a[i] < b[j]) {
+                    i++;
+                } else if (b[j] < a[i]) {
+                    j++;
+                } else {
+                    count++;
+                    i++;
+                    j++;
+                }
+            }
+            return count;
+        }
+
+        /**
+         * @brief Counts the common elements of two sorted, duplicate free
+         * ranges.
+         *
+         * With SSE2, blocks of four from each range are compared all against
+         * all, by comparing against each of the four rotations of the second
+         * block, and whichever block has the smaller last element is then
+         * advanced. The remainders are merged with scalar code.
+         *
+         * @param a The first range.
+         * @param b The second range.
+         * @return size_t The size of the intersection.
+         */
+        inline size_t intersectionSize(std::span<const DataStructures::Graphs::VertexIndex> a,
+                                       std::span<const DataStructures::Graphs::VertexIndex> b) {
+#ifdef CPP_UTILS_TRIANGLES_SSE2
+            size_t i = 0;
+            size_t j = 0;
+            size_t count = 0;
+            const size_t na = a.size() & ~static_cast<size_t>(3);
+            const size_t nb = b.size() & ~static_cast<size_t>(3);
+            while (i < na && j < nb) {
+                const auto va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a.data() + i));
+                const auto vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b.data() + j));
+
+                auto m = _mm_cmpeq_epi32(va, vb);
+                m = _mm_or_si128(m, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+                m = _mm_or_si128(m, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+                m = _mm_or_si128(m, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+                count += std::popcount(static_cast<unsigned int>(_mm_movemask_ps(_mm_castsi128_ps(m))));
+
+                const auto aMax = a[i + 3];
+                const auto bMax = b[j + 3];
+                if (aMax <= bMax) {
+                    i += 4;
+                }
+                if (bMax <= aMax) {
+                    j += 4;
+                }
+            }
+            return count + intersectionSizeScalar(a.subspan(i), b.subspan(j));
+#else
+            return intersectionSizeScalar(a, b);
+#endif
+        }
+
+        /**
+         * @brief Orients each undirected edge from lower to higher (degree,
+         * index) rank, so that every triangle is found exactly once and high
+         * degree vertices have short forward lists.
+         *
+         * @param A Simple undirected adjacency.
+         * @param numThreads The number of threads to use.
+         * @return DataStructures::Graphs::UndirectedAdjacency The forward
+         * neighbours of each vertex, sorted.
+         */
+        inline DataStructures::Graphs::UndirectedAdjacency orientByDegree(
+            const DataStructures::Graphs::UndirectedAdjacency& A, unsigned int numThreads) {
+            using DataStructures::Graphs::EdgeIndex;
+
+            const auto N = A.offsets.size() - 1;
+            const auto ranksBelow = [&A](size_t v, size_t u) {
+                const auto dv = A.offsets[v + 1] - A.offsets[v];
+                const auto du = A.offsets[u + 1] - A.offsets[u];
+                return dv < du || (dv == du && v < u);
+            };
+
+            DataStructures::Graphs::UndirectedAdjacency F;
+            F.offsets.assign(N + 1, 0);
+            Concurrency::parallelFor(0, N, [&](size_t v) {
+                for (auto e = A.offsets[v]; e < A.offsets[v + 1]; e++) {
+                    F.offsets[v + 1] += ranksBelow(v, A.targets[e]) ? 1 : 0;
+                }
+            }, numThreads);
+
+            for (size_t v = 0; v < N; v++) {
+                F.offsets[v + 1] += F.offsets[v];
+            }
+
+            F.targets.resize(F.offsets[N]);
+            Concurrency::parallelFor(0, N, [&](size_t v) {
+                EdgeIndex k = F.offsets[v];
+                for (auto e = A.offsets[v]; e < A.offsets[v + 1]; e++) {
+                    if (ranksBelow(v, A.targets[e])) {
+                        F.targets[k++] = A.targets[e];
+                    }
+                }
+            }, numThreads);
+            return F;
+        }
+
+        inline std::span<const DataStructures::Graphs::VertexIndex> row(
+            const DataStructures::Graphs::UndirectedAdjacency& A, size_t v) {
+            return { A.targets.data() + A.offsets[v], A.targets.data() + A.offsets[v + 1] };
+        }
+
+        inline std::uint64_t countTriangles(const DataStructures::Graphs::UndirectedAdjacency& A,
+                                            unsigned int numThreads) {
+            const auto F = orientByDegree(A, numThreads);
+            const auto N = F.offsets.size() - 1;
+
+            std::vector<std::uint64_t> partial(Concurrency::resolveThreadCount(numThreads), 0);
+            Concurrency::parallelForBlocks(0, N, [&](size_t t, size_t first, size_t last) {
+                std::uint64_t count = 0;
+                for (size_t v = first; v < last; v++) {
+                    const auto Fv = row(F, v);
+                    for (const auto u : Fv) {
+                        count += intersectionSize(Fv, row(F, u));
+                    }
+                }
+                partial[t] = count;
+            }, numThreads);
+
+            std::uint64_t total = 0;
+            for (const auto c : partial) {
+                total += c;
+            }
+            return total;
+        }
+    }
+
+    /**
+     * @brief Counts the triangles in a graph.
+     *
+     * Edge direction, weights, parallel edges and self loops are ignored.
+     * Edges are oriented by degree and each triangle is counted once, at its
+     * lowest ranked vertex, by intersecting sorted forward neighbour lists.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return std::uint64_t The number of triangles.
+     */
+    template<typename T, typename U>
+    inline std::uint64_t countTriangles(const DataStructures::Graphs::CSRGraph<T, U>& G,
+                                        unsigned int numThreads = 0) {
+        return Detail::countTriangles(DataStructures::Graphs::simpleUndirectedAdjacency(G, numThreads),
+                                      numThreads);
+    }
+
+    /**
+     * @brief Counts the triangles in a graph.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return std::uint64_t The number of triangles.
+     */
+    template<typename T, typename U>
+    inline std::uint64_t countTriangles(const DataStructures::Graphs::Graph<T, U>& G,
+                                        unsigned int numThreads = 0) {
+        return countTriangles(DataStructures::Graphs::CSRGraph<T, U>(G, numThreads), numThreads);
+    }
+
+    /**
+     * @brief Counts the triangles that each vertex is part of.
+     *
+     * Edge direction, weights, parallel edges and self loops are ignored.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return std::vector<std::uint64_t> The triangle count of each vertex,
+     * by index.
+     */
+    template<typename T, typename U>
+    inline std::vector<std::uint64_t> vertexTriangleCounts(const DataStructures::Graphs::CSRGraph<T, U>& G,
+                                                           unsigned int numThreads = 0) {
+        const auto A = DataStructures::Graphs::simpleUndirectedAdjacency(G, numThreads);
+        const auto N = G.getVertexCardinality();
+
+        // Each triangle at v is seen from both of its other vertices.
+        std::vector<std::uint64_t> counts(N, 0);
+        Concurrency::parallelFor(0, N, [&](size_t v) {
+            const auto Av = Detail::row(A, v);
+            std::uint64_t count = 0;
+            for (const auto u : Av) {
+                count += Detail::intersectionSize(Av, Detail::row(A, u));
+            }
+            counts[v] = count / 2;
+        }, numThreads);
+        return counts;
+    }
+
+    /**
+     * @brief Computes the local clustering coefficient of every vertex; the
+     * fraction of pairs of its neighbours that are themselves adjacent.
+     *
+     * Vertices with fewer than two neighbours have a coefficient of 0.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam R Coefficient type.
+     * @param G The graph.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return std::vector<R> The coefficient of each vertex, by index.
+     */
+    template<typename T, typename U, typename R = double>
+    inline std::vector<R> localClusteringCoefficients(const DataStructures::Graphs::CSRGraph<T, U>& G,
+                                                      unsigned int numThreads = 0) {
+        const auto A = DataStructures::Graphs::simpleUndirectedAdjacency(G, numThreads);
+        const auto N = G.getVertexCardinality();
+
+        std::vector<R> result(N, 0);
+        Concurrency::parallelFor(0, N, [&](size_t v) {
+            const auto Av = Detail::row(A, v);
+            const auto d = static_cast<R>(Av.size());
+            if (Av.size() < 2) {
+                return;
+            }
+
+            // Twice the triangles at v, over twice the neighbour pairs.
+            std::uint64_t count = 0;
+            for (const auto u : Av) {
+                count += Detail::intersectionSize(Av, Detail::row(A, u));
+            }
+            result[v] = static_cast<R>(count) / (d * (d - 1));
+        }, numThreads);
+        return result;
+    }
+
+    /**
+     * @brief Computes the local clustering coefficient of every vertex.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam R Coefficient type.
+     * @param G The graph.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return std::unordered_map<T, R> The coefficient of each vertex.
+     */
+    template<typename T, typename U, typename R = double>
+    inline std::unordered_map<T, R> localClusteringCoefficients(const DataStructures::Graphs::Graph<T, U>& G,
+                                                                unsigned int numThreads = 0) {
+        const DataStructures::Graphs::CSRGraph<T, U> C(G, numThreads);
+        const auto coefficients = localClusteringCoefficients<T, U, R>(C, numThreads);
+
+        std::unordered_map<T, R> result;
+        result.reserve(coefficients.size());
+        for (size_t i = 0; i < coefficients.size(); i++) {
+            result.emplace(C.getVertices()[i], coefficients[i]);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Computes the global clustering coefficient, or transitivity, of
+     * a graph; three times the number of triangles over the number of
+     * connected triples.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam R Coefficient type.
+     * @param G The graph.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return R The coefficient, or 0 if there are no connected triples.
+     */
+    template<typename T, typename U, typename R = double>
+    inline R globalClusteringCoefficient(const DataStructures::Graphs::CSRGraph<T, U>& G,
+                                         unsigned int numThreads = 0) {
+        const auto A = DataStructures::Graphs::simpleUndirectedAdjacency(G, numThreads);
+        const auto N = G.getVertexCardinality();
+
+        std::uint64_t triples = 0;
+        for (size_t v = 0; v < N; v++) {
+            const auto d = A.offsets[v + 1] - A.offsets[v];
+            triples += d < 2 ? 0 : d * (d - 1) / 2;
+        }
+        if (triples == 0) {
+            return 0;
+        }
+        return static_cast<R>(3 * Detail::countTriangles(A, numThreads)) / static_cast<R>(triples);
+    }
+}
+
+#endif
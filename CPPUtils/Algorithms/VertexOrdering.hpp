@@ -0,0 +1,269 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_ALGORITHMS_VERTEX_ORDERING
+#define CPP_UTILS_ALGORITHMS_VERTEX_ORDERING
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include <CPPUtils/DataStructures/CSRGraph.hpp>
+#include <CPPUtils/DataStructures/Graph.hpp>
+
+namespace CPPUtils::Algorithms {
+
+    /*
+     * Each ordering is a permutation `order` of the vertex indices of a
+     * `CSRGraph`, where `order[i]` is the current index of the vertex that
+     * should be placed at index `i`. Edge direction is ignored throughout.
+     */
+
+    namespace Detail {
+        // Breadth first order of every component, optionally visiting the
+        // neighbours of each vertex in order of increasing degree, and
+        // starting each component from the vertex given by `root`.
+        template<typename F>
+        inline std::vector<DataStructures::Graphs::VertexIndex> breadthFirst(
+            const DataStructures::Graphs::UndirectedAdjacency& A, bool byDegree, F&& root) {
+            using DataStructures::Graphs::VertexIndex;
+
+            const auto N = A.offsets.size() - 1;
+            auto degree = [&A](VertexIndex v) {
+                return A.offsets[v + 1] - A.offsets[v];
+            };
+
+            std::vector<VertexIndex> order;
+            order.reserve(N);
+            std::vector<bool> seen(N, false);
+            std::vector<VertexIndex> next;
+
+            for (size_t v = 0; v < N; v++) {
+                if (seen[v]) {
+                    continue;
+                }
+
+                const VertexIndex r = root(static_cast<VertexIndex>(v), seen);
+                seen[r] = true;
+                order.push_back(r);
+                for (size_t head = order.size() - 1; head < order.size(); head++) {
+                    const auto u = order[head];
+
+                    next.clear();
+                    for (auto e = A.offsets[u]; e < A.offsets[u + 1]; e++) {
+                        const auto w = A.targets[e];
+                        if (!seen[w]) {
+                            seen[w] = true;
+                            next.push_back(w);
+                        }
+                    }
+
+                    if (byDegree) {
+                        std::stable_sort(next.begin(), next.end(),
+                                         [&degree](VertexIndex a, VertexIndex b) {
+                                             return degree(a) < degree(b);
+                                         });
+                    }
+                    order.insert(order.end(), next.begin(), next.end());
+                }
+            }
+            return order;
+        }
+    }
+
+    /**
+     * @brief Orders vertices breadth first, one component at a time,
+     * starting each component from its lowest index vertex.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @return std::vector<DataStructures::Graphs::VertexIndex> The
+     * permutation.
+     */
+    template<typename T, typename U = double>
+    inline std::vector<DataStructures::Graphs::VertexIndex> breadthFirstOrder(
+        const DataStructures::Graphs::CSRGraph<T, U>& G) {
+        const auto A = DataStructures::Graphs::undirectedAdjacency(G);
+        return Detail::breadthFirst(A, false, [](auto v, const auto&) {
+            return v;
+        });
+    }
+
+    /**
+     * @brief Orders vertices by degree, with ties in index order.
+     *
+     * Descending order packs the hubs, which most traversals touch, into
+     * the first cache lines.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @param descending Whether the highest degree vertices come first.
+     * @return std::vector<DataStructures::Graphs::VertexIndex> The
+     * permutation.
+     */
+    template<typename T, typename U = double>
+    inline std::vector<DataStructures::Graphs::VertexIndex> degreeOrder(
+        const DataStructures::Graphs::CSRGraph<T, U>& G, bool descending = true) {
+        using DataStructures::Graphs::VertexIndex;
+
+        const auto A = DataStructures::Graphs::undirectedAdjacency(G);
+        std::vector<VertexIndex> order(G.getVertexCardinality());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&A, descending](VertexIndex a, VertexIndex b) {
+            const auto da = A.offsets[a + 1] - A.offsets[a];
+            const auto db = A.offsets[b + 1] - A.offsets[b];
+            return descending ? da > db : da < db;
+        });
+        return order;
+    }
+
+    /**
+     * @brief Orders vertices by the reverse Cuthill-McKee algorithm, which
+     * reduces the bandwidth of the adjacency matrix so that neighbours tend
+     * to have nearby indices.
+     *
+     * Each component is started from a pseudo-peripheral vertex, found by
+     * repeated breadth first sweeps from a minimum degree vertex.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @return std::vector<DataStructures::Graphs::VertexIndex> The
+     * permutation.
+     */
+    template<typename T, typename U = double>
+    inline std::vector<DataStructures::Graphs::VertexIndex> reverseCuthillMcKeeOrder(
+        const DataStructures::Graphs::CSRGraph<T, U>& G) {
+        using DataStructures::Graphs::VertexIndex;
+
+        const auto A = DataStructures::Graphs::undirectedAdjacency(G);
+        const auto N = G.getVertexCardinality();
+        auto degree = [&A](VertexIndex v) {
+            return A.offsets[v + 1] - A.offsets[v];
+        };
+
+        // Scratch for the level structure sweeps.
+        std::vector<size_t> level(N, 0);
+        std::vector<VertexIndex> mark(N, 0);
+        VertexIndex sweep = 0;
+        std::vector<VertexIndex> queue;
+
+        // The last level of a BFS from r, and its depth.
+        auto eccentricity = [&](VertexIndex r, const std::vector<bool>& done) {
+            sweep++;
+            queue.assign(1, r);
+            mark[r] = sweep;
+            level[r] = 0;
+            for (size_t head = 0; head < queue.size(); head++) {
+                const auto u = queue[head];
+                for (auto e = A.offsets[u]; e < A.offsets[u + 1]; e++) {
+                    const auto w = A.targets[e];
+                    if (!done[w] && mark[w] != sweep) {
+                        mark[w] = sweep;
+                        level[w] = level[u] + 1;
+                        queue.push_back(w);
+                    }
+                }
+            }
+
+            // Of the deepest vertices, prefer the lowest degree.
+            const auto depth = level[queue.back()];
+            auto best = queue.back();
+            for (auto it = queue.rbegin(); it != queue.rend() && level[*it] == depth; ++it) {
+                if (degree(*it) < degree(best)) {
+                    best = *it;
+                }
+            }
+            return std::make_pair(best, depth);
+        };
+
+        auto pseudoPeripheral = [&](VertexIndex v, const std::vector<bool>& done) {
+            // Start from a minimum degree vertex of the component.
+            eccentricity(v, done);
+            auto r = v;
+            for (const auto u : queue) {
+                if (degree(u) < degree(r)) {
+                    r = u;
+                }
+            }
+
+            // Move to the far end while that increases the eccentricity.
+            auto [far, depth] = eccentricity(r, done);
+            while (true) {
+                const auto [farther, farDepth] = eccentricity(far, done);
+                if (farDepth <= depth) {
+                    return far;
+                }
+                far = farther;
+                depth = farDepth;
+            }
+        };
+
+        auto order = Detail::breadthFirst(A, true, pseudoPeripheral);
+        std::reverse(order.begin(), order.end());
+        return order;
+    }
+
+    /**
+     * @brief Freezes `G` into a `CSRGraph` with vertices relabelled in the
+     * order given by `ordering`.
+     *
+     * `ordering` is one of the ordering functions above, and is computed over
+     * an initial freeze of `G`. The resulting graph stores each vertex at its
+     * new index, so that `vertexAt` and `indexOf` map between the new labels
+     * and the original vertex keys.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @tparam F Ordering function type.
+     * @param G The graph.
+     * @param ordering The ordering function.
+     * @return DataStructures::Graphs::CSRGraph<T, U> The relabelled graph.
+     */
+    template<typename T, typename U, typename F>
+    inline DataStructures::Graphs::CSRGraph<T, U> reorder(const DataStructures::Graphs::Graph<T, U>& G,
+                                                           F&& ordering) {
+        const DataStructures::Graphs::CSRGraph<T, U> C(G);
+        const auto order = ordering(C);
+
+        std::vector<T> keys;
+        keys.reserve(order.size());
+        for (const auto v : order) {
+            keys.push_back(C.vertexAt(v));
+        }
+        return DataStructures::Graphs::CSRGraph<T, U>(G, std::move(keys));
+    }
+}
+
+#endif
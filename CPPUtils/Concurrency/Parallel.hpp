@@ -0,0 +1,219 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_CONCURRENCY_PARALLEL
+#define CPP_UTILS_CONCURRENCY_PARALLEL
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace CPPUtils::Concurrency {
+
+    /**
+     * @brief Provides the number of worker threads to use when the caller
+     * does not specify one.
+     *
+     * @return unsigned int The hardware concurrency, or 1 if it is unknown.
+     */
+    inline unsigned int getDefaultThreadCount() {
+        const auto n = std::thread::hardware_concurrency();
+        return n == 0 ? 1 : n;
+    }
+
+    /**
+     * @brief Resolves a requested thread count, where 0 means "use the
+     * default".
+     *
+     * @param numThreads The requested number of threads.
+     * @return unsigned int The number of threads to use.
+     */
+    inline unsigned int resolveThreadCount(unsigned int numThreads) {
+        return numThreads == 0 ? getDefaultThreadCount() : numThreads;
+    }
+
+    /**
+     * @brief Provides the number of threads worth using for `n` items, at
+     * least one per `grain` items, since spawning threads for a small amount
+     * of work costs more than it saves.
+     *
+     * @param n The number of items.
+     * @param grain The fewest items worth a thread of their own.
+     * @param numThreads The most threads to use, 0 for the default.
+     * @return unsigned int The number of threads to use, at least 1.
+     */
+    inline unsigned int threadsForWork(size_t n, size_t grain, unsigned int numThreads = 0) {
+        return static_cast<unsigned int>(std::clamp<size_t>(n / grain, 1, resolveThreadCount(numThreads)));
+    }
+
+    /**
+     * @brief Invokes `f(i)` for every `i` in `[begin, end)`, splitting the
+     * range into contiguous blocks, one per thread.
+     *
+     * The calling thread processes the first block. If any invocation throws,
+     * the first exception is rethrown once all threads have joined.
+     *
+     * @tparam F Callable type, invocable with a `size_t`.
+     * @param begin First index.
+     * @param end One past the last index.
+     * @param f The body to invoke for each index.
+     * @param numThreads Number of threads to use, 0 for the default.
+     */
+    template<typename F>
+    inline void parallelFor(size_t begin, size_t end, F&& f, unsigned int numThreads = 0) {
+        if (end <= begin) {
+            return;
+        }
+
+        // Never spawn more threads than there are indices.
+        const size_t N = end - begin;
+        const size_t T = std::min<size_t>(resolveThreadCount(numThreads), N);
+        if (T == 1) {
+            for (size_t i = begin; i < end; i++) {
+                f(i);
+            }
+            return;
+        }
+
+        // Each block runs serially; exceptions are captured per block.
+        std::vector<std::exception_ptr> errors(T);
+        auto block = [&](size_t t) {
+            const size_t first = begin + (N * t) / T;
+            const size_t last = begin + (N * (t + 1)) / T;
+            try {
+                for (size_t i = first; i < last; i++) {
+                    f(i);
+                }
+            }
+            catch (...) {
+                errors[t] = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(T - 1);
+        for (size_t t = 1; t < T; t++) {
+            workers.emplace_back(block, t);
+        }
+        block(0);
+
+        for (auto& w : workers) {
+            w.join();
+        }
+
+        for (const auto& e : errors) {
+            if (e) {
+                std::rethrow_exception(e);
+            }
+        }
+    }
+
+    /**
+     * @brief Invokes `f(t, first, last)` once per thread `t`, where
+     * `[first, last)` is the contiguous block of `[begin, end)` owned by
+     * that thread.
+     *
+     * Useful when each thread keeps its own scratch state for the duration
+     * of its block.
+     *
+     * @tparam F Callable type, invocable with `(size_t, size_t, size_t)`.
+     * @param begin First index.
+     * @param end One past the last index.
+     * @param f The block body.
+     * @param numThreads Number of threads to use, 0 for the default.
+     */
+    template<typename F>
+    inline void parallelForBlocks(size_t begin, size_t end, F&& f, unsigned int numThreads = 0) {
+        if (end <= begin) {
+            return;
+        }
+
+        const size_t N = end - begin;
+        const size_t T = std::min<size_t>(resolveThreadCount(numThreads), N);
+        parallelFor(0, T, [&](size_t t) {
+            f(t, begin + (N * t) / T, begin + (N * (t + 1)) / T);
+        }, static_cast<unsigned int>(T));
+    }
+
+    /**
+     * @brief Sorts `[first, last)` in parallel.
+     *
+     * Each thread sorts one contiguous block, after which adjacent sorted
+     * runs are merged pairwise in place, halving the number of runs each
+     * round. The sort is not stable.
+     *
+     * @tparam RandomIt Random access iterator type.
+     * @tparam Compare Strict weak ordering type.
+     * @param first The beginning of the range.
+     * @param last The end of the range.
+     * @param comp The ordering.
+     * @param numThreads Number of threads to use, 0 for the default.
+     */
+    template<typename RandomIt, typename Compare = std::less<>>
+    inline void parallelSort(RandomIt first, RandomIt last, Compare comp = Compare(), unsigned int numThreads = 0) {
+        // Small inputs aren't worth the threads.
+        constexpr size_t minBlockSize = 4096;
+        const auto N = static_cast<size_t>(std::distance(first, last));
+        const size_t T = std::min<size_t>(resolveThreadCount(numThreads), std::max<size_t>(1, N / minBlockSize));
+        if (T == 1) {
+            std::sort(first, last, comp);
+            return;
+        }
+
+        std::vector<RandomIt> bounds(T + 1);
+        for (size_t t = 0; t <= T; t++) {
+            bounds[t] = first + static_cast<std::ptrdiff_t>((N * t) / T);
+        }
+
+        parallelFor(0, T, [&](size_t t) {
+            std::sort(bounds[t], bounds[t + 1], comp);
+        }, static_cast<unsigned int>(T));
+
+        for (size_t width = 1; width < T; width *= 2) {
+            const size_t pairs = (T + 2 * width - 1) / (2 * width);
+            parallelFor(0, pairs, [&](size_t p) {
+                const auto lo = p * 2 * width;
+                const auto mid = std::min(lo + width, T);
+                const auto hi = std::min(lo + 2 * width, T);
+                if (mid < hi) {
+                    std::inplace_merge(bounds[lo], bounds[mid], bounds[hi], comp);
+                }
+            }, static_cast<unsigned int>(pairs));
+        }
+    }
+}
+
+#endif
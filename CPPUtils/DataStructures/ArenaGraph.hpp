@@ -0,0 +1,220 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_DATA_STRUCTURES_ARENA_GRAPH
+#define CPP_UTILS_DATA_STRUCTURES_ARENA_GRAPH
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+#include <CPPUtils/DataStructures/Graph.hpp>
+#include <CPPUtils/DataStructures/SlabArena.hpp>
+
+namespace CPPUtils::DataStructures::Graphs {
+
+    /**
+     * @brief A mutable graph whose vertex map and adjacency lists all live in
+     * a slab arena that it owns.
+     *
+     * Adding edges grows adjacency lists within the arena, reusing blocks
+     * freed by earlier growth, so bulk loading makes few calls to the system
+     * allocator. When the vertex and weight types are trivially destructible,
+     * destruction skips walking the graph and releases the arena's slabs in
+     * one go.
+     *
+     * The graph itself, a `Graph<T, U, Allocator>`, is accessed via `get`,
+     * `*` or `->`. It can be passed to the path finding functions and to
+     * `CSRGraph`'s constructor; for anything else that takes a `Graph<T, U>`,
+     * convert it with `Graph<T, U>(*G)`. Copies of it allocate from the
+     * default resource, so they may outlive the `ArenaGraph`.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Edge type.
+     */
+    template<typename T, typename U = double>
+    class ArenaGraph final {
+    public:
+        /**
+         * @brief The allocator of the graph, drawing on the arena.
+         *
+         */
+        using Allocator = std::pmr::polymorphic_allocator<std::byte>;
+
+        /**
+         * @brief The type of the graph.
+         *
+         */
+        using GraphType = Graph<T, U, Allocator>;
+
+    private:
+        using DirectedGraphType = DirectedGraph<T, U, Allocator>;
+
+        static constexpr bool triviallyDestructible =
+            std::is_trivially_destructible_v<T> && std::is_trivially_destructible_v<U>;
+
+        std::unique_ptr<Arenas::SlabArena> arena;
+        GraphType* graph;
+        bool directed;
+
+        void destroy() {
+            if (graph == nullptr) {
+                return;
+            }
+
+            // With trivial vertex and weight types the graph holds nothing
+            // but arena memory, so its destructor can be skipped entirely.
+            if constexpr (!triviallyDestructible) {
+                if (directed) {
+                    static_cast<DirectedGraphType*>(graph)->~DirectedGraphType();
+                } else {
+                    graph->~Graph();
+                }
+            }
+
+            graph = nullptr;
+            arena->release();
+        }
+
+        void create() {
+            // The graph object lives in the arena alongside its storage.
+            if (directed) {
+                void* p = arena->allocate(sizeof(DirectedGraphType), alignof(DirectedGraphType));
+                graph = new (p) DirectedGraphType(arena.get());
+            } else {
+                void* p = arena->allocate(sizeof(GraphType), alignof(GraphType));
+                graph = new (p) GraphType(arena.get());
+            }
+        }
+
+    public:
+        /**
+         * @brief Construct a new, empty Arena Graph object.
+         *
+         * @param directed Whether the graph is directed.
+         * @param slabSize The size of each arena slab.
+         */
+        explicit ArenaGraph(bool directed = false,
+                            size_t slabSize = Arenas::SlabArena::defaultSlabSize) :
+            arena(std::make_unique<Arenas::SlabArena>(slabSize)),
+            graph(nullptr),
+            directed(directed) {
+            create();
+        }
+
+        ArenaGraph(const ArenaGraph&) = delete;
+        ArenaGraph& operator=(const ArenaGraph&) = delete;
+
+        ArenaGraph(ArenaGraph&& other) noexcept :
+            arena(std::move(other.arena)),
+            graph(other.graph),
+            directed(other.directed) {
+            other.graph = nullptr;
+        }
+
+        ArenaGraph& operator=(ArenaGraph&& other) noexcept {
+            if (this != &other) {
+                if (arena) {
+                    destroy();
+                }
+                arena = std::move(other.arena);
+                graph = other.graph;
+                directed = other.directed;
+                other.graph = nullptr;
+            }
+            return *this;
+        }
+
+        ~ArenaGraph() {
+            if (arena) {
+                destroy();
+            }
+        }
+
+        /**
+         * @brief Provides the graph.
+         *
+         * @return GraphType& The graph.
+         */
+        GraphType& get() {
+            return *graph;
+        }
+
+        /**
+         * @brief Provides the graph.
+         *
+         * @return const GraphType& The graph.
+         */
+        const GraphType& get() const {
+            return *graph;
+        }
+
+        GraphType& operator*() {
+            return *graph;
+        }
+
+        const GraphType& operator*() const {
+            return *graph;
+        }
+
+        GraphType* operator->() {
+            return graph;
+        }
+
+        const GraphType* operator->() const {
+            return graph;
+        }
+
+        /**
+         * @brief Discards every vertex and edge, returning the arena's memory
+         * to the system.
+         *
+         */
+        void clear() {
+            destroy();
+            create();
+        }
+
+        /**
+         * @brief Provides the arena that the graph allocates from.
+         *
+         * @return const Arenas::SlabArena& The arena.
+         */
+        const Arenas::SlabArena& getArena() const {
+            return *arena;
+        }
+    };
+}
+
+#endif
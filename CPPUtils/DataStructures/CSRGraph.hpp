@@ -0,0 +1,732 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_DATA_STRUCTURES_CSR_GRAPH
+#define CPP_UTILS_DATA_STRUCTURES_CSR_GRAPH
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <CPPUtils/Concurrency/Parallel.hpp>
+#include <CPPUtils/DataStructures/Graph.hpp>
+
+namespace CPPUtils::DataStructures::Graphs {
+
+    /**
+     * @brief Dense index of a vertex in a `CSRGraph`.
+     *
+     */
+    using VertexIndex = std::uint32_t;
+
+    /**
+     * @brief Index of an edge in the flat edge arrays of a `CSRGraph`.
+     *
+     */
+    using EdgeIndex = std::uint64_t;
+
+    /**
+     * @brief A frozen, compressed sparse row (CSR) form of a `Graph`.
+     *
+     * Vertices are given dense indices `[0, V)`, in the order of the vertex
+     * key table. The outward edges of vertex `v` occupy the range
+     * `[offsets[v], offsets[v + 1])` of the flat `targets` and `weights`
+     * arrays, sorted by target index. For undirected graphs each edge is
+     * stored once in each direction, exactly as in `Graph`.
+     *
+     * The topology is immutable, but the weights may be overwritten in place.
+     * The arrays are either owned by this object, or are views over an
+     * externally owned block of memory such as a memory mapped file; in both
+     * cases the owner is kept alive by `backing`.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     */
+    template<typename T, typename U = double>
+    class CSRGraph {
+    public:
+        /**
+         * @brief The edge type that forms a connection in a graph.
+         *
+         */
+        using EdgeType = OutwardEdge<T, U>;
+
+        /**
+         * @brief The vertex type of the graph.
+         *
+         */
+        using VertexType = T;
+
+        /**
+         * @brief The weight type of the graph.
+         *
+         */
+        using WeightType = U;
+
+        /**
+         * @brief Marker returned by `indexOf` for unknown vertices.
+         *
+         */
+        static constexpr VertexIndex invalidVertex = (std::numeric_limits<VertexIndex>::max)();
+
+        /**
+         * @brief Marker returned by `findEdge` for absent edges.
+         *
+         */
+        static constexpr EdgeIndex invalidEdge = (std::numeric_limits<EdgeIndex>::max)();
+
+    protected:
+        // Owned storage, for graphs not backed by external memory.
+        struct Storage final {
+            std::vector<T> keys;
+            std::vector<EdgeIndex> offsets;
+            std::vector<VertexIndex> targets;
+            std::vector<U> weights;
+        };
+
+        // Lazily built key to index lookup table.
+        struct KeyIndex final {
+            std::once_flag built;
+            std::unordered_map<T, VertexIndex> lookup;
+        };
+
+        bool directed;
+
+        std::span<const T> keys;
+        std::span<const EdgeIndex> offsets;
+        std::span<const VertexIndex> targets;
+        std::span<U> weights;
+
+        // Keeps the memory behind the spans alive.
+        std::shared_ptr<void> backing;
+
+        mutable std::unique_ptr<KeyIndex> keyIndex;
+
+        const std::unordered_map<T, VertexIndex>& getKeyIndex() const {
+            std::call_once(keyIndex->built, [this]() {
+                auto& lookup = keyIndex->lookup;
+                lookup.reserve(keys.size());
+                for (size_t i = 0; i < keys.size(); i++) {
+                    lookup.emplace(keys[i], static_cast<VertexIndex>(i));
+                }
+            });
+            return keyIndex->lookup;
+        }
+
+        template<typename A>
+        void build(const Graph<T, U, A>& G, std::vector<T> order, unsigned int numThreads) {
+            const auto N = order.size();
+            if (N != G.getVertexCardinality()) {
+                throw std::invalid_argument("Vertex order must contain every vertex exactly once.");
+            }
+            if (N >= static_cast<size_t>(invalidVertex)) {
+                throw std::length_error("Too many vertices for a CSRGraph.");
+            }
+
+            auto storage = std::make_shared<Storage>();
+            storage->keys = std::move(order);
+
+            // Index the vertex keys up front, as construction needs them.
+            std::call_once(keyIndex->built, [&]() {
+                auto& lookup = keyIndex->lookup;
+                lookup.reserve(N);
+                for (size_t i = 0; i < N; i++) {
+                    if (!lookup.emplace(storage->keys[i], static_cast<VertexIndex>(i)).second) {
+                        throw std::invalid_argument("Vertex order contains duplicates.");
+                    }
+                }
+            });
+            const auto& lookup = keyIndex->lookup;
+
+            // Row offsets are the prefix sum of the out degrees.
+            storage->offsets.resize(N + 1, 0);
+            for (size_t i = 0; i < N; i++) {
+                const auto& adj = G.getAdjacencyList(storage->keys[i]);
+                storage->offsets[i + 1] = storage->offsets[i] + adj.size();
+            }
+
+            const auto E = storage->offsets[N];
+            storage->targets.resize(E);
+            storage->weights.resize(E);
+
+            // Rows are independent, so fill and sort them in parallel.
+            Concurrency::parallelForBlocks(0, N, [&](size_t, size_t first, size_t last) {
+                std::vector<std::pair<VertexIndex, U>> row;
+                for (size_t i = first; i < last; i++) {
+                    row.clear();
+                    for (const auto& e : G.getAdjacencyList(storage->keys[i])) {
+                        row.emplace_back(lookup.at(e.getVertex()), e.getWeight());
+                    }
+                    std::stable_sort(row.begin(), row.end(),
+                                     [](const auto& a, const auto& b) {
+                                         return a.first < b.first;
+                                     });
+
+                    auto pos = storage->offsets[i];
+                    for (const auto& [v, w] : row) {
+                        storage->targets[pos] = v;
+                        storage->weights[pos] = w;
+                        pos++;
+                    }
+                }
+            }, numThreads);
+
+            keys = storage->keys;
+            offsets = storage->offsets;
+            targets = storage->targets;
+            weights = storage->weights;
+            backing = std::move(storage);
+        }
+
+    public:
+        /**
+         * @brief Construct a new, empty CSRGraph object.
+         *
+         */
+        CSRGraph() :
+            directed(false),
+            offsets(emptyOffsets()),
+            keyIndex(std::make_unique<KeyIndex>()) {
+            //
+        }
+
+        /**
+         * @brief Construct a new CSRGraph object by freezing `G`.
+         *
+         * Vertices are indexed in the order given by `G.getVertices()`.
+         *
+         * @tparam A Allocator type of `G`.
+         * @param G The graph to freeze.
+         * @param numThreads The number of threads to use, 0 for the default.
+         */
+        template<typename A>
+        explicit CSRGraph(const Graph<T, U, A>& G, unsigned int numThreads = 0) :
+            directed(G.isDirected()),
+            keyIndex(std::make_unique<KeyIndex>()) {
+            build(G, G.getVertices(), numThreads);
+        }
+
+        /**
+         * @brief Construct a new CSRGraph object by freezing `G`, with
+         * vertices indexed in the order given by `order`.
+         *
+         * @tparam A Allocator type of `G`.
+         * @param G The graph to freeze.
+         * @param order Every vertex of `G`, exactly once.
+         * @param numThreads The number of threads to use, 0 for the default.
+         */
+        template<typename A>
+        CSRGraph(const Graph<T, U, A>& G, std::vector<T> order, unsigned int numThreads = 0) :
+            directed(G.isDirected()),
+            keyIndex(std::make_unique<KeyIndex>()) {
+            build(G, std::move(order), numThreads);
+        }
+
+        /**
+         * @brief Construct a new CSRGraph object that takes ownership of
+         * prebuilt CSR arrays.
+         *
+         * `offsets` must contain `keys.size() + 1` entries, and each row
+         * must be sorted by target.
+         *
+         * @param directed Whether the graph is directed.
+         * @param keys The vertex key table.
+         * @param offsets The row offsets.
+         * @param targets The target vertex index of each edge.
+         * @param weights The weight of each edge.
+         */
+        CSRGraph(bool directed,
+                 std::vector<T> keys,
+                 std::vector<EdgeIndex> offsets,
+                 std::vector<VertexIndex> targets,
+                 std::vector<U> weights) :
+            directed(directed),
+            keyIndex(std::make_unique<KeyIndex>()) {
+            if (offsets.size() != keys.size() + 1 ||
+                offsets.back() != targets.size() ||
+                targets.size() != weights.size()) {
+                throw std::invalid_argument("Inconsistent CSR array sizes.");
+            }
+
+            auto storage = std::make_shared<Storage>(
+                Storage{ std::move(keys), std::move(offsets), std::move(targets), std::move(weights) });
+            this->keys = storage->keys;
+            this->offsets = storage->offsets;
+            this->targets = storage->targets;
+            this->weights = storage->weights;
+            backing = std::move(storage);
+        }
+
+        /**
+         * @brief Construct a new CSRGraph object as a view over existing CSR
+         * arrays.
+         *
+         * No copies are made; `backing` must own the memory that the spans
+         * refer to. `offsets` must contain `keys.size() + 1` entries.
+         *
+         * @param directed Whether the graph is directed.
+         * @param keys The vertex key table.
+         * @param offsets The row offsets.
+         * @param targets The target vertex index of each edge.
+         * @param weights The weight of each edge.
+         * @param backing Owner of the memory behind the spans.
+         */
+        CSRGraph(bool directed,
+                 std::span<const T> keys,
+                 std::span<const EdgeIndex> offsets,
+                 std::span<const VertexIndex> targets,
+                 std::span<U> weights,
+                 std::shared_ptr<void> backing) :
+            directed(directed),
+            keys(keys),
+            offsets(offsets),
+            targets(targets),
+            weights(weights),
+            backing(std::move(backing)),
+            keyIndex(std::make_unique<KeyIndex>()) {
+            if (offsets.size() != keys.size() + 1 ||
+                offsets.back() != targets.size() ||
+                targets.size() != weights.size()) {
+                throw std::invalid_argument("Inconsistent CSR array sizes.");
+            }
+        }
+
+        CSRGraph(const CSRGraph&) = delete;
+        CSRGraph& operator=(const CSRGraph&) = delete;
+        CSRGraph(CSRGraph&&) noexcept = default;
+        CSRGraph& operator=(CSRGraph&&) noexcept = default;
+
+        virtual ~CSRGraph() {
+            //
+        }
+
+        /**
+         * @brief Determines if the graph is directed.
+         *
+         * @return true If the graph is directed.
+         * @return false If the graph is undirected.
+         */
+        bool isDirected() const {
+            return directed;
+        }
+
+        /**
+         * @brief Provides the vertex set cardinality of the graph.
+         *
+         * @return size_t The number of vertices in the graph.
+         */
+        size_t getVertexCardinality() const {
+            return keys.size();
+        }
+
+        /**
+         * @brief Provides the number of stored (outward) edges.
+         *
+         * For undirected graphs each edge is counted once per direction.
+         *
+         * @return size_t The number of entries in the edge arrays.
+         */
+        size_t getEdgeCardinality() const {
+            return targets.size();
+        }
+
+        /**
+         * @brief Determines if the vertex `a` exists in the graph.
+         *
+         * @param a The query vertex.
+         * @return true If `a` is a vertex in the graph.
+         * @return false If `a` is not a vertex in the graph.
+         */
+        bool vertexExists(const T& a) const {
+            return indexOf(a) != invalidVertex;
+        }
+
+        /**
+         * @brief Provides the dense index of vertex `a`.
+         *
+         * The key lookup table is built on first use.
+         *
+         * @param a The query vertex.
+         * @return VertexIndex The index of `a`, or `invalidVertex`.
+         */
+        VertexIndex indexOf(const T& a) const {
+            const auto& lookup = getKeyIndex();
+            const auto it = lookup.find(a);
+            return it == lookup.end() ? invalidVertex : it->second;
+        }
+
+        /**
+         * @brief Provides the key of the vertex with index `v`.
+         *
+         * @param v The vertex index.
+         * @return const T& The vertex key.
+         */
+        const T& vertexAt(VertexIndex v) const {
+            return keys[v];
+        }
+
+        /**
+         * @brief Provides the vertex key table, in index order.
+         *
+         * @return std::span<const T> The vertex keys.
+         */
+        std::span<const T> getVertices() const {
+            return keys;
+        }
+
+        /**
+         * @brief Provides the out degree of vertex `v`.
+         *
+         * @param v The vertex index.
+         * @return size_t The number of outward edges of `v`.
+         */
+        size_t degree(VertexIndex v) const {
+            return static_cast<size_t>(offsets[v + 1] - offsets[v]);
+        }
+
+        /**
+         * @brief Provides the target indices of the outward edges of `v`,
+         * in ascending order.
+         *
+         * @param v The vertex index.
+         * @return std::span<const VertexIndex> The neighbours of `v`.
+         */
+        std::span<const VertexIndex> neighbours(VertexIndex v) const {
+            return targets.subspan(offsets[v], degree(v));
+        }
+
+        /**
+         * @brief Provides the weights of the outward edges of `v`, aligned
+         * with `neighbours(v)`.
+         *
+         * @param v The vertex index.
+         * @return std::span<const U> The edge weights of `v`.
+         */
+        std::span<const U> neighbourWeights(VertexIndex v) const {
+            return std::span<const U>(weights).subspan(offsets[v], degree(v));
+        }
+
+        /**
+         * @brief Finds the first edge from `a` to `b`, by binary search of
+         * the row of `a`.
+         *
+         * @param a The source vertex index.
+         * @param b The target vertex index.
+         * @return EdgeIndex The position of the edge in the edge arrays, or
+         * `invalidEdge`.
+         */
+        EdgeIndex findEdge(VertexIndex a, VertexIndex b) const {
+            const auto row = neighbours(a);
+            const auto it = std::lower_bound(row.begin(), row.end(), b);
+            if (it == row.end() || *it != b) {
+                return invalidEdge;
+            }
+            return offsets[a] + static_cast<EdgeIndex>(it - row.begin());
+        }
+
+        /**
+         * @brief Overwrites the weight of the edge from `a` to `b`.
+         *
+         * If the graph is undirected, the edge from `b` to `a` is also
+         * updated. If there are several edges from `a` to `b`, all of them are
+         * updated. The topology is untouched.
+         *
+         * @param a The source vertex index.
+         * @param b The target vertex index.
+         * @param weight The new weight of the edge.
+         * @return true If the edge exists and was updated.
+         * @return false If there is no such edge.
+         */
+        bool setEdgeWeight(VertexIndex a, VertexIndex b, U weight) {
+            auto overwrite = [this, weight](VertexIndex x, VertexIndex y) {
+                auto e = findEdge(x, y);
+                if (e == invalidEdge) {
+                    return false;
+                }
+                for (const auto end = offsets[x + 1]; e < end && targets[e] == y; e++) {
+                    weights[e] = weight;
+                }
+                return true;
+            };
+
+            if (!overwrite(a, b)) {
+                return false;
+            }
+            if (!directed) {
+                overwrite(b, a);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Overwrites the weight of the edge from `a` to `b`.
+         *
+         * @param a The source vertex.
+         * @param b The target vertex.
+         * @param weight The new weight of the edge.
+         * @return true If the edge exists and was updated.
+         * @return false If there is no such edge.
+         */
+        bool setEdgeWeight(const T& a, const T& b, U weight) {
+            const auto i = indexOf(a);
+            const auto j = indexOf(b);
+            if (i == invalidVertex || j == invalidVertex) {
+                return false;
+            }
+            return setEdgeWeight(i, j, weight);
+        }
+
+        /**
+         * @brief Applies a batch of edge weight updates, in order.
+         *
+         * Updates for edges that do not exist are skipped.
+         *
+         * @param updates The edges to update, with their new weights.
+         * @return size_t The number of updates that were applied.
+         */
+        size_t setEdgeWeights(std::span<const WeightedEdge<T, U>> updates) {
+            size_t n = 0;
+            for (const auto& e : updates) {
+                n += setEdgeWeight(e.source, e.target, e.weight) ? 1 : 0;
+            }
+            return n;
+        }
+
+        /**
+         * @brief Provides the row offsets, of length `V + 1`.
+         *
+         * @return std::span<const EdgeIndex> The row offsets.
+         */
+        std::span<const EdgeIndex> getOffsets() const {
+            return offsets;
+        }
+
+        /**
+         * @brief Provides the flat array of edge targets.
+         *
+         * @return std::span<const VertexIndex> The edge targets.
+         */
+        std::span<const VertexIndex> getTargets() const {
+            return targets;
+        }
+
+        /**
+         * @brief Provides the flat array of edge weights.
+         *
+         * @return std::span<const U> The edge weights.
+         */
+        std::span<const U> getWeights() const {
+            return weights;
+        }
+
+        /**
+         * @brief Provides mutable access to the flat array of edge weights,
+         * for bulk overwrites.
+         *
+         * For undirected graphs, callers are responsible for keeping the
+         * weights of both directions of an edge consistent.
+         *
+         * @return std::span<U> The edge weights.
+         */
+        std::span<U> getWeights() {
+            return weights;
+        }
+
+    private:
+        static std::span<const EdgeIndex> emptyOffsets() {
+            static const EdgeIndex zero = 0;
+            return { &zero, 1 };
+        }
+    };
+
+    /**
+     * @brief The neighbours of each vertex of a `CSRGraph` with edge
+     * direction ignored, as CSR arrays.
+     *
+     */
+    struct UndirectedAdjacency final {
+        std::vector<EdgeIndex> offsets;
+        std::vector<VertexIndex> targets;
+    };
+
+    /**
+     * @brief Provides the neighbours of each vertex of `G`, ignoring edge
+     * direction.
+     *
+     * For directed graphs each edge is listed at both of its endpoints. For
+     * undirected graphs this is a copy of the existing arrays.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @return UndirectedAdjacency The symmetric neighbour lists.
+     */
+    template<typename T, typename U>
+    inline UndirectedAdjacency undirectedAdjacency(const CSRGraph<T, U>& G) {
+        const auto offsets = G.getOffsets();
+        const auto targets = G.getTargets();
+        if (!G.isDirected()) {
+            return { { offsets.begin(), offsets.end() }, { targets.begin(), targets.end() } };
+        }
+
+        const auto N = G.getVertexCardinality();
+        UndirectedAdjacency A;
+        A.offsets.assign(N + 1, 0);
+        for (size_t v = 0; v < N; v++) {
+            A.offsets[v + 1] += G.degree(static_cast<VertexIndex>(v));
+            for (const auto u : G.neighbours(static_cast<VertexIndex>(v))) {
+                A.offsets[u + 1]++;
+            }
+        }
+        for (size_t v = 0; v < N; v++) {
+            A.offsets[v + 1] += A.offsets[v];
+        }
+
+        A.targets.resize(A.offsets[N]);
+        std::vector<EdgeIndex> cursor(A.offsets.begin(), A.offsets.end() - 1);
+        for (size_t v = 0; v < N; v++) {
+            for (const auto u : G.neighbours(static_cast<VertexIndex>(v))) {
+                A.targets[cursor[v]++] = u;
+                A.targets[cursor[u]++] = static_cast<VertexIndex>(v);
+            }
+        }
+        return A;
+    }
+
+    /**
+     * @brief Provides the neighbours of each vertex of `G` as a simple
+     * undirected graph.
+     *
+     * Like `undirectedAdjacency`, but each row is sorted, with duplicates
+     * and self loops removed.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @param numThreads The number of threads to use, 0 for the default.
+     * @return UndirectedAdjacency The simple neighbour lists.
+     */
+    template<typename T, typename U>
+    inline UndirectedAdjacency simpleUndirectedAdjacency(const CSRGraph<T, U>& G,
+                                                         unsigned int numThreads = 0) {
+        auto A = undirectedAdjacency(G);
+        const auto N = G.getVertexCardinality();
+
+        // Clean each row in place, recording its new length.
+        std::vector<EdgeIndex> lengths(N + 1, 0);
+        Concurrency::parallelFor(0, N, [&](size_t v) {
+            const auto first = A.targets.begin() + A.offsets[v];
+            auto last = A.targets.begin() + A.offsets[v + 1];
+            if (G.isDirected()) {
+                std::sort(first, last);
+            }
+            last = std::unique(first, last);
+            last = std::remove(first, last, static_cast<VertexIndex>(v));
+            lengths[v + 1] = static_cast<EdgeIndex>(last - first);
+        }, numThreads);
+
+        for (size_t v = 0; v < N; v++) {
+            lengths[v + 1] += lengths[v];
+        }
+
+        // Compact the rows.
+        std::vector<VertexIndex> targets(lengths[N]);
+        Concurrency::parallelFor(0, N, [&](size_t v) {
+            std::copy_n(A.targets.begin() + A.offsets[v], lengths[v + 1] - lengths[v],
+                        targets.begin() + lengths[v]);
+        }, numThreads);
+
+        return { std::move(lengths), std::move(targets) };
+    }
+
+    /**
+     * @brief Provides `G` with every edge reversed.
+     *
+     * Vertex indices are preserved, so the reverse graph can be searched
+     * alongside `G`. Undirected graphs are copied unchanged.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     * @param G The graph.
+     * @return CSRGraph<T, U> The transposed graph.
+     */
+    template<typename T, typename U>
+    inline CSRGraph<T, U> transpose(const CSRGraph<T, U>& G) {
+        const auto N = G.getVertexCardinality();
+        const auto keys = G.getVertices();
+        const auto offsets = G.getOffsets();
+        const auto targets = G.getTargets();
+        const auto weights = G.getWeights();
+
+        std::vector<EdgeIndex> reverseOffsets(N + 1, 0);
+        std::vector<VertexIndex> reverseTargets(targets.size());
+        std::vector<U> reverseWeights(weights.size());
+        if (!G.isDirected()) {
+            std::copy(offsets.begin(), offsets.end(), reverseOffsets.begin());
+            std::copy(targets.begin(), targets.end(), reverseTargets.begin());
+            std::copy(weights.begin(), weights.end(), reverseWeights.begin());
+        } else {
+            // Counting sort by target; sources are visited in order, so each
+            // reversed row comes out sorted.
+            for (const auto u : targets) {
+                reverseOffsets[u + 1]++;
+            }
+            for (size_t v = 0; v < N; v++) {
+                reverseOffsets[v + 1] += reverseOffsets[v];
+            }
+
+            std::vector<EdgeIndex> cursor(reverseOffsets.begin(), reverseOffsets.end() - 1);
+            for (size_t v = 0; v < N; v++) {
+                for (auto e = offsets[v]; e < offsets[v + 1]; e++) {
+                    const auto slot = cursor[targets[e]]++;
+                    reverseTargets[slot] = static_cast<VertexIndex>(v);
+                    reverseWeights[slot] = weights[e];
+                }
+            }
+        }
+
+        return CSRGraph<T, U>(G.isDirected(),
+                              std::vector<T>(keys.begin(), keys.end()),
+                              std::move(reverseOffsets),
+                              std::move(reverseTargets),
+                              std::move(reverseWeights));
+    }
+}
+
+#endif
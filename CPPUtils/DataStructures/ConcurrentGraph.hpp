@@ -0,0 +1,502 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_DATA_STRUCTURES_CONCURRENT_GRAPH
+#define CPP_UTILS_DATA_STRUCTURES_CONCURRENT_GRAPH
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <CPPUtils/DataStructures/Graph.hpp>
+#include <CPPUtils/DataStructures/GraphMutationLog.hpp>
+
+namespace CPPUtils::DataStructures::Graphs {
+
+    /**
+     * @brief An ordered batch of mutations to apply to a graph.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     */
+    template<typename T, typename U = double>
+    class GraphUpdateBatch {
+    public:
+        /**
+         * @brief The kind of a recorded mutation.
+         *
+         */
+        enum class Operation : short {
+            ADD_VERTEX,
+            REMOVE_VERTEX,
+            ADD_EDGE,
+            REMOVE_EDGE,
+            SET_EDGE_WEIGHT
+        };
+
+        /**
+         * @brief A single recorded mutation. Unused fields are value
+         * initialised.
+         *
+         */
+        struct Mutation final {
+            Operation operation;
+            T a;
+            T b;
+            U weight;
+        };
+
+    protected:
+        std::vector<Mutation> mutations;
+
+    public:
+        /**
+         * @brief Records the addition of vertex `a`.
+         *
+         * @param a The vertex to add.
+         */
+        void addVertex(const T& a) {
+            mutations.push_back({ Operation::ADD_VERTEX, a, T(), U() });
+        }
+
+        /**
+         * @brief Records the removal of vertex `a`.
+         *
+         * @param a The vertex to remove.
+         */
+        void removeVertex(const T& a) {
+            mutations.push_back({ Operation::REMOVE_VERTEX, a, T(), U() });
+        }
+
+        /**
+         * @brief Records the addition of an edge from `a` to `b`.
+         *
+         * @param a The source vertex.
+         * @param b The sink vertex.
+         * @param weight The weight of the edge.
+         */
+        void addEdge(const T& a, const T& b, U weight) {
+            mutations.push_back({ Operation::ADD_EDGE, a, b, weight });
+        }
+
+        /**
+         * @brief Records the removal of the edge from `a` to `b`.
+         *
+         * @param a The source vertex.
+         * @param b The sink vertex.
+         */
+        void removeEdge(const T& a, const T& b) {
+            mutations.push_back({ Operation::REMOVE_EDGE, a, b, U() });
+        }
+
+        /**
+         * @brief Records an in place update of the weight of the edge from
+         * `a` to `b`.
+         *
+         * @param a The source vertex.
+         * @param b The sink vertex.
+         * @param weight The new weight of the edge.
+         */
+        void setEdgeWeight(const T& a, const T& b, U weight) {
+            mutations.push_back({ Operation::SET_EDGE_WEIGHT, a, b, weight });
+        }
+
+        /**
+         * @brief Provides the recorded mutations, in order.
+         *
+         * @return const std::vector<Mutation>& The mutations.
+         */
+        const std::vector<Mutation>& getMutations() const {
+            return mutations;
+        }
+
+        /**
+         * @brief Provides the number of recorded mutations.
+         *
+         * @return size_t The mutation count.
+         */
+        size_t size() const {
+            return mutations.size();
+        }
+
+        /**
+         * @brief Determines if the batch records no mutations.
+         *
+         * @return true If the batch is empty.
+         * @return false Otherwise.
+         */
+        bool empty() const {
+            return mutations.empty();
+        }
+
+        /**
+         * @brief Discards all recorded mutations.
+         *
+         */
+        void clear() {
+            mutations.clear();
+        }
+
+        /**
+         * @brief Applies the recorded mutations to `G`, in order.
+         *
+         * @param G The graph to mutate.
+         */
+        void applyTo(Graph<T, U>& G) const {
+            for (const auto& m : mutations) {
+                switch (m.operation) {
+                case Operation::ADD_VERTEX:
+                    G.addVertex(m.a);
+                    break;
+                case Operation::REMOVE_VERTEX:
+                    G.removeVertex(m.a);
+                    break;
+                case Operation::ADD_EDGE:
+                    G.addEdge(m.a, m.b, m.weight);
+                    break;
+                case Operation::REMOVE_EDGE:
+                    G.removeEdge(m.a, m.b);
+                    break;
+                case Operation::SET_EDGE_WEIGHT:
+                    G.setEdgeWeight(m.a, m.b, m.weight);
+                    break;
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief A read-mostly graph, where readers work on immutable snapshots.
+     *
+     * Each published version of the graph is immutable. Readers take a
+     * snapshot of the current version and may then run any number of
+     * queries on it without further synchronisation, regardless of
+     * concurrent writers. Writers are serialised; each applies a batch of
+     * mutations to a private copy of the current version and then publishes
+     * the copy atomically (read-copy-update).
+     *
+     * Snapshots are protected by hazard pointers. A reader announces the
+     * version it holds in a reader slot of its own, on its own cache line,
+     * so taking and releasing a snapshot is lock-free and readers never
+     * write to shared memory. Slots are added in blocks as more snapshots
+     * are held at once. A replaced version is retired, and freed by a later
+     * update once no slot announces it.
+     *
+     * As each write copies the graph, updates should be batched. Snapshots
+     * must not outlive the concurrent graph.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     */
+    template<typename T, typename U = double>
+    class ConcurrentGraph {
+    protected:
+        struct Version final {
+            std::uint64_t number;
+            Graph<T, U> graph;
+        };
+
+        struct alignas(64) ReaderSlot final {
+            std::atomic<const Version*> hazard{ nullptr };
+        };
+
+        static constexpr size_t slotsPerBlock = 32;
+
+        struct SlotBlock final {
+            ReaderSlot slots[slotsPerBlock];
+            SlotBlock* next = nullptr;
+        };
+
+    public:
+        /**
+         * @brief An immutable snapshot of one version of the graph.
+         *
+         * The snapshot remains valid, and unchanged, for as long as it is
+         * held.
+         *
+         */
+        class Snapshot {
+        protected:
+            friend class ConcurrentGraph;
+
+            ReaderSlot* slot;
+            const Version* version;
+
+            Snapshot(ReaderSlot* slot, const Version* version) : slot(slot), version(version) {
+                //
+            }
+
+            void release() {
+                if (slot != nullptr) {
+                    slot->hazard.store(nullptr, std::memory_order_release);
+                    slot = nullptr;
+                    version = nullptr;
+                }
+            }
+
+        public:
+            Snapshot(Snapshot&& other) noexcept : slot(other.slot), version(other.version) {
+                other.slot = nullptr;
+                other.version = nullptr;
+            }
+
+            Snapshot& operator=(Snapshot&& other) noexcept {
+                if (this != &other) {
+                    release();
+                    std::swap(slot, other.slot);
+                    std::swap(version, other.version);
+                }
+                return *this;
+            }
+
+            Snapshot(const Snapshot&) = delete;
+            Snapshot& operator=(const Snapshot&) = delete;
+
+            ~Snapshot() {
+                release();
+            }
+
+            const Graph<T, U>& operator*() const {
+                return version->graph;
+            }
+
+            const Graph<T, U>* operator->() const {
+                return &version->graph;
+            }
+
+            const Graph<T, U>* get() const {
+                return version == nullptr ? nullptr : &version->graph;
+            }
+
+            /**
+             * @brief Provides the number of the version held.
+             *
+             * @return std::uint64_t The version number.
+             */
+            std::uint64_t getVersion() const {
+                return version->number;
+            }
+        };
+
+    protected:
+        std::atomic<const Version*> current;
+        std::atomic<std::uint64_t> currentNumber;
+        mutable std::atomic<SlotBlock*> slotBlocks;
+
+        // Replaced versions awaiting reclamation; writers only.
+        std::vector<const Version*> retired;
+
+        // Serialises writers; never taken by readers.
+        std::mutex writerMutex;
+
+        // Claims a free reader slot, announcing `v` in it.
+        ReaderSlot* claimSlot(const Version* v) const {
+            // Start each thread at its own slot so readers do not contend.
+            static thread_local const size_t start = std::hash<std::thread::id>()(std::this_thread::get_id());
+
+            auto* head = slotBlocks.load(std::memory_order_acquire);
+            for (auto* block = head; block != nullptr; block = block->next) {
+                for (size_t i = 0; i < slotsPerBlock; i++) {
+                    auto& slot = block->slots[(start + i) % slotsPerBlock];
+                    const Version* expected = nullptr;
+                    if (slot.hazard.load(std::memory_order_relaxed) == nullptr &&
+                        slot.hazard.compare_exchange_strong(expected, v, std::memory_order_seq_cst)) {
+                        return &slot;
+                    }
+                }
+            }
+
+            // Every slot is taken; add a block, with its first slot claimed.
+            auto* block = new SlotBlock();
+            block->slots[0].hazard.store(v, std::memory_order_relaxed);
+            block->next = head;
+            while (!slotBlocks.compare_exchange_weak(block->next, block,
+                                                     std::memory_order_release,
+                                                     std::memory_order_acquire)) {
+                //
+            }
+            return &block->slots[0];
+        }
+
+        bool isHeld(const Version* v) const {
+            for (auto* block = slotBlocks.load(std::memory_order_acquire); block != nullptr; block = block->next) {
+                for (const auto& slot : block->slots) {
+                    if (slot.hazard.load(std::memory_order_seq_cst) == v) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        // Frees retired versions that no reader announces.
+        void reclaim() {
+            retired.erase(std::remove_if(retired.begin(), retired.end(), [this](const Version* v) {
+                if (isHeld(v)) {
+                    return false;
+                }
+                delete v;
+                return true;
+            }), retired.end());
+        }
+
+        std::uint64_t publish(Graph<T, U>&& G, std::uint64_t number) {
+            const auto* next = new Version{ number, std::move(G) };
+            const auto* previous = current.exchange(next, std::memory_order_seq_cst);
+            currentNumber.store(number, std::memory_order_release);
+            if (previous != nullptr) {
+                retired.push_back(previous);
+            }
+            reclaim();
+            return number;
+        }
+
+    public:
+        /**
+         * @brief Construct a new Concurrent Graph object, whose initial
+         * version (version 0) is `initial`.
+         *
+         * Passing a `DirectedGraph` gives a directed concurrent graph.
+         *
+         * @param initial The initial graph.
+         */
+        explicit ConcurrentGraph(Graph<T, U> initial = Graph<T, U>()) :
+            current(nullptr),
+            currentNumber(0),
+            slotBlocks(new SlotBlock()) {
+            publish(std::move(initial), 0);
+        }
+
+        ConcurrentGraph(const ConcurrentGraph&) = delete;
+        ConcurrentGraph& operator=(const ConcurrentGraph&) = delete;
+
+        virtual ~ConcurrentGraph() {
+            delete current.load();
+            for (const auto* v : retired) {
+                delete v;
+            }
+            for (auto* block = slotBlocks.load(); block != nullptr;) {
+                auto* next = block->next;
+                delete block;
+                block = next;
+            }
+        }
+
+        /**
+         * @brief Provides an immutable snapshot of the current version.
+         *
+         * Lock-free: the current version is announced in a reader slot and
+         * then checked to still be current, retrying if a writer replaced
+         * it in between.
+         *
+         * @return Snapshot The current graph.
+         */
+        Snapshot snapshot() const {
+            const auto* v = current.load(std::memory_order_seq_cst);
+            auto* slot = claimSlot(v);
+            while (true) {
+                const auto* latest = current.load(std::memory_order_seq_cst);
+                if (latest == v) {
+                    return Snapshot(slot, v);
+                }
+                v = latest;
+                slot->hazard.store(v, std::memory_order_seq_cst);
+            }
+        }
+
+        /**
+         * @brief Provides the number of the current version.
+         *
+         * Version numbers start at 0 and increase by one per published
+         * batch.
+         *
+         * @return std::uint64_t The current version number.
+         */
+        std::uint64_t getVersion() const {
+            return currentNumber.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Applies `batch` to a copy of the current version and
+         * publishes it as a new version.
+         *
+         * Empty batches do not create a new version.
+         *
+         * @param batch The mutations to apply.
+         * @return std::uint64_t The number of the latest version.
+         */
+        std::uint64_t update(const GraphUpdateBatch<T, U>& batch) {
+            std::lock_guard<std::mutex> lock(writerMutex);
+
+            const auto* latest = current.load(std::memory_order_acquire);
+            if (batch.empty()) {
+                return latest->number;
+            }
+
+            Graph<T, U> next(latest->graph);
+            batch.applyTo(next);
+            return publish(std::move(next), latest->number + 1);
+        }
+
+        /**
+         * @brief Drains `log`, applies its mutations in parallel to a copy of
+         * the current version and publishes it as a new version.
+         *
+         * Readers see the whole drained batch at once, or none of it. An
+         * empty log does not create a new version.
+         *
+         * @param log The mutations to apply.
+         * @param numThreads The number of threads to use, 0 for the default.
+         * @return std::uint64_t The number of the latest version.
+         */
+        std::uint64_t update(GraphMutationLog<T, U>& log, unsigned int numThreads = 0) {
+            std::lock_guard<std::mutex> lock(writerMutex);
+
+            const auto* latest = current.load(std::memory_order_acquire);
+            const auto batch = log.drain();
+            if (batch.empty()) {
+                return latest->number;
+            }
+
+            Graph<T, U> next(latest->graph);
+            batch.applyTo(next, numThreads);
+            return publish(std::move(next), latest->number + 1);
+        }
+    };
+}
+
+#endif
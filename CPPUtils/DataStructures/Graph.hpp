@@ -34,7 +34,18 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define CPP_UTILS_DATA_STRUCTURES_GRAPH
 
 #include <algorithm>
+#include <bit>
 #include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -83,60 +94,593 @@ namespace CPPUtils::DataStructures::Graphs {
         U getWeight() const {
             return weight;
         }
+
+        /**
+         * @brief Set the Weight that this edge connects to the vertex with.
+         * 
+         * @param w New edge weight.
+         */
+        void setWeight(U w) {
+            weight = w;
+        }
+    };
+
+    /**
+     * @brief A fully specified edge; source, target and weight.
+     * 
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     */
+    template<typename T, typename U = double>
+    struct WeightedEdge final {
+        T source;
+        T target;
+        U weight;
     };
 
     /**
      * @brief An Adjacency List of outward edges in a directed graph.
      * 
+     * Allocates with the allocator of the graph that owns it, rebound to
+     * the edge type; with the default allocator it is a plain `std::vector`.
+     * 
      * @tparam T Vertex type.
      * @tparam U Edge type.
+     * @tparam A Allocator type.
      */
-    template<typename T, typename U = double>
-    using AdjacencyList = std::vector<OutwardEdge<T, U>>;
+    template<typename T, typename U = double, typename A = std::allocator<std::byte>>
+    using AdjacencyList =
+        std::vector<OutwardEdge<T, U>, typename std::allocator_traits<A>::template rebind_alloc<OutwardEdge<T, U>>>;
+
+    /**
+     * @brief How a graph treats an edge whose source and target already
+     * have an edge between them.
+     * 
+     */
+    enum class MultiEdgePolicy : short {
+        // Add it alongside the existing edge.
+        ALLOW,
+
+        // Discard it, keeping the existing edge.
+        DEDUPE,
+
+        // Keep one edge, with the smaller of the two weights.
+        KEEP_MIN
+    };
+
+    /**
+     * @brief The outward edges of a single vertex.
+     * 
+     * Edges are kept in an `AdjacencyList`. Once a vertex's degree reaches
+     * `hubDegree`, an open addressing hash index, from target vertex to
+     * position in the list, is built alongside it, so that edge lookups on
+     * high degree vertices take constant rather than linear time. The index
+     * records the first position of each target.
+     * 
+     * Allocates with the same allocator as its owning graph.
+     * 
+     * @tparam T Vertex type.
+     * @tparam U Edge type.
+     * @tparam A Allocator type.
+     */
+    template<typename T, typename U = double, typename A = std::allocator<std::byte>>
+    class VertexAdjacency final {
+    public:
+        using allocator_type = A;
+
+        /**
+         * @brief The degree at which a vertex gains a hash index.
+         * 
+         */
+        static constexpr size_t hubDegree = 64;
+
+        /**
+         * @brief Returned by `find` when there is no such edge.
+         * 
+         */
+        static constexpr size_t npos = (std::numeric_limits<size_t>::max)();
+
+    private:
+        // Slots hold a list position plus one; zero marks an empty slot.
+        using Slot = std::uint32_t;
+
+        AdjacencyList<T, U, A> list;
+        std::vector<Slot, typename std::allocator_traits<A>::template rebind_alloc<Slot>> index;
+
+        size_t slotOf(const T& b) const {
+            return std::hash<T>()(b) & (index.size() - 1);
+        }
+
+        void indexPosition(size_t pos) {
+            const auto& b = list[pos].getVertex();
+            for (auto i = slotOf(b);; i = (i + 1) & (index.size() - 1)) {
+                if (index[i] == 0) {
+                    index[i] = static_cast<Slot>(pos + 1);
+                    return;
+                }
+                if (list[index[i] - 1].getVertex() == b) {
+                    return;
+                }
+            }
+        }
+
+        void reindex() {
+            // Keep the load factor at or below a half.
+            if (list.size() < hubDegree) {
+                index.clear();
+                index.shrink_to_fit();
+                return;
+            }
+
+            index.assign(std::bit_ceil(2 * list.size()), 0);
+            for (size_t pos = 0; pos < list.size(); pos++) {
+                indexPosition(pos);
+            }
+        }
+
+    public:
+        VertexAdjacency() :
+            VertexAdjacency(allocator_type()) {
+            //
+        }
+
+        explicit VertexAdjacency(const allocator_type& alloc) :
+            list(alloc),
+            index(alloc) {
+            //
+        }
+
+        VertexAdjacency(const VertexAdjacency& other, const allocator_type& alloc) :
+            list(other.list, alloc),
+            index(other.index, alloc) {
+            //
+        }
+
+        VertexAdjacency(VertexAdjacency&& other, const allocator_type& alloc) :
+            list(std::move(other.list), alloc),
+            index(std::move(other.index), alloc) {
+            //
+        }
+
+        VertexAdjacency(const VertexAdjacency&) = default;
+        VertexAdjacency(VertexAdjacency&&) = default;
+        VertexAdjacency& operator=(const VertexAdjacency&) = default;
+        VertexAdjacency& operator=(VertexAdjacency&&) = default;
+
+        /**
+         * @brief Provides the outward edges.
+         * 
+         * @return const AdjacencyList<T, U, A>& The edges.
+         */
+        const AdjacencyList<T, U, A>& getList() const {
+            return list;
+        }
+
+        /**
+         * @brief Determines if the vertex has a hash index.
+         * 
+         * @return true If the degree has reached `hubDegree`.
+         * @return false Otherwise.
+         */
+        bool isHub() const {
+            return !index.empty();
+        }
+
+        /**
+         * @brief Finds the first edge to `b`.
+         * 
+         * @param b The target vertex.
+         * @return size_t The position of the edge in the list, or `npos`.
+         */
+        size_t find(const T& b) const {
+            if (isHub()) {
+                for (auto i = slotOf(b); index[i] != 0; i = (i + 1) & (index.size() - 1)) {
+                    if (list[index[i] - 1].getVertex() == b) {
+                        return index[i] - 1;
+                    }
+                }
+                return npos;
+            }
+
+            for (size_t pos = 0; pos < list.size(); pos++) {
+                if (list[pos].getVertex() == b) {
+                    return pos;
+                }
+            }
+            return npos;
+        }
+
+        /**
+         * @brief Adds an edge to `b`, subject to `policy`.
+         * 
+         * @param b The target vertex.
+         * @param weight The weight of the edge.
+         * @param policy How to treat an existing edge to `b`.
+         */
+        void insert(const T& b, U weight, MultiEdgePolicy policy) {
+            if (policy != MultiEdgePolicy::ALLOW) {
+                const auto pos = find(b);
+                if (pos != npos) {
+                    if (policy == MultiEdgePolicy::KEEP_MIN && weight < list[pos].getWeight()) {
+                        list[pos].setWeight(weight);
+                    }
+                    return;
+                }
+            }
+
+            list.emplace_back(b, weight);
+            if (list.size() == hubDegree || (isHub() && 2 * list.size() > index.size())) {
+                reindex();
+            } else if (isHub()) {
+                indexPosition(list.size() - 1);
+            }
+        }
+
+        /**
+         * @brief Removes every edge to `b`.
+         * 
+         * @param b The target vertex.
+         * @return size_t The number of edges removed.
+         */
+        size_t erase(const T& b) {
+            if (isHub() && find(b) == npos) {
+                return 0;
+            }
+
+            const auto before = list.size();
+            list.erase(std::remove_if(list.begin(), list.end(),
+                [&b](const OutwardEdge<T, U>& c) {
+                    return b == c.getVertex();
+                }), list.end());
+
+            // Positions have shifted, so the index must be rebuilt.
+            const auto removed = before - list.size();
+            if (removed > 0 && isHub()) {
+                reindex();
+            }
+            return removed;
+        }
+
+        /**
+         * @brief Sets the weight of every edge to `b`.
+         * 
+         * @param b The target vertex.
+         * @param weight The new weight.
+         * @param unique Whether there can be at most one edge to `b`.
+         * @return size_t The number of edges updated.
+         */
+        size_t setWeight(const T& b, U weight, bool unique) {
+            if (unique || (isHub() && find(b) == npos)) {
+                const auto pos = find(b);
+                if (pos == npos) {
+                    return 0;
+                }
+                list[pos].setWeight(weight);
+                return 1;
+            }
+
+            size_t n = 0;
+            for (auto& c : list) {
+                if (b == c.getVertex()) {
+                    c.setWeight(weight);
+                    n++;
+                }
+            }
+            return n;
+        }
+
+        /**
+         * @brief Releases unused list capacity.
+         * 
+         */
+        void shrinkToFit() {
+            list.shrink_to_fit();
+        }
+
+        /**
+         * @brief Provides the number of bytes held by the hash index.
+         * 
+         * @return size_t The index size in bytes.
+         */
+        size_t getIndexBytes() const {
+            return index.capacity() * sizeof(Slot);
+        }
+    };
+
+    /**
+     * @brief A breakdown of the memory held by a graph, in bytes.
+     * 
+     * Node sizes are estimates, as the layout of hash map nodes is
+     * implementation defined. Memory owned indirectly by vertex keys, such
+     * as string contents, is not included.
+     */
+    struct GraphMemoryUsage final {
+        // The vertex map's bucket array.
+        size_t bucketBytes = 0;
+
+        // The vertex map's nodes, excluding the keys and adjacency lists
+        // they contain.
+        size_t nodeBytes = 0;
+
+        // The vertex keys.
+        size_t keyBytes = 0;
+
+        // The adjacency list and hash index headers, held in the nodes.
+        size_t adjacencyHeaderBytes = 0;
+
+        // Adjacency list elements in use.
+        size_t adjacencyUsedBytes = 0;
+
+        // Adjacency list elements allocated, used or not.
+        size_t adjacencyCapacityBytes = 0;
+
+        // Hash indices of high degree vertices.
+        size_t hubIndexBytes = 0;
+
+        /**
+         * @brief Provides the total number of bytes held.
+         * 
+         * @return size_t The total, counting adjacency capacity.
+         */
+        size_t total() const {
+            return bucketBytes + nodeBytes + keyBytes + adjacencyHeaderBytes + adjacencyCapacityBytes +
+                   hubIndexBytes;
+        }
+
+        /**
+         * @brief Provides the number of bytes allocated to adjacency lists
+         * but not in use; recoverable by `shrinkToFit`.
+         * 
+         * @return size_t The slack.
+         */
+        size_t adjacencySlackBytes() const {
+            return adjacencyCapacityBytes - adjacencyUsedBytes;
+        }
+    };
+
+    /**
+     * @brief Summary statistics of the out degrees of a graph's vertices.
+     * 
+     */
+    struct DegreeStatistics final {
+        size_t minimum = 0;
+        size_t maximum = 0;
+        double mean = 0.0;
+        double standardDeviation = 0.0;
+
+        // Vertices with no outward edges.
+        size_t isolated = 0;
+
+        // Element 0 counts vertices of degree 0, and element i > 0 those
+        // with degree in [2^(i - 1), 2^i).
+        std::vector<size_t> histogram;
+    };
+
+    template<typename T, typename U>
+    class GraphMutationLog;
 
     /**
      * @brief A simple, undirected graph.
      * 
      * @tparam T Vertex type.
      * @tparam U Edge type.
+     * @tparam A Allocator type, for the vertex map and adjacency lists.
      */
-    template<typename T, typename U = double>
+    template<typename T, typename U = double, typename A = std::allocator<std::byte>>
     class Graph {
     protected:
+        // Applies sharded mutations directly to adjacency lists.
+        friend class GraphMutationLog<T, U>;
+
+        using Adjacency = VertexAdjacency<T, U, A>;
+
+        using VertexMap = std::unordered_map<T, Adjacency, std::hash<T>, std::equal_to<T>,
+            typename std::allocator_traits<A>::template rebind_alloc<std::pair<const T, Adjacency>>>;
+
         // Controls how edges are added - bidirectional or not.
         bool directed;
 
+        // Controls how repeated edges are added.
+        MultiEdgePolicy multiEdgePolicy;
+
+        // Whether duplicates may remain from before the policy stopped
+        // allowing them.
+        bool mayHoldDuplicates;
+
         // An adjacency list (value) for each vertex (key).
-        std::unordered_map<T, AdjacencyList<T, U>> edges;
+        VertexMap edges;
 
-        void removeAdjacency(const T& a, AdjacencyList<T, U>& s) {
-            if (s.empty()) {
-                return;
-            }
+        void removeAdjacency(const T& a, Adjacency& s) {
+            // Remove a from the adjacency set.
+            s.erase(a);
+        }
+
+        size_t setAdjacencyWeight(const T& a, Adjacency& s, U weight) {
+            // Overwrite the weight of every edge to a in place.
+            return s.setWeight(a, weight, multiEdgePolicy != MultiEdgePolicy::ALLOW && !mayHoldDuplicates);
+        }
 
-            // Remove b from a's adjacency set.
-            s.erase(std::remove_if(s.begin(), s.end(),
-                [&a](const OutwardEdge<T, U>& c) {
-                    return a == c.getVertex();
-                }));
+        void insertAdjacency(const T& a, Adjacency& s, U weight) {
+            s.insert(a, weight, multiEdgePolicy);
         }
 
     public:
+        /**
+         * @brief A forward range over every edge of a graph, yielding
+         * `WeightedEdge`s by value.
+         * 
+         */
+        class EdgeRange final {
+        private:
+            using MapIterator = typename VertexMap::const_iterator;
+
+            MapIterator first;
+            MapIterator last;
+
+        public:
+            class Iterator final {
+            private:
+                MapIterator vertex;
+                MapIterator last;
+                size_t i;
+
+                void skipExhausted() {
+                    // Move on past vertices with no edges left.
+                    while (vertex != last && i >= vertex->second.getList().size()) {
+                        ++vertex;
+                        i = 0;
+                    }
+                }
+
+            public:
+                using value_type = WeightedEdge<T, U>;
+                using reference = WeightedEdge<T, U>;
+                using difference_type = std::ptrdiff_t;
+                using iterator_concept = std::forward_iterator_tag;
+                using iterator_category = std::input_iterator_tag;
+
+                Iterator() :
+                    i(0) {
+                    //
+                }
+
+                Iterator(MapIterator vertex, MapIterator last) :
+                    vertex(vertex),
+                    last(last),
+                    i(0) {
+                    skipExhausted();
+                }
+
+                reference operator*() const {
+                    const auto& e = vertex->second.getList()[i];
+                    return {vertex->first, e.getVertex(), e.getWeight()};
+                }
+
+                Iterator& operator++() {
+                    ++i;
+                    skipExhausted();
+                    return *this;
+                }
+
+                Iterator operator++(int) {
+                    Iterator tmp(*this);
+                    ++*this;
+                    return tmp;
+                }
+
+                bool operator==(const Iterator& rhs) const {
+                    return vertex == rhs.vertex && (vertex == last || i == rhs.i);
+                }
+            };
+
+            explicit EdgeRange(const VertexMap& edges) :
+                first(edges.begin()),
+                last(edges.end()) {
+                //
+            }
+
+            Iterator begin() const {
+                return Iterator(first, last);
+            }
+
+            Iterator end() const {
+                return Iterator(last, last);
+            }
+        };
+
         /**
          * @brief The edge type that forms a connection in a graph.
          * 
          */
         using EdgeType = OutwardEdge<T, U>;
 
+        /**
+         * @brief The vertex type of the graph.
+         * 
+         */
+        using VertexType = T;
+
+        /**
+         * @brief The weight type of the graph.
+         * 
+         */
+        using WeightType = U;
+
         /**
          * @brief Construct a new Graph object
          * 
          */
         Graph() :
-            directed(false) {
+            directed(false),
+            multiEdgePolicy(MultiEdgePolicy::ALLOW),
+            mayHoldDuplicates(false) {
             //
         }
 
+        /**
+         * @brief Construct a new Graph object whose vertex map and adjacency
+         * lists all allocate with `alloc`.
+         * 
+         * Adjacency lists only share the allocator if `A` propagates itself
+         * on construction, as `std::pmr::polymorphic_allocator` does.
+         * 
+         * @param alloc The allocator.
+         */
+        explicit Graph(const A& alloc) :
+            directed(false),
+            multiEdgePolicy(MultiEdgePolicy::ALLOW),
+            mayHoldDuplicates(false),
+            edges(alloc) {
+            //
+        }
+
+        /**
+         * @brief Construct a new Graph object holding the same vertices and
+         * edges as `other`, which uses a different allocator.
+         * 
+         * @tparam B The allocator type of `other`.
+         * @param other The graph to copy.
+         * @param alloc The allocator.
+         */
+        template<typename B>
+            requires (!std::is_same_v<A, B>)
+        explicit Graph(const Graph<T, U, B>& other, const A& alloc = A()) :
+            directed(other.isDirected()),
+            multiEdgePolicy(other.getMultiEdgePolicy()),
+            mayHoldDuplicates(true),
+            edges(alloc) {
+            edges.reserve(other.getVertexCardinality());
+            for (const auto& a : other.getVertexRange()) {
+                // Copy the list as it is, duplicates included.
+                auto& s = edges.try_emplace(a).first->second;
+                for (const auto& e : other.getAdjacencyList(a)) {
+                    s.insert(e.getVertex(), e.getWeight(), MultiEdgePolicy::ALLOW);
+                }
+            }
+        }
+
+        /**
+         * @brief Provides the allocator the graph allocates with.
+         * 
+         * @return A The allocator.
+         */
+        A getAllocator() const {
+            return A(edges.get_allocator());
+        }
+
+        /**
+         * @brief Provides an empty graph with the same directedness,
+         * multi-edge policy and allocator as this one.
+         * 
+         * @return Graph The empty graph.
+         */
+        Graph emptyCopy() const {
+            Graph result(getAllocator());
+            result.directed = directed;
+            result.multiEdgePolicy = multiEdgePolicy;
+            return result;
+        }
+
         /**
          * @brief Determines if the vertex `a` exists in the graph.
          * 
@@ -158,9 +702,8 @@ namespace CPPUtils::DataStructures::Graphs {
          * @param a The vertex to add.
          */
         void addVertex(const T& a) {
-            if (!vertexExists(a)) {
-                edges[a] = AdjacencyList<T, U>();
-            }
+            // Constructed in place, so the list takes the map's resource.
+            edges.try_emplace(a);
         }
 
         /**
@@ -193,7 +736,8 @@ namespace CPPUtils::DataStructures::Graphs {
          * to vertex `b`.
          * 
          * If either `a` or `b` do not exist in the graph, then they are added
-         * prior to creating the edge.
+         * prior to creating the edge. If there is already an edge from `a` to
+         * `b`, the graph's `MultiEdgePolicy` decides what happens.
          * 
          * @param a The source vertex.
          * @param b The sink vertex.
@@ -211,11 +755,11 @@ namespace CPPUtils::DataStructures::Graphs {
             }
 
             // Add edge from a to b.
-            edges.at(a).emplace_back(b, weight);
+            insertAdjacency(b, edges.at(a), weight);
 
             // If undirected add an edge back from b to a.
             if (!directed) {
-                edges.at(b).emplace_back(a, weight);
+                insertAdjacency(a, edges.at(b), weight);
             }
         }
 
@@ -242,6 +786,57 @@ namespace CPPUtils::DataStructures::Graphs {
             }
         }
 
+        /**
+         * @brief Sets the weight of the edge from vertex `a` to vertex `b`,
+         * in place.
+         * 
+         * If the graph is undirected, the edge from `b` to `a` is also
+         * updated. If there are several edges from `a` to `b`, all of them are
+         * updated.
+         * 
+         * No-op if there is no edge from `a` to `b`.
+         * 
+         * @param a The source vertex.
+         * @param b The sink vertex.
+         * @param weight The new weight of the edge.
+         * @return true If the edge exists and was updated.
+         * @return false If there is no such edge.
+         */
+        bool setEdgeWeight(const T& a, const T& b, U weight) {
+            // Early out if either doesn't exist.
+            auto itA = edges.find(a);
+            if (itA == edges.end() || !vertexExists(b)) {
+                return false;
+            }
+
+            // Update the edge from a to b.
+            if (setAdjacencyWeight(b, itA->second, weight) == 0) {
+                return false;
+            }
+
+            // If undirected, also update the edge from b to a.
+            if (!directed) {
+                setAdjacencyWeight(a, edges.at(b), weight);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Applies a batch of edge weight updates, in order.
+         * 
+         * Updates for edges that do not exist are skipped.
+         * 
+         * @param updates The edges to update, with their new weights.
+         * @return size_t The number of updates that were applied.
+         */
+        size_t setEdgeWeights(std::span<const WeightedEdge<T, U>> updates) {
+            size_t n = 0;
+            for (const auto& e : updates) {
+                n += setEdgeWeight(e.source, e.target, e.weight) ? 1 : 0;
+            }
+            return n;
+        }
+
         /**
          * @brief Provides the vertex set cardinality of the graph.
          * 
@@ -258,31 +853,185 @@ namespace CPPUtils::DataStructures::Graphs {
          * list is returned.
          * 
          * @param a The vertex for which the adjacency list is required.
-         * @return const AdjacencyList<T, U>& The adjacency list of vertex `a`.
+         * @return const AdjacencyList<T, U, A>& The adjacency list of vertex `a`.
          */
-        const AdjacencyList<T, U>& getAdjacencyList(const T& a) const {
+        const AdjacencyList<T, U, A>& getAdjacencyList(const T& a) const {
             // If the vertex doesn't exist, return an empty adjacency list.
             if (!vertexExists(a)) {
-                static const AdjacencyList<T, U> empty;
+                static const AdjacencyList<T, U, A> empty;
                 return empty;
             }
 
-            return edges.at(a);
+            return edges.at(a).getList();
+        }
+
+        /**
+         * @brief Provides a lazy view of the vertex set of the graph.
+         * 
+         * Iterates the graph's own storage, without copying; it is
+         * invalidated by adding or removing vertices.
+         * 
+         * @return auto A range of `const T&`.
+         */
+        auto getVertexRange() const {
+            return std::views::keys(edges);
+        }
+
+        /**
+         * @brief Provides a lazy view of every edge in the graph, as
+         * `WeightedEdge`s.
+         * 
+         * Undirected edges appear once in each direction. The range is
+         * invalidated by any change to the graph's structure.
+         * 
+         * @return EdgeRange A range of `WeightedEdge<T, U>`.
+         */
+        EdgeRange getEdgeRange() const {
+            return EdgeRange(edges);
         }
 
         /**
          * @brief Provides the vertex set of the graph.
          * 
+         * Prefer `getVertexRange` unless a copy is needed.
+         * 
          * @return const std::vector<T> The set of vertices in the graph.
          */
         const std::vector<T> getVertices() const {
             // Pull out the map keys.
-            std::vector<T> vertices;
-            std::transform(edges.begin(), edges.end(), std::back_inserter(vertices),
-                           [](const std::pair<T, AdjacencyList<T, U>>& a) -> T {
-                               return a.first;
-                           });
-            return vertices;
+            const auto keys = getVertexRange();
+            return std::vector<T>(keys.begin(), keys.end());
+        }
+
+        /**
+         * @brief Provides the total number of adjacency list entries.
+         * 
+         * Undirected edges are counted once in each direction.
+         * 
+         * @return size_t The number of directed edges.
+         */
+        size_t getEdgeCardinality() const {
+            size_t n = 0;
+            for (const auto& [v, adjacency] : edges) {
+                n += adjacency.getList().size();
+            }
+            return n;
+        }
+
+        /**
+         * @brief Reports the memory held by the graph.
+         * 
+         * @return GraphMemoryUsage The breakdown.
+         */
+        GraphMemoryUsage getMemoryUsage() const {
+            using Node = std::pair<const T, Adjacency>;
+
+            GraphMemoryUsage usage;
+            usage.bucketBytes = edges.bucket_count() * sizeof(void*);
+
+            // A next pointer and a cached hash per node.
+            usage.nodeBytes = edges.size() * (sizeof(void*) + sizeof(size_t) + sizeof(Node) -
+                                              sizeof(T) - sizeof(Adjacency));
+            usage.keyBytes = edges.size() * sizeof(T);
+            usage.adjacencyHeaderBytes = edges.size() * sizeof(Adjacency);
+            for (const auto& [v, adjacency] : edges) {
+                usage.adjacencyUsedBytes += adjacency.getList().size() * sizeof(OutwardEdge<T, U>);
+                usage.adjacencyCapacityBytes += adjacency.getList().capacity() * sizeof(OutwardEdge<T, U>);
+                usage.hubIndexBytes += adjacency.getIndexBytes();
+            }
+            return usage;
+        }
+
+        /**
+         * @brief Summarises the out degrees of the vertices.
+         * 
+         * @return DegreeStatistics The statistics; all zero if the graph is
+         * empty.
+         */
+        DegreeStatistics getDegreeStatistics() const {
+            DegreeStatistics stats;
+            if (edges.empty()) {
+                return stats;
+            }
+
+            stats.minimum = (std::numeric_limits<size_t>::max)();
+            double sum = 0.0;
+            double sumOfSquares = 0.0;
+            for (const auto& [v, adjacency] : edges) {
+                const auto d = adjacency.getList().size();
+                stats.minimum = (std::min)(stats.minimum, d);
+                stats.maximum = (std::max)(stats.maximum, d);
+                stats.isolated += d == 0 ? 1 : 0;
+                sum += static_cast<double>(d);
+                sumOfSquares += static_cast<double>(d) * static_cast<double>(d);
+
+                const auto bucket = static_cast<size_t>(std::bit_width(d));
+                if (stats.histogram.size() <= bucket) {
+                    stats.histogram.resize(bucket + 1, 0);
+                }
+                stats.histogram[bucket]++;
+            }
+
+            const auto N = static_cast<double>(edges.size());
+            stats.mean = sum / N;
+            stats.standardDeviation = std::sqrt((std::max)(0.0, sumOfSquares / N - stats.mean * stats.mean));
+            return stats;
+        }
+
+        /**
+         * @brief Releases unused capacity from every adjacency list, and
+         * shrinks the vertex map's bucket array to suit its size.
+         * 
+         * Invalidates references to adjacency list elements.
+         */
+        void shrinkToFit() {
+            for (auto& [v, adjacency] : edges) {
+                adjacency.shrinkToFit();
+            }
+            edges.rehash(0);
+        }
+
+        /**
+         * @brief Determines if there is an edge from `a` to `b`.
+         * 
+         * Takes constant time for high degree vertices, and time linear in
+         * the degree of `a` otherwise.
+         * 
+         * @param a The source vertex.
+         * @param b The sink vertex.
+         * @return true If the edge exists.
+         * @return false Otherwise.
+         */
+        bool hasEdge(const T& a, const T& b) const {
+            const auto it = edges.find(a);
+            return it != edges.end() && it->second.find(b) != Adjacency::npos;
+        }
+
+        /**
+         * @brief Sets how subsequently added edges that duplicate an
+         * existing edge are treated.
+         * 
+         * Edges already in the graph are left as they are, so duplicates
+         * added under `ALLOW` remain, and `setEdgeWeight` still updates all
+         * of them.
+         * 
+         * @param policy The policy.
+         */
+        void setMultiEdgePolicy(MultiEdgePolicy policy) {
+            if (multiEdgePolicy == MultiEdgePolicy::ALLOW && !edges.empty()) {
+                mayHoldDuplicates = true;
+            }
+            multiEdgePolicy = policy;
+        }
+
+        /**
+         * @brief Provides how added edges that duplicate an existing edge are
+         * treated.
+         * 
+         * @return MultiEdgePolicy The policy.
+         */
+        MultiEdgePolicy getMultiEdgePolicy() const {
+            return multiEdgePolicy;
         }
 
         /**
@@ -301,13 +1050,25 @@ namespace CPPUtils::DataStructures::Graphs {
      * 
      * @tparam T Vertex type.
      * @tparam U Edge type.
+     * @tparam A Allocator type.
      */
-    template<typename T, typename U = double>
-    class DirectedGraph : public Graph<T, U> {
+    template<typename T, typename U = double, typename A = std::allocator<std::byte>>
+    class DirectedGraph : public Graph<T, U, A> {
     public:
         DirectedGraph() {
            this->directed = true;
         }
+
+        /**
+         * @brief Construct a new Directed Graph object which allocates with
+         * `alloc`.
+         * 
+         * @param alloc The allocator.
+         */
+        explicit DirectedGraph(const A& alloc) :
+            Graph<T, U, A>(alloc) {
+            this->directed = true;
+        }
     };
 }
 
@@ -0,0 +1,451 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_DATA_STRUCTURES_GRAPH_MUTATION_LOG
+#define CPP_UTILS_DATA_STRUCTURES_GRAPH_MUTATION_LOG
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <CPPUtils/Concurrency/Parallel.hpp>
+#include <CPPUtils/DataStructures/Graph.hpp>
+
+namespace CPPUtils::DataStructures::Graphs {
+
+    /**
+     * @brief A buffer of edge mutations that any number of threads may
+     * record into concurrently, and which is applied to a graph in parallel.
+     *
+     * Each recording thread gets its own lock-free single producer, single
+     * consumer queue of fixed size blocks, so recording never blocks, never
+     * contends with other threads, and allocates once per block rather than
+     * once per mutation. Applying the log drains every queue into a `Batch`,
+     * sharding the mutations by a hash of their source vertex, which is
+     * then applied to a graph in parallel, one thread per group of shards.
+     * Each adjacency list is only ever touched by the thread that owns its
+     * vertex's shard; for undirected graphs the reverse half of each edge is
+     * routed to the shard of its other end.
+     *
+     * Adjacency lists of different shards share the graph's allocator, so
+     * shards are only applied concurrently when that allocator is thread
+     * safe: `std::allocator`, or a `std::pmr::polymorphic_allocator` over
+     * the new/delete or a synchronized pool resource. Otherwise, as for an
+     * `ArenaGraph`, the batch is applied on the calling thread.
+     *
+     * Added edges are subject to the graph's `MultiEdgePolicy`. Only one
+     * thread may drain or apply the log at a time.
+     *
+     * Mutations with the same source vertex are applied in the order they
+     * were recorded by any one thread. Mutations to the same undirected edge
+     * that are recorded from opposite ends, in the same batch, have no
+     * defined order relative to each other.
+     *
+     * @tparam T Vertex type.
+     * @tparam U Weight type.
+     */
+    template<typename T, typename U = double>
+    class GraphMutationLog {
+    public:
+        /**
+         * @brief The kind of a recorded mutation.
+         *
+         */
+        enum class Operation : short {
+            ADD_EDGE,
+            REMOVE_EDGE,
+            SET_EDGE_WEIGHT
+        };
+
+        /**
+         * @brief A single recorded mutation.
+         *
+         */
+        struct Mutation final {
+            Operation operation;
+            T a;
+            T b;
+            U weight;
+        };
+
+    private:
+        static constexpr size_t blockSize = 256;
+
+        struct Block final {
+            std::array<Mutation, blockSize> mutations;
+
+            // Slots below this are written; only the producer advances it.
+            std::atomic<size_t> written{ 0 };
+            std::atomic<Block*> next{ nullptr };
+        };
+
+        // One recording thread's queue. The producer appends at the tail and
+        // the consumer reads from the head; padded so that neighbouring
+        // producers don't false share.
+        struct alignas(64) Producer final {
+            std::thread::id owner;
+            Producer* next = nullptr;
+
+            // Owned by the producer.
+            Block* tail;
+
+            // Owned by the consumer.
+            Block* head;
+            size_t read = 0;
+
+            explicit Producer(std::thread::id owner) :
+                owner(owner),
+                tail(new Block()),
+                head(tail) {
+                //
+            }
+        };
+
+        // Distinguishes logs in the per thread producer cache, even when one
+        // is allocated where another used to be.
+        static inline std::atomic<std::uint64_t> nextId{ 1 };
+
+        std::uint64_t id;
+        size_t numShards;
+        std::atomic<Producer*> producers{ nullptr };
+
+        Producer& producerOf() {
+            // Threads usually record into one log at a time, so a single
+            // cached entry saves searching the producer list.
+            struct Cache {
+                std::uint64_t id = 0;
+                Producer* producer = nullptr;
+            };
+            static thread_local Cache cache;
+            if (cache.id == id) {
+                return *cache.producer;
+            }
+
+            const auto self = std::this_thread::get_id();
+            auto* p = producers.load(std::memory_order_acquire);
+            for (; p != nullptr && p->owner != self; p = p->next) {
+                //
+            }
+
+            if (p == nullptr) {
+                // Producers are only ever added, at the front.
+                p = new Producer(self);
+                p->next = producers.load(std::memory_order_relaxed);
+                while (!producers.compare_exchange_weak(p->next, p,
+                                                        std::memory_order_release,
+                                                        std::memory_order_relaxed)) {
+                    //
+                }
+            }
+
+            cache = { id, p };
+            return *p;
+        }
+
+        void push(Mutation&& m) {
+            auto& p = producerOf();
+            auto n = p.tail->written.load(std::memory_order_relaxed);
+            if (n == blockSize) {
+                auto* block = new Block();
+                p.tail->next.store(block, std::memory_order_release);
+                p.tail = block;
+                n = 0;
+            }
+
+            // Publish the slot only once it is written.
+            p.tail->mutations[n] = std::move(m);
+            p.tail->written.store(n + 1, std::memory_order_release);
+        }
+
+    public:
+        /**
+         * @brief The mutations drained from a log, grouped by shard, ready to
+         * be applied.
+         *
+         */
+        class Batch final {
+        private:
+            friend class GraphMutationLog;
+
+            std::vector<std::vector<Mutation>> shards;
+
+            explicit Batch(size_t numShards) :
+                shards(numShards) {
+                //
+            }
+
+            size_t shardOf(const T& a) const {
+                return std::hash<T>()(a) % shards.size();
+            }
+
+        public:
+            /**
+             * @brief Provides the number of mutations in the batch.
+             *
+             * @return size_t The mutation count.
+             */
+            size_t size() const {
+                size_t n = 0;
+                for (const auto& s : shards) {
+                    n += s.size();
+                }
+                return n;
+            }
+
+            /**
+             * @brief Determines if the batch has no mutations.
+             *
+             * @return true If the batch is empty.
+             * @return false Otherwise.
+             */
+            bool empty() const {
+                return size() == 0;
+            }
+
+            /**
+             * @brief Applies the batch to `G`.
+             *
+             * Adding an edge adds any missing endpoints, as `Graph::addEdge`
+             * does. Vertices are inserted first, serially, after which the
+             * shards are applied in parallel if `G`'s allocator allows it.
+             * `G` must not be accessed by any other thread until this
+             * returns.
+             *
+             * @tparam A Allocator type of `G`.
+             * @param G The graph to mutate.
+             * @param numThreads The number of threads to use, 0 for the
+             * default.
+             */
+            template<typename A>
+            void applyTo(Graph<T, U, A>& G, unsigned int numThreads = 0) const {
+                GraphMutationLog::apply(*this, G, numThreads);
+            }
+        };
+
+    private:
+        template<typename A>
+        static bool concurrentAllocation(const Graph<T, U, A>& G) {
+            if constexpr (std::is_same_v<A, std::pmr::polymorphic_allocator<std::byte>>) {
+                auto* resource = G.getAllocator().resource();
+                return resource == std::pmr::new_delete_resource() ||
+                       dynamic_cast<std::pmr::synchronized_pool_resource*>(resource) != nullptr;
+            } else {
+                return std::is_same_v<A, std::allocator<std::byte>>;
+            }
+        }
+
+        template<typename A>
+        static void apply(const Batch& batch, Graph<T, U, A>& G, unsigned int numThreads) {
+            const auto S = batch.shards.size();
+
+            // The vertex map can't be changed concurrently, so add every
+            // missing endpoint up front.
+            for (const auto& shard : batch.shards) {
+                for (const auto& m : shard) {
+                    if (m.operation == Operation::ADD_EDGE) {
+                        G.addVertex(m.a);
+                        G.addVertex(m.b);
+                    }
+                }
+            }
+
+            // Route each half edge to the shard that owns its source, keeping
+            // the order within each source shard.
+            std::vector<std::vector<std::vector<Mutation>>> routed(S, std::vector<std::vector<Mutation>>(S));
+            Concurrency::parallelFor(0, S, [&](size_t s) {
+                for (const auto& m : batch.shards[s]) {
+                    routed[s][s].push_back(m);
+                    if (!G.isDirected()) {
+                        routed[s][batch.shardOf(m.b)].push_back({ m.operation, m.b, m.a, m.weight });
+                    }
+                }
+            }, numThreads);
+
+            // Each shard's adjacency lists are now private to one thread.
+            // Lookups only read the vertex map, but growing a list allocates,
+            // so an unsynchronised allocator confines them to this thread.
+            const auto applyThreads = concurrentAllocation(G) ? numThreads : 1;
+            Concurrency::parallelFor(0, S, [&](size_t d) {
+                for (size_t s = 0; s < S; s++) {
+                    for (const auto& m : routed[s][d]) {
+                        const auto it = G.edges.find(m.a);
+                        if (it == G.edges.end() || G.edges.find(m.b) == G.edges.end()) {
+                            continue;
+                        }
+
+                        switch (m.operation) {
+                        case Operation::ADD_EDGE:
+                            G.insertAdjacency(m.b, it->second, m.weight);
+                            break;
+                        case Operation::REMOVE_EDGE:
+                            G.removeAdjacency(m.b, it->second);
+                            break;
+                        case Operation::SET_EDGE_WEIGHT:
+                            G.setAdjacencyWeight(m.b, it->second, m.weight);
+                            break;
+                        }
+                    }
+                }
+            }, applyThreads);
+        }
+
+    public:
+        /**
+         * @brief Construct a new Graph Mutation Log object.
+         *
+         * @param numShards The number of shards, 0 for four per default
+         * thread.
+         */
+        explicit GraphMutationLog(size_t numShards = 0) :
+            id(nextId.fetch_add(1, std::memory_order_relaxed)),
+            numShards(numShards == 0 ? 4 * Concurrency::getDefaultThreadCount() : numShards) {
+            //
+        }
+
+        GraphMutationLog(const GraphMutationLog&) = delete;
+        GraphMutationLog& operator=(const GraphMutationLog&) = delete;
+
+        ~GraphMutationLog() {
+            auto* p = producers.load(std::memory_order_acquire);
+            while (p != nullptr) {
+                auto* block = p->head;
+                while (block != nullptr) {
+                    auto* next = block->next.load(std::memory_order_acquire);
+                    delete block;
+                    block = next;
+                }
+
+                auto* next = p->next;
+                delete p;
+                p = next;
+            }
+        }
+
+        /**
+         * @brief Provides the number of shards.
+         *
+         * @return size_t The shard count.
+         */
+        size_t getShardCount() const {
+            return numShards;
+        }
+
+        /**
+         * @brief Records the addition of an edge from `a` to `b`.
+         *
+         * @param a The source vertex.
+         * @param b The sink vertex.
+         * @param weight The weight of the edge.
+         */
+        void addEdge(const T& a, const T& b, U weight) {
+            push({ Operation::ADD_EDGE, a, b, weight });
+        }
+
+        /**
+         * @brief Records the removal of the edge from `a` to `b`.
+         *
+         * @param a The source vertex.
+         * @param b The sink vertex.
+         */
+        void removeEdge(const T& a, const T& b) {
+            push({ Operation::REMOVE_EDGE, a, b, U() });
+        }
+
+        /**
+         * @brief Records an update of the weight of the edge from `a` to `b`.
+         *
+         * @param a The source vertex.
+         * @param b The sink vertex.
+         * @param weight The new weight of the edge.
+         */
+        void setEdgeWeight(const T& a, const T& b, U weight) {
+            push({ Operation::SET_EDGE_WEIGHT, a, b, weight });
+        }
+
+        /**
+         * @brief Takes every mutation recorded so far.
+         *
+         * Each thread's mutations are taken in the order they were
+         * recorded; those recorded concurrently with draining fall either
+         * into this batch or the next.
+         *
+         * @return Batch The mutations.
+         */
+        Batch drain() {
+            Batch batch(numShards);
+            for (auto* p = producers.load(std::memory_order_acquire); p != nullptr; p = p->next) {
+                while (true) {
+                    const auto n = p->head->written.load(std::memory_order_acquire);
+                    for (; p->read < n; p->read++) {
+                        auto& m = p->head->mutations[p->read];
+                        batch.shards[batch.shardOf(m.a)].push_back(std::move(m));
+                    }
+
+                    // Move on only once the producer has left the block.
+                    auto* next = p->head->next.load(std::memory_order_acquire);
+                    if (n < blockSize || next == nullptr) {
+                        break;
+                    }
+                    delete p->head;
+                    p->head = next;
+                    p->read = 0;
+                }
+            }
+            return batch;
+        }
+
+        /**
+         * @brief Drains the log and applies the mutations to `G`.
+         *
+         * @tparam A Allocator type of `G`.
+         * @param G The graph to mutate.
+         * @param numThreads The number of threads to use, 0 for the default.
+         * @return size_t The number of mutations applied.
+         */
+        template<typename A>
+        size_t applyTo(Graph<T, U, A>& G, unsigned int numThreads = 0) {
+            const auto batch = drain();
+            batch.applyTo(G, numThreads);
+            return batch.size();
+        }
+    };
+}
+
+#endif
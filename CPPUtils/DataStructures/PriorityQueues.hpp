@@ -0,0 +1,451 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_DATA_STRUCTURES_PRIORITY_QUEUES
+#define CPP_UTILS_DATA_STRUCTURES_PRIORITY_QUEUES
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace CPPUtils::DataStructures::PriorityQueues {
+
+    /**
+     * @brief A min-heap of dense integer items with a branching factor of
+     * `D`, supporting decrease-key.
+     * 
+     * Items are integers in [0, capacity). Each item is in the heap at most
+     * once, and the position of each item is tracked, so that its priority
+     * can be lowered in place rather than by inserting a duplicate. A
+     * branching factor of 4 keeps the heap shallow and each node's children
+     * within a cache line.
+     * 
+     * @tparam P Priority type.
+     * @tparam D Branching factor.
+     */
+    template<typename P, unsigned int D = 4>
+    class IndexedDaryHeap {
+        static_assert(D >= 2, "A heap needs a branching factor of at least 2.");
+
+    public:
+        using Item = std::uint32_t;
+        using Entry = std::pair<P, Item>;
+
+        /**
+         * @brief The position of items not in the heap.
+         * 
+         */
+        static constexpr Item npos = (std::numeric_limits<Item>::max)();
+
+    protected:
+        std::vector<Entry> heap;
+        std::vector<Item> positions;
+
+        void place(size_t i, const Entry& entry) {
+            heap[i] = entry;
+            positions[entry.second] = static_cast<Item>(i);
+        }
+
+        void siftUp(size_t i) {
+            const auto entry = heap[i];
+            while (i > 0) {
+                const auto parent = (i - 1) / D;
+                if (!(entry.first < heap[parent].first)) {
+                    break;
+                }
+                place(i, heap[parent]);
+                i = parent;
+            }
+            place(i, entry);
+        }
+
+        void siftDown(size_t i) {
+            const auto entry = heap[i];
+            const auto n = heap.size();
+            while (true) {
+                const auto first = i * D + 1;
+                if (first >= n) {
+                    break;
+                }
+
+                // Find the smallest child.
+                const auto last = first + D < n ? first + D : n;
+                auto best = first;
+                for (auto c = first + 1; c < last; c++) {
+                    if (heap[c].first < heap[best].first) {
+                        best = c;
+                    }
+                }
+
+                if (!(heap[best].first < entry.first)) {
+                    break;
+                }
+                place(i, heap[best]);
+                i = best;
+            }
+            place(i, entry);
+        }
+
+    public:
+        /**
+         * @brief Construct a new Indexed D-ary Heap object.
+         * 
+         * @param capacity One more than the largest item to be stored.
+         */
+        explicit IndexedDaryHeap(size_t capacity = 0) : positions(capacity, npos) {
+            //
+        }
+
+        virtual ~IndexedDaryHeap() {
+            //
+        }
+
+        /**
+         * @brief Grows the heap to hold items in [0, capacity).
+         * 
+         * @param capacity The new capacity; smaller values are ignored.
+         */
+        void reserve(size_t capacity) {
+            if (capacity > positions.size()) {
+                positions.resize(capacity, npos);
+            }
+        }
+
+        /**
+         * @brief Provides the number of items that can be stored.
+         * 
+         * @return size_t The capacity.
+         */
+        size_t capacity() const noexcept {
+            return positions.size();
+        }
+
+        /**
+         * @brief Provides the number of items in the heap.
+         * 
+         * @return size_t The item count.
+         */
+        size_t size() const noexcept {
+            return heap.size();
+        }
+
+        /**
+         * @brief Determines if the heap is empty.
+         * 
+         * @return true If empty.
+         * @return false Otherwise.
+         */
+        bool empty() const noexcept {
+            return heap.empty();
+        }
+
+        /**
+         * @brief Determines if `item` is in the heap.
+         * 
+         * @param item The query item.
+         * @return true If `item` is in the heap.
+         * @return false Otherwise.
+         */
+        bool contains(Item item) const noexcept {
+            return item < positions.size() && positions[item] != npos;
+        }
+
+        /**
+         * @brief Provides the priority of `item`, which must be in the heap.
+         * 
+         * @param item The query item.
+         * @return P The priority.
+         */
+        P getPriority(Item item) const {
+            if (!contains(item)) {
+                throw std::invalid_argument("Item is not in the heap.");
+            }
+            return heap[positions[item]].first;
+        }
+
+        /**
+         * @brief Inserts `item`, which must not already be in the heap.
+         * 
+         * @param item The item.
+         * @param priority Its priority.
+         */
+        void push(Item item, P priority) {
+            if (item >= positions.size()) {
+                throw std::out_of_range("Item exceeds the heap capacity.");
+            }
+            if (positions[item] != npos) {
+                throw std::invalid_argument("Item is already in the heap.");
+            }
+
+            heap.emplace_back(priority, item);
+            siftUp(heap.size() - 1);
+        }
+
+        /**
+         * @brief Lowers the priority of `item`, which must be in the heap.
+         * 
+         * @param item The item.
+         * @param priority Its new priority, no greater than its current one.
+         */
+        void decreaseKey(Item item, P priority) {
+            if (!contains(item)) {
+                throw std::invalid_argument("Item is not in the heap.");
+            }
+
+            const auto i = positions[item];
+            if (heap[i].first < priority) {
+                throw std::invalid_argument("Priority may not be increased.");
+            }
+            heap[i].first = priority;
+            siftUp(i);
+        }
+
+        /**
+         * @brief Inserts `item`, or lowers its priority if it is already in
+         * the heap with a greater one.
+         * 
+         * @param item The item.
+         * @param priority Its priority.
+         * @return true If the heap changed.
+         * @return false Otherwise.
+         */
+        bool pushOrDecrease(Item item, P priority) {
+            if (!contains(item)) {
+                push(item, priority);
+                return true;
+            }
+
+            const auto i = positions[item];
+            if (!(priority < heap[i].first)) {
+                return false;
+            }
+            heap[i].first = priority;
+            siftUp(i);
+            return true;
+        }
+
+        /**
+         * @brief Provides the item of least priority, without removing it.
+         * 
+         * @return const Entry& The priority and item.
+         */
+        const Entry& top() const {
+            if (heap.empty()) {
+                throw std::out_of_range("The heap is empty.");
+            }
+            return heap.front();
+        }
+
+        /**
+         * @brief Removes and provides the item of least priority.
+         * 
+         * @return Entry The priority and item.
+         */
+        Entry pop() {
+            if (heap.empty()) {
+                throw std::out_of_range("The heap is empty.");
+            }
+
+            const auto top = heap.front();
+            positions[top.second] = npos;
+            if (heap.size() > 1) {
+                heap.front() = heap.back();
+                heap.pop_back();
+                siftDown(0);
+            } else {
+                heap.pop_back();
+            }
+            return top;
+        }
+
+        /**
+         * @brief Removes all items, in time proportional to the number of
+         * items in the heap.
+         * 
+         */
+        void clear() noexcept {
+            for (const auto& entry : heap) {
+                positions[entry.second] = npos;
+            }
+            heap.clear();
+        }
+    };
+
+    /**
+     * @brief A monotone min-priority queue for integer priorities.
+     * 
+     * Entries are kept in buckets by the highest bit in which their priority
+     * differs from the last priority popped, so each entry is moved between
+     * buckets at most once per bit of the priority type, and push and pop
+     * cost amortised O(1) and O(bits) respectively, without comparisons
+     * between entries. Priorities pushed may not be less than the last one
+     * popped, as holds for Dijkstra's algorithm with non-negative weights.
+     * 
+     * Items may be pushed more than once; stale duplicates are popped too.
+     * 
+     * @tparam P Integer priority type.
+     * @tparam Item Item type.
+     */
+    template<std::integral P, typename Item = std::uint32_t>
+    class RadixHeap {
+    public:
+        using Entry = std::pair<P, Item>;
+
+    protected:
+        using Key = std::make_unsigned_t<P>;
+
+        static constexpr size_t numBuckets = std::numeric_limits<Key>::digits + 1;
+
+        std::array<std::vector<Entry>, numBuckets> buckets;
+        Key last;
+        size_t count;
+
+        size_t bucketOf(Key key) const noexcept {
+            return static_cast<size_t>(std::bit_width(static_cast<Key>(key ^ last)));
+        }
+
+        // Moves the entries of the lowest non-empty bucket down, so that
+        // bucket 0 holds the least priority.
+        void refill() {
+            size_t i = 1;
+            while (buckets[i].empty()) {
+                i++;
+            }
+
+            auto minimum = static_cast<Key>(buckets[i].front().first);
+            for (const auto& entry : buckets[i]) {
+                if (static_cast<Key>(entry.first) < minimum) {
+                    minimum = static_cast<Key>(entry.first);
+                }
+            }
+
+            last = minimum;
+            for (const auto& entry : buckets[i]) {
+                buckets[bucketOf(static_cast<Key>(entry.first))].push_back(entry);
+            }
+            buckets[i].clear();
+        }
+
+    public:
+        /**
+         * @brief Construct a new Radix Heap object.
+         * 
+         */
+        RadixHeap() : last(0), count(0) {
+            //
+        }
+
+        virtual ~RadixHeap() {
+            //
+        }
+
+        /**
+         * @brief Provides the number of entries in the heap.
+         * 
+         * @return size_t The entry count.
+         */
+        size_t size() const noexcept {
+            return count;
+        }
+
+        /**
+         * @brief Determines if the heap is empty.
+         * 
+         * @return true If empty.
+         * @return false Otherwise.
+         */
+        bool empty() const noexcept {
+            return count == 0;
+        }
+
+        /**
+         * @brief Inserts `item` with `priority`.
+         * 
+         * @param item The item.
+         * @param priority Its priority; not less than the last popped.
+         */
+        void push(Item item, P priority) {
+            if constexpr (std::is_signed_v<P>) {
+                if (priority < 0) {
+                    throw std::invalid_argument("Priorities must be non-negative.");
+                }
+            }
+
+            const auto key = static_cast<Key>(priority);
+            if (key < last) {
+                throw std::invalid_argument("Priority is less than the last popped.");
+            }
+            buckets[bucketOf(key)].emplace_back(priority, item);
+            count++;
+        }
+
+        /**
+         * @brief Removes and provides an entry of least priority.
+         * 
+         * @return Entry The priority and item.
+         */
+        Entry pop() {
+            if (count == 0) {
+                throw std::out_of_range("The heap is empty.");
+            }
+
+            if (buckets[0].empty()) {
+                refill();
+            }
+            const auto top = buckets[0].back();
+            buckets[0].pop_back();
+            count--;
+            return top;
+        }
+
+        /**
+         * @brief Removes all entries, keeping bucket storage, and allows
+         * priorities to start again from 0.
+         * 
+         */
+        void clear() noexcept {
+            for (auto& bucket : buckets) {
+                bucket.clear();
+            }
+            last = 0;
+            count = 0;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,242 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_DATA_STRUCTURES_SLAB_ARENA
+#define CPP_UTILS_DATA_STRUCTURES_SLAB_ARENA
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <memory_resource>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace CPPUtils::DataStructures::Arenas {
+
+    /**
+     * @brief A memory resource that carves blocks out of large slabs, with
+     * a free list per power of two size class.
+     *
+     * Requests up to `maxBlockSize` bytes are rounded up to a size class and
+     * served from that class's free list, or else bump allocated from the
+     * current slab. Freed blocks return to their class's free list for reuse,
+     * so a container that grows relocates within the arena rather than going
+     * back to the system allocator. Larger requests are passed through to the
+     * upstream resource, but are still tracked so that `release` frees them.
+     *
+     * `release`, which the destructor calls, returns every slab to the
+     * upstream resource at once, regardless of how many blocks were carved
+     * from them.
+     *
+     * Not thread safe.
+     */
+    class SlabArena final : public std::pmr::memory_resource {
+    public:
+        /**
+         * @brief The smallest block handed out.
+         *
+         */
+        static constexpr size_t minBlockSize = 16;
+
+        /**
+         * @brief The largest request served from a size class.
+         *
+         */
+        static constexpr size_t maxBlockSize = 64 * 1024;
+
+        /**
+         * @brief The default size of each slab.
+         *
+         */
+        static constexpr size_t defaultSlabSize = 1024 * 1024;
+
+    private:
+        static constexpr size_t numClasses = std::bit_width(maxBlockSize / minBlockSize);
+        static constexpr size_t slabAlignment = alignof(std::max_align_t);
+        static_assert(minBlockSize % slabAlignment == 0);
+
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        std::pmr::memory_resource* upstream;
+        const size_t slabSize;
+
+        std::array<FreeBlock*, numClasses> freeLists;
+        std::vector<std::byte*> slabs;
+        std::unordered_map<void*, std::pair<size_t, size_t>> largeBlocks;
+
+        std::byte* cursor;
+        std::byte* limit;
+        size_t bytesReserved;
+
+        static size_t sizeClass(size_t bytes) {
+            return std::bit_width(std::bit_ceil((std::max)(bytes, minBlockSize)) / minBlockSize) - 1;
+        }
+
+        static size_t classSize(size_t c) {
+            return minBlockSize << c;
+        }
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            // Oversized or over-aligned requests go straight upstream.
+            if (bytes > maxBlockSize || alignment > slabAlignment) {
+                void* p = upstream->allocate(bytes, alignment);
+                largeBlocks.emplace(p, std::make_pair(bytes, alignment));
+                bytesReserved += bytes;
+                return p;
+            }
+
+            // Reuse a freed block of the same class if possible.
+            const auto c = sizeClass(bytes);
+            if (freeLists[c] != nullptr) {
+                auto* block = freeLists[c];
+                freeLists[c] = block->next;
+                return block;
+            }
+
+            // Otherwise carve one from the current slab. Slabs are maximally
+            // aligned and class sizes are multiples of that alignment, so
+            // every block is too.
+            const auto size = classSize(c);
+            if (cursor == nullptr || static_cast<size_t>(limit - cursor) < size) {
+                auto* slab = static_cast<std::byte*>(upstream->allocate(slabSize, slabAlignment));
+                slabs.push_back(slab);
+                bytesReserved += slabSize;
+                cursor = slab;
+                limit = slab + slabSize;
+            }
+
+            void* p = cursor;
+            cursor += size;
+            return p;
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+            if (bytes > maxBlockSize || alignment > slabAlignment) {
+                upstream->deallocate(p, bytes, alignment);
+                largeBlocks.erase(p);
+                bytesReserved -= bytes;
+                return;
+            }
+
+            const auto c = sizeClass(bytes);
+            auto* block = static_cast<FreeBlock*>(p);
+            block->next = freeLists[c];
+            freeLists[c] = block;
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+    public:
+        /**
+         * @brief Construct a new Slab Arena object.
+         *
+         * @param slabSize The size of each slab; at least `maxBlockSize`.
+         * @param upstream The resource that slabs are allocated from.
+         */
+        explicit SlabArena(size_t slabSize = defaultSlabSize,
+                           std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) :
+            upstream(upstream),
+            slabSize((std::max)(slabSize, maxBlockSize)),
+            freeLists{},
+            cursor(nullptr),
+            limit(nullptr),
+            bytesReserved(0) {
+            //
+        }
+
+        SlabArena(const SlabArena&) = delete;
+        SlabArena& operator=(const SlabArena&) = delete;
+
+        ~SlabArena() {
+            release();
+        }
+
+        /**
+         * @brief Returns all memory to the upstream resource.
+         *
+         * Every block previously handed out becomes invalid.
+         */
+        void release() {
+            for (auto* slab : slabs) {
+                upstream->deallocate(slab, slabSize, slabAlignment);
+            }
+            for (const auto& [p, info] : largeBlocks) {
+                upstream->deallocate(p, info.first, info.second);
+            }
+
+            slabs.clear();
+            largeBlocks.clear();
+            freeLists.fill(nullptr);
+            cursor = nullptr;
+            limit = nullptr;
+            bytesReserved = 0;
+        }
+
+        /**
+         * @brief Provides the number of bytes currently held from upstream.
+         *
+         * @return size_t The reserved byte count.
+         */
+        size_t getBytesReserved() const {
+            return bytesReserved;
+        }
+
+        /**
+         * @brief Provides the number of slabs currently held.
+         *
+         * @return size_t The slab count.
+         */
+        size_t getSlabCount() const {
+            return slabs.size();
+        }
+
+        /**
+         * @brief Provides the block size that a request of `bytes` bytes is
+         * rounded up to, or `bytes` itself if it is served upstream.
+         *
+         * @param bytes The request size.
+         * @return size_t The block size.
+         */
+        static size_t blockSize(size_t bytes) {
+            return bytes > maxBlockSize ? bytes : classSize(sizeClass(bytes));
+        }
+    };
+}
+
+#endif
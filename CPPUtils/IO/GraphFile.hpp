@@ -0,0 +1,258 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_IO_GRAPH_FILE
+#define CPP_UTILS_IO_GRAPH_FILE
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <CPPUtils/DataStructures/CSRGraph.hpp>
+#include <CPPUtils/DataStructures/Graph.hpp>
+#include <CPPUtils/IO/MemoryMappedFile.hpp>
+
+namespace CPPUtils::IO {
+
+    /**
+     * @brief The fixed size header at the start of a binary graph file.
+     *
+     * The file is laid out as the header followed by the vertex key table,
+     * the row offsets, the edge targets and the edge weights, each section
+     * starting on a `GraphFileHeader::alignment` byte boundary. All values
+     * are stored in host byte order.
+     */
+    struct GraphFileHeader final {
+        static constexpr char expectedMagic[8] = { 'C', 'P', 'P', 'U', 'G', 'R', 'F', '\0' };
+        static constexpr std::uint32_t currentVersion = 1;
+        static constexpr std::uint32_t directedFlag = 1;
+        static constexpr std::uint64_t alignment = 64;
+
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t flags;
+        std::uint32_t keySize;
+        std::uint32_t weightSize;
+        std::uint64_t numVertices;
+        std::uint64_t numEdges;
+        std::uint64_t keysOffset;
+        std::uint64_t offsetsOffset;
+        std::uint64_t targetsOffset;
+        std::uint64_t weightsOffset;
+        std::uint64_t fileSize;
+    };
+
+    namespace Detail {
+        inline std::uint64_t alignUp(std::uint64_t n) {
+            constexpr auto A = GraphFileHeader::alignment;
+            return (n + A - 1) / A * A;
+        }
+
+        // Whether `count` elements of type X starting at `offset` are
+        // aligned and end at or before `end`.
+        template<typename X>
+        inline bool sectionFits(std::uint64_t offset, std::uint64_t count, std::uint64_t end) {
+            return offset % alignof(X) == 0 && offset <= end && count <= (end - offset) / sizeof(X);
+        }
+
+        template<typename V>
+        inline void writeSection(std::ofstream& file, std::uint64_t offset, std::span<const V> data) {
+            file.seekp(static_cast<std::streamoff>(offset));
+            file.write(reinterpret_cast<const char*>(data.data()),
+                       static_cast<std::streamsize>(data.size_bytes()));
+        }
+    }
+
+    /**
+     * @brief Writes `G` to `path` in the binary graph file format.
+     *
+     * @tparam T Vertex type, which must be trivially copyable.
+     * @tparam U Weight type, which must be trivially copyable.
+     * @param G The graph to write.
+     * @param path The output file path.
+     */
+    template<typename T, typename U>
+    inline void saveGraph(const DataStructures::Graphs::CSRGraph<T, U>& G, const std::string& path) {
+        static_assert(std::is_trivially_copyable_v<T>, "Vertex type must be trivially copyable.");
+        static_assert(std::is_trivially_copyable_v<U>, "Weight type must be trivially copyable.");
+
+        using DataStructures::Graphs::EdgeIndex;
+        using DataStructures::Graphs::VertexIndex;
+
+        const auto V = G.getVertexCardinality();
+        const auto E = G.getEdgeCardinality();
+
+        // Lay out the sections.
+        GraphFileHeader header;
+        std::memcpy(header.magic, GraphFileHeader::expectedMagic, sizeof(header.magic));
+        header.version = GraphFileHeader::currentVersion;
+        header.flags = G.isDirected() ? GraphFileHeader::directedFlag : 0;
+        header.keySize = sizeof(T);
+        header.weightSize = sizeof(U);
+        header.numVertices = V;
+        header.numEdges = E;
+        header.keysOffset = Detail::alignUp(sizeof(GraphFileHeader));
+        header.offsetsOffset = Detail::alignUp(header.keysOffset + V * sizeof(T));
+        header.targetsOffset = Detail::alignUp(header.offsetsOffset + (V + 1) * sizeof(EdgeIndex));
+        header.weightsOffset = Detail::alignUp(header.targetsOffset + E * sizeof(VertexIndex));
+        header.fileSize = header.weightsOffset + E * sizeof(U);
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            throw std::runtime_error("Unable to open file for writing: " + path);
+        }
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        Detail::writeSection(file, header.keysOffset, G.getVertices());
+        Detail::writeSection(file, header.offsetsOffset, G.getOffsets());
+        Detail::writeSection(file, header.targetsOffset, G.getTargets());
+        Detail::writeSection(file, header.weightsOffset, G.getWeights());
+
+        // Pad an empty trailing section out to the recorded size.
+        file.seekp(0, std::ios::end);
+        if (static_cast<std::uint64_t>(file.tellp()) < header.fileSize) {
+            file.seekp(static_cast<std::streamoff>(header.fileSize - 1));
+            file.put('\0');
+        }
+
+        if (!file) {
+            throw std::runtime_error("Unable to write graph file: " + path);
+        }
+    }
+
+    /**
+     * @brief Writes `G` to `path` in the binary graph file format.
+     *
+     * The graph is frozen into CSR form first.
+     *
+     * @tparam T Vertex type, which must be trivially copyable.
+     * @tparam U Weight type, which must be trivially copyable.
+     * @param G The graph to write.
+     * @param path The output file path.
+     */
+    template<typename T, typename U>
+    inline void saveGraph(const DataStructures::Graphs::Graph<T, U>& G, const std::string& path) {
+        saveGraph(DataStructures::Graphs::CSRGraph<T, U>(G), path);
+    }
+
+    /**
+     * @brief Loads a binary graph file by memory mapping it.
+     *
+     * The header is validated, including that every section is aligned and
+     * lies within the file, and by default one sequential pass checks that
+     * the offsets are non-decreasing and every target is in range. The
+     * returned graph refers directly to the mapped sections and the mapping
+     * is private, so weight updates are not written back to the file.
+     *
+     * @tparam T Vertex type, which must match the type the file was written
+     * with.
+     * @tparam U Weight type, which must match the type the file was written
+     * with.
+     * @param path The input file path.
+     * @param validate Whether to check the offsets and targets. Skipping the
+     * check makes loading independent of the graph size, but a corrupt file
+     * then causes out of bounds reads, so only pass false for trusted input.
+     * @return DataStructures::Graphs::CSRGraph<T, U> A view of the mapped
+     * graph.
+     */
+    template<typename T, typename U = double>
+    inline DataStructures::Graphs::CSRGraph<T, U> loadGraph(const std::string& path, bool validate = true) {
+        static_assert(std::is_trivially_copyable_v<T>, "Vertex type must be trivially copyable.");
+        static_assert(std::is_trivially_copyable_v<U>, "Weight type must be trivially copyable.");
+
+        using DataStructures::Graphs::EdgeIndex;
+        using DataStructures::Graphs::VertexIndex;
+
+        auto file = std::make_shared<MemoryMappedFile>(path);
+        if (file->size() < sizeof(GraphFileHeader)) {
+            throw std::runtime_error("Graph file is truncated: " + path);
+        }
+
+        GraphFileHeader header;
+        std::memcpy(&header, file->data(), sizeof(header));
+
+        if (std::memcmp(header.magic, GraphFileHeader::expectedMagic, sizeof(header.magic)) != 0) {
+            throw std::runtime_error("Not a graph file: " + path);
+        }
+        if (header.version != GraphFileHeader::currentVersion) {
+            throw std::runtime_error("Unsupported graph file version: " + path);
+        }
+        if (header.keySize != sizeof(T) || header.weightSize != sizeof(U)) {
+            throw std::runtime_error("Graph file vertex or weight type mismatch: " + path);
+        }
+
+        // Each section must be aligned for its element type, follow the
+        // header and the previous section, and end within the file; the
+        // counts come from the file, so no arithmetic may overflow.
+        const auto V = header.numVertices;
+        const auto E = header.numEdges;
+        if (header.fileSize != file->size() ||
+            V >= DataStructures::Graphs::CSRGraph<T, U>::invalidVertex ||
+            header.keysOffset < sizeof(GraphFileHeader) ||
+            !Detail::sectionFits<T>(header.keysOffset, V, header.offsetsOffset) ||
+            !Detail::sectionFits<EdgeIndex>(header.offsetsOffset, V + 1, header.targetsOffset) ||
+            !Detail::sectionFits<VertexIndex>(header.targetsOffset, E, header.weightsOffset) ||
+            !Detail::sectionFits<U>(header.weightsOffset, E, header.fileSize)) {
+            throw std::runtime_error("Graph file is corrupt: " + path);
+        }
+
+        auto* base = file->data();
+        const std::span<const T> keys(reinterpret_cast<const T*>(base + header.keysOffset), V);
+        const std::span<const EdgeIndex> offsets(reinterpret_cast<const EdgeIndex*>(base + header.offsetsOffset), V + 1);
+        const std::span<const VertexIndex> targets(reinterpret_cast<const VertexIndex*>(base + header.targetsOffset), E);
+        const std::span<U> weights(reinterpret_cast<U*>(base + header.weightsOffset), E);
+
+        if (validate) {
+            bool valid = offsets.front() == 0 && offsets.back() == E;
+            for (size_t v = 0; valid && v < V; v++) {
+                valid = offsets[v] <= offsets[v + 1];
+            }
+            for (size_t e = 0; valid && e < E; e++) {
+                valid = targets[e] < V;
+            }
+            if (!valid) {
+                throw std::runtime_error("Graph file is corrupt: " + path);
+            }
+        }
+
+        return DataStructures::Graphs::CSRGraph<T, U>(
+            (header.flags & GraphFileHeader::directedFlag) != 0,
+            keys, offsets, targets, weights, std::move(file));
+    }
+}
+
+#endif
@@ -0,0 +1,158 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_IO_MEMORY_MAPPED_FILE
+#define CPP_UTILS_IO_MEMORY_MAPPED_FILE
+
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+#include <filesystem>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace CPPUtils::IO {
+
+    /**
+     * @brief A private, copy-on-write memory mapping of a whole file.
+     *
+     * The mapping is readable and writable, but writes are never carried
+     * back to the file on disk. On platforms without POSIX `mmap` the file
+     * is instead read into an owned buffer, with the same semantics.
+     */
+    class MemoryMappedFile final {
+    private:
+        std::byte* address;
+        size_t length;
+
+#if defined(_WIN32)
+        std::unique_ptr<std::max_align_t[]> buffer;
+#endif
+
+    public:
+        /**
+         * @brief Construct a new Memory Mapped File object mapping the file
+         * at `path`.
+         *
+         * @param path Path to the file to map.
+         */
+        explicit MemoryMappedFile(const std::string& path) :
+            address(nullptr),
+            length(0) {
+#if defined(_WIN32)
+            length = static_cast<size_t>(std::filesystem::file_size(path));
+            const auto n = (length + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+            buffer = std::make_unique<std::max_align_t[]>(n);
+            address = reinterpret_cast<std::byte*>(buffer.get());
+
+            std::ifstream file(path, std::ios::binary);
+            if (!file.read(reinterpret_cast<char*>(address), static_cast<std::streamsize>(length))) {
+                throw std::runtime_error("Unable to read file: " + path);
+            }
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) {
+                throw std::runtime_error("Unable to open file: " + path);
+            }
+
+            struct stat info;
+            if (::fstat(fd, &info) != 0) {
+                ::close(fd);
+                throw std::runtime_error("Unable to stat file: " + path);
+            }
+            length = static_cast<size_t>(info.st_size);
+
+            // Zero length mappings are invalid, so leave the address null.
+            if (length > 0) {
+                void* p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                if (p == MAP_FAILED) {
+                    ::close(fd);
+                    throw std::runtime_error("Unable to map file: " + path);
+                }
+                address = static_cast<std::byte*>(p);
+            }
+
+            // The mapping remains valid once the descriptor is closed.
+            ::close(fd);
+#endif
+        }
+
+        MemoryMappedFile(const MemoryMappedFile&) = delete;
+        MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+        ~MemoryMappedFile() {
+#if !defined(_WIN32)
+            if (address != nullptr) {
+                ::munmap(address, length);
+            }
+#endif
+        }
+
+        /**
+         * @brief Provides the start of the mapping.
+         *
+         * @return std::byte* The first byte of the file.
+         */
+        std::byte* data() {
+            return address;
+        }
+
+        /**
+         * @brief Provides the start of the mapping.
+         *
+         * @return const std::byte* The first byte of the file.
+         */
+        const std::byte* data() const {
+            return address;
+        }
+
+        /**
+         * @brief Provides the length of the mapping.
+         *
+         * @return size_t The file size in bytes.
+         */
+        size_t size() const {
+            return length;
+        }
+    };
+}
+
+#endif
@@ -91,7 +91,14 @@ namespace CPPUtils::Timing {
 
     template<typename T>
     inline std::vector<unsigned long long> getElapsed(const std::vector<std::pair<T, T>>& ticTocs) {
-        //
+        // Elapsed nanoseconds for each tic/toc pair.
+        std::vector<unsigned long long> elapsed;
+        elapsed.reserve(ticTocs.size());
+        for (const auto& [tic, toc] : ticTocs) {
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(toc - tic);
+            elapsed.push_back(static_cast<unsigned long long>(ns.count()));
+        }
+        return elapsed;
     }
 }
 
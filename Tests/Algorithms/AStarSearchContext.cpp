@@ -0,0 +1,151 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/Algorithms/AStarSearchContext.hpp>
+
+#include "TestGraphs.hpp"
+
+using namespace CPPUtils::Algorithms;
+using namespace CPPUtils::DataStructures::Graphs;
+
+class AStarSearchContextTestSuite : public ::testing::Test {
+ protected:
+    static constexpr int width = 20;
+
+    // A grid with random weights, vertex key y * width + x.
+    Graph<int> grid;
+
+    void SetUp() override {
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<double> weight(1.0, 4.0);
+        grid = TestGraphs::makeGrid(width, [&]() { return weight(rng); });
+    }
+};
+
+TEST_F(AStarSearchContextTestSuite, DijkstraMatchesReference) {
+    const CSRGraph<int> G(grid, 1);
+    AStarSearchContext<int> context(G);
+
+    std::mt19937 rng(5);
+    for (int query = 0; query < 20; query++) {
+        const auto s = static_cast<VertexIndex>(rng() % G.getVertexCardinality());
+        const auto t = static_cast<VertexIndex>(rng() % G.getVertexCardinality());
+        const auto expected = TestGraphs::referenceCosts(G, s);
+
+        ASSERT_TRUE(context.search(s, t));
+        EXPECT_NEAR(context.getCost(t), expected[t], 1e-9);
+
+        // The path must start at s, end at t and cost what was reported.
+        const auto path = context.getPath(t);
+        ASSERT_FALSE(path.empty());
+        EXPECT_EQ(path.front(), s);
+        EXPECT_EQ(path.back(), t);
+        double cost = 0;
+        for (size_t i = 1; i < path.size(); i++) {
+            const auto e = G.findEdge(path[i - 1], path[i]);
+            ASSERT_NE(e, CSRGraph<int>::invalidEdge);
+            cost += G.getWeights()[e];
+        }
+        EXPECT_NEAR(cost, expected[t], 1e-9);
+    }
+}
+
+TEST_F(AStarSearchContextTestSuite, HeuristicSearchTest) {
+    const CSRGraph<int> G(grid, 1);
+    AStarSearchContext<int> dijkstraContext(G);
+    AStarSearchContext<int> context(G);
+
+    // Every edge weighs at least 1, so Manhattan distance is consistent.
+    const auto manhattan = [](int a, int b) {
+        return static_cast<double>(TestGraphs::manhattan(a, b, width));
+    };
+
+    const auto source = 0;
+    const auto sink = width * width - 1;
+    const auto path = context.findPath(source, sink, manhattan);
+    ASSERT_FALSE(path.empty());
+    EXPECT_EQ(path.front(), source);
+    EXPECT_EQ(path.back(), sink);
+
+    const auto reference = dijkstraContext.findPath(source, sink);
+    const auto t = G.indexOf(sink);
+    EXPECT_NEAR(context.getCost(t), dijkstraContext.getCost(t), 1e-9);
+    EXPECT_LE(context.getSettledCount(), dijkstraContext.getSettledCount());
+}
+
+TEST_F(AStarSearchContextTestSuite, ReuseResetsStateTest) {
+    const CSRGraph<int> G(grid, 1);
+    AStarSearchContext<int> context(G);
+
+    // Nothing is reached before the first search.
+    EXPECT_FALSE(context.wasReached(0));
+    EXPECT_EQ(context.getCost(0), AStarSearchContext<int>::infinity);
+
+    // A search that stops at its source leaves the rest of the graph
+    // unreached, despite a previous search having reached it.
+    ASSERT_TRUE(context.search(0, static_cast<VertexIndex>(G.getVertexCardinality() - 1)));
+    EXPECT_TRUE(context.wasReached(1));
+    ASSERT_TRUE(context.search(1, 1));
+    EXPECT_EQ(context.getSettledCount(), 1u);
+    EXPECT_TRUE(context.wasSettled(1));
+    EXPECT_FALSE(context.wasSettled(0));
+    EXPECT_EQ(context.getCost(1), 0.0);
+    EXPECT_EQ(context.getPath(1), std::vector<VertexIndex>{1});
+
+    // Path buffers are reused.
+    std::vector<VertexIndex> path = {42, 42, 42};
+    context.getPath(static_cast<VertexIndex>(G.getVertexCardinality() - 1), path);
+    EXPECT_TRUE(path.empty());
+}
+
+TEST_F(AStarSearchContextTestSuite, UnreachableAndInvalidTest) {
+    DirectedGraph<int> D;
+    D.addEdge(1, 2, 1.0);
+    D.addEdge(2, 3, 1.0);
+    D.addVertex(4);
+    const CSRGraph<int> G(D, 1);
+    AStarSearchContext<int> context(G);
+
+    EXPECT_EQ(context.findPath(1, 3), std::vector<int>({1, 2, 3}));
+    EXPECT_TRUE(context.findPath(3, 1).empty());
+    EXPECT_TRUE(context.findPath(1, 4).empty());
+    EXPECT_TRUE(context.findPath(1, 99).empty());
+    EXPECT_TRUE(context.findPath(99, 1).empty());
+
+    EXPECT_FALSE(context.search(static_cast<VertexIndex>(G.getVertexCardinality()), 0));
+    EXPECT_EQ(context.getCost(0), AStarSearchContext<int>::infinity);
+}
@@ -0,0 +1,152 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/Algorithms/AStarSearchContext.hpp>
+#include <CPPUtils/Algorithms/BidirectionalSearch.hpp>
+
+#include "TestGraphs.hpp"
+
+using namespace CPPUtils::Algorithms;
+using namespace CPPUtils::DataStructures::Graphs;
+
+class BidirectionalSearchTestSuite : public ::testing::Test {
+ protected:
+    static constexpr int width = 24;
+
+    template<typename Context>
+    static std::int64_t pathCost(const CSRGraph<int, std::int64_t>& C, const Context& context) {
+        const auto path = context.getPath();
+        std::int64_t cost = 0;
+        for (size_t i = 1; i < path.size(); i++) {
+            const auto e = C.findEdge(path[i - 1], path[i]);
+            EXPECT_NE(e, (CSRGraph<int, std::int64_t>::invalidEdge));
+            cost += C.getWeights()[e];
+        }
+        return cost;
+    }
+
+    void SetUp() override {
+        //
+    }
+};
+
+TEST_F(BidirectionalSearchTestSuite, MatchesDijkstraTest) {
+    for (unsigned int seed = 0; seed < 3; seed++) {
+        const CSRGraph<int, std::int64_t> C(TestGraphs::makeRoads<std::int64_t>(width, seed), 1);
+        BidirectionalSearchContext<int, std::int64_t> context(C);
+
+        // Every edge weighs at least 1, so Manhattan distance is consistent.
+        const auto h = [&C](VertexIndex a, VertexIndex b) {
+            return static_cast<std::int64_t>(TestGraphs::manhattan(C.vertexAt(a), C.vertexAt(b), width));
+        };
+
+        std::mt19937 rng(seed);
+        for (int query = 0; query < 30; query++) {
+            const auto s = static_cast<VertexIndex>(rng() % C.getVertexCardinality());
+            const auto t = static_cast<VertexIndex>(rng() % C.getVertexCardinality());
+            const auto expected = TestGraphs::referenceCosts(C, s)[t];
+            const auto reached = !TestGraphs::unreachable(expected);
+
+            for (const auto parallel : { false, true }) {
+                ASSERT_EQ(context.search(s, t, parallel), reached);
+                if (!reached) {
+                    ASSERT_TRUE(context.getPath().empty());
+                    continue;
+                }
+                ASSERT_EQ(context.getCost(), expected);
+                ASSERT_EQ(context.getPath().front(), s);
+                ASSERT_EQ(context.getPath().back(), t);
+                ASSERT_EQ(pathCost(C, context), expected);
+
+                ASSERT_TRUE(context.search(s, t, h, parallel));
+                ASSERT_EQ(context.getCost(), expected);
+                ASSERT_EQ(pathCost(C, context), expected);
+            }
+        }
+    }
+}
+
+TEST_F(BidirectionalSearchTestSuite, ExploresLessTest) {
+    // An unweighted open grid; the unidirectional search settles a disc of
+    // radius d, the bidirectional one two discs of radius d / 2.
+    const auto G = TestGraphs::makeGrid(width, []() { return 1.0; });
+    const CSRGraph<int> C(G, 1);
+    AStarSearchContext<int> reference(C);
+    BidirectionalSearchContext<int> context(C);
+
+    const auto source = (width / 2) * width + 2;
+    const auto sink = (width / 2) * width + width - 3;
+    const auto path = context.findPath(source, sink);
+    ASSERT_EQ(path.size(), static_cast<size_t>(width - 4));
+    ASSERT_EQ(path.front(), source);
+    ASSERT_EQ(path.back(), sink);
+    ASSERT_EQ(context.getCost(), width - 5.0);
+
+    ASSERT_EQ(reference.findPath(source, sink).size(), path.size());
+    ASSERT_LT(context.getSettledCount(), reference.getSettledCount());
+
+    // A heuristic narrows the search further.
+    const auto settledDijkstra = context.getSettledCount();
+    const auto h = [](int a, int b) { return static_cast<double>(TestGraphs::manhattan(a, b, width)); };
+    ASSERT_EQ(context.findPath(source, sink, h).size(), path.size());
+    ASSERT_LT(context.getSettledCount(), settledDijkstra);
+    ASSERT_EQ(context.findPath(source, sink, h, true).size(), path.size());
+}
+
+TEST_F(BidirectionalSearchTestSuite, EdgeCasesTest) {
+    DirectedGraph<int> G;
+    G.addEdge(1, 2, 1.0);
+    G.addEdge(2, 3, 1.0);
+    G.addEdge(1, 3, 5.0);
+    G.addVertex(4);
+    const CSRGraph<int> C(G, 1);
+    BidirectionalSearchContext<int> context(C);
+
+    EXPECT_EQ(context.findPath(1, 3), std::vector<int>({ 1, 2, 3 }));
+    EXPECT_EQ(context.getCost(), 2.0);
+    EXPECT_EQ(context.findPath(2, 2), std::vector<int>({ 2 }));
+    EXPECT_EQ(context.getCost(), 0.0);
+
+    for (const auto parallel : { false, true }) {
+        EXPECT_TRUE(context.findPath(3, 1, parallel).empty());
+        EXPECT_EQ(context.getCost(), BidirectionalSearchContext<int>::infinity);
+        EXPECT_TRUE(context.findPath(1, 4, parallel).empty());
+    }
+    EXPECT_TRUE(context.findPath(1, 9).empty());
+    EXPECT_FALSE(context.search(0, static_cast<VertexIndex>(C.getVertexCardinality())));
+}
@@ -0,0 +1,219 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/Algorithms/Centrality.hpp>
+
+using namespace CPPUtils::Algorithms;
+using namespace CPPUtils::DataStructures::Graphs;
+
+class CentralityTestSuite : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        //
+    }
+};
+
+TEST_F(CentralityTestSuite, PageRankCycleTest) {
+    // A directed cycle has a uniform stationary distribution.
+    DirectedGraph<int> G;
+    for (int i = 0; i < 5; i++) {
+        G.addEdge(i, (i + 1) % 5, 1.0);
+    }
+
+    PageRank<int> P(G, 0.85, 1e-10, 200, false, 2);
+    ASSERT_TRUE(P.run());
+    ASSERT_TRUE(P.hasConverged());
+    ASSERT_LE(P.getCurrentIteration(), P.getMaxIterations());
+    ASSERT_EQ(P.getResidualHistory().size(), P.getCurrentIteration());
+
+    for (const auto& [v, r] : P.getRanks()) {
+        ASSERT_NEAR(r, 0.2, 1e-8);
+    }
+}
+
+TEST_F(CentralityTestSuite, PageRankStarTest) {
+    // Every leaf links to the hub, which is a dangling vertex.
+    DirectedGraph<int> G;
+    for (int i = 1; i <= 4; i++) {
+        G.addEdge(i, 0, 1.0);
+    }
+
+    PageRank<int> P(G);
+    P.run();
+
+    const auto R = P.getRanks();
+    for (int i = 1; i <= 4; i++) {
+        ASSERT_GT(R.at(0), R.at(i));
+        ASSERT_NEAR(R.at(1), R.at(i), 1e-9);
+    }
+
+    // Rank is conserved, including that of the dangling hub.
+    const auto V = P.getRankVector();
+    ASSERT_NEAR(std::accumulate(V.begin(), V.end(), 0.0), 1.0, 1e-9);
+}
+
+TEST_F(CentralityTestSuite, PageRankWeightedTest) {
+    // Vertex 0 sends most of its weight to 1.
+    DirectedGraph<int> G;
+    G.addEdge(0, 1, 9.0);
+    G.addEdge(0, 2, 1.0);
+    G.addEdge(1, 0, 1.0);
+    G.addEdge(2, 0, 1.0);
+
+    PageRank<int> weighted(G, 0.85, 1e-10, 200, true);
+    weighted.run();
+    const auto R = weighted.getRanks();
+    ASSERT_GT(R.at(1), R.at(2));
+
+    PageRank<int> unweighted(G, 0.85, 1e-10, 200, false);
+    unweighted.run();
+    const auto Q = unweighted.getRanks();
+    ASSERT_NEAR(Q.at(1), Q.at(2), 1e-9);
+}
+
+TEST_F(CentralityTestSuite, PageRankTiledTest) {
+    // A random graph, gathered in one pass and in tiles of a few sources.
+    DirectedGraph<int> G;
+    std::mt19937 rng(4);
+    for (int i = 0; i < 2000; i++) {
+        G.addEdge(static_cast<int>(rng() % 300), static_cast<int>(rng() % 300), 1.0 + rng() % 5);
+    }
+
+    PageRank<int> untiled(G, 0.85, 1e-12, 500, true, 2);
+    PageRank<int> tiled(G, 0.85, 1e-12, 500, true, 3);
+    tiled.setTileSize(7);
+    ASSERT_EQ(tiled.getTileSize(), 7);
+    ASSERT_THROW(tiled.setTileSize(0), std::invalid_argument);
+    untiled.run();
+    tiled.run();
+
+    const auto A = untiled.getRankVector();
+    const auto B = tiled.getRankVector();
+    ASSERT_EQ(A.size(), B.size());
+    for (size_t v = 0; v < A.size(); v++) {
+        ASSERT_NEAR(A[v], B[v], 1e-10);
+    }
+}
+
+TEST_F(CentralityTestSuite, PageRankResetTest) {
+    Graph<int> G;
+    G.addEdge(0, 1, 1.0);
+
+    PageRank<int> P(G, 0.85, 1e-6, 3);
+    P.run();
+    ASSERT_FALSE(P.getResidualHistory().empty());
+
+    P.reset();
+    ASSERT_TRUE(P.getResidualHistory().empty());
+    ASSERT_EQ(P.getCurrentIteration(), 0);
+    ASSERT_FALSE(P.hasConverged());
+}
+
+TEST_F(CentralityTestSuite, DegreeCentralityTest) {
+    DirectedGraph<int> G;
+    G.addEdge(0, 1, 1.0);
+    G.addEdge(0, 2, 1.0);
+    G.addEdge(1, 2, 1.0);
+
+    const auto out = degreeCentrality(G);
+    ASSERT_DOUBLE_EQ(out.at(0), 1.0);
+    ASSERT_DOUBLE_EQ(out.at(1), 0.5);
+    ASSERT_DOUBLE_EQ(out.at(2), 0.0);
+
+    const auto in = inDegreeCentrality(G);
+    ASSERT_DOUBLE_EQ(in.at(0), 0.0);
+    ASSERT_DOUBLE_EQ(in.at(1), 0.5);
+    ASSERT_DOUBLE_EQ(in.at(2), 1.0);
+}
+
+TEST_F(CentralityTestSuite, BetweennessPathTest) {
+    // 0 - 1 - 2 - 3
+    Graph<int> G;
+    G.addEdge(0, 1, 1.0);
+    G.addEdge(1, 2, 1.0);
+    G.addEdge(2, 3, 1.0);
+
+    const auto B = betweennessCentrality(G, false, 3);
+    ASSERT_DOUBLE_EQ(B.at(0), 0.0);
+    ASSERT_DOUBLE_EQ(B.at(1), 2.0);
+    ASSERT_DOUBLE_EQ(B.at(2), 2.0);
+    ASSERT_DOUBLE_EQ(B.at(3), 0.0);
+}
+
+TEST_F(CentralityTestSuite, BetweennessDirectedTest) {
+    DirectedGraph<int> G;
+    G.addEdge(0, 1, 1.0);
+    G.addEdge(1, 2, 1.0);
+
+    const auto B = betweennessCentrality(G);
+    ASSERT_DOUBLE_EQ(B.at(0), 0.0);
+    ASSERT_DOUBLE_EQ(B.at(1), 1.0);
+    ASSERT_DOUBLE_EQ(B.at(2), 0.0);
+}
+
+TEST_F(CentralityTestSuite, BetweennessWeightedTest) {
+    // Two routes from 0 to 3; via 1 is cheaper, via 2 has fewer hops.
+    Graph<int> G;
+    G.addEdge(0, 1, 1.0);
+    G.addEdge(1, 4, 1.0);
+    G.addEdge(4, 3, 1.0);
+    G.addEdge(0, 2, 10.0);
+    G.addEdge(2, 3, 10.0);
+
+    const auto hops = betweennessCentrality(G, false);
+    ASSERT_GT(hops.at(2), 0.0);
+
+    const auto weighted = betweennessCentrality(G, true, 2);
+    ASSERT_DOUBLE_EQ(weighted.at(2), 0.0);
+    ASSERT_GT(weighted.at(1), 0.0);
+}
+
+TEST_F(CentralityTestSuite, BetweennessRoundingTest) {
+    // Both routes from 0 to 3 cost 0.3, but 0.1 + 0.2 rounds differently
+    // to 0.15 + 0.15, so neither may be dropped.
+    DirectedGraph<int> G;
+    G.addEdge(0, 1, 0.1);
+    G.addEdge(1, 3, 0.2);
+    G.addEdge(0, 2, 0.15);
+    G.addEdge(2, 3, 0.15);
+    ASSERT_NE(0.1 + 0.2, 0.15 + 0.15);
+
+    const auto B = betweennessCentrality(G, true);
+    ASSERT_DOUBLE_EQ(B.at(1), 0.5);
+    ASSERT_DOUBLE_EQ(B.at(2), 0.5);
+}
@@ -0,0 +1,156 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/Algorithms/ConnectedComponents.hpp>
+
+using namespace CPPUtils::Algorithms;
+using namespace CPPUtils::DataStructures::Graphs;
+
+class ConnectedComponentsTestSuite : public ::testing::Test {
+ protected:
+    Graph<int> G;
+    DirectedGraph<int> D;
+
+    void SetUp() override {
+        // Three undirected components: {0, 1, 2}, {3, 4} and {5}.
+        G.addEdge(0, 1, 1.0);
+        G.addEdge(1, 2, 1.0);
+        G.addEdge(3, 4, 1.0);
+        G.addVertex(5);
+
+        // Directed cycles {0, 1, 2} and {3, 4}, joined by 2 -> 3, plus a
+        // sink vertex 5.
+        D.addEdge(0, 1, 1.0);
+        D.addEdge(1, 2, 1.0);
+        D.addEdge(2, 0, 1.0);
+        D.addEdge(2, 3, 1.0);
+        D.addEdge(3, 4, 1.0);
+        D.addEdge(4, 3, 1.0);
+        D.addEdge(4, 5, 1.0);
+    }
+};
+
+TEST_F(ConnectedComponentsTestSuite, UnionFindTest) {
+    ConcurrentUnionFind sets(6);
+    ASSERT_EQ(sets.size(), 6);
+
+    ASSERT_TRUE(sets.unite(0, 1));
+    ASSERT_TRUE(sets.unite(4, 5));
+    ASSERT_TRUE(sets.unite(1, 5));
+    ASSERT_FALSE(sets.unite(0, 4));
+
+    ASSERT_TRUE(sets.sameSet(0, 5));
+    ASSERT_FALSE(sets.sameSet(0, 2));
+    ASSERT_EQ(sets.find(5), 0);
+}
+
+TEST_F(ConnectedComponentsTestSuite, ConcurrentUnionFindTest) {
+    // Each thread chains together its own stride of elements.
+    constexpr size_t N = 4096;
+    constexpr size_t T = 4;
+
+    ConcurrentUnionFind sets(N);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < T; t++) {
+        workers.emplace_back([&sets, t]() {
+            for (size_t i = t; i + T < N; i += T) {
+                sets.unite(i, i + T);
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    for (size_t i = 0; i < N; i++) {
+        ASSERT_EQ(sets.find(i), i % T);
+    }
+}
+
+TEST_F(ConnectedComponentsTestSuite, ConnectedComponentsTest) {
+    const auto C = connectedComponents(G, 4);
+    ASSERT_EQ(C.numComponents, 3);
+    ASSERT_EQ(C.labels.size(), 6);
+
+    ASSERT_EQ(C.labels.at(0), C.labels.at(1));
+    ASSERT_EQ(C.labels.at(1), C.labels.at(2));
+    ASSERT_EQ(C.labels.at(3), C.labels.at(4));
+    ASSERT_NE(C.labels.at(0), C.labels.at(3));
+    ASSERT_NE(C.labels.at(0), C.labels.at(5));
+    ASSERT_NE(C.labels.at(3), C.labels.at(5));
+
+    // Labels must be dense.
+    for (const auto& [v, label] : C.labels) {
+        ASSERT_LT(label, C.numComponents);
+    }
+}
+
+TEST_F(ConnectedComponentsTestSuite, WeaklyConnectedComponentsTest) {
+    const auto C = connectedComponents(D);
+    ASSERT_EQ(C.numComponents, 1);
+}
+
+TEST_F(ConnectedComponentsTestSuite, EmptyGraphTest) {
+    const Graph<int> E;
+    ASSERT_EQ(connectedComponents(E).numComponents, 0);
+    ASSERT_EQ(stronglyConnectedComponents(E).numComponents, 0);
+}
+
+TEST_F(ConnectedComponentsTestSuite, StronglyConnectedComponentsTest) {
+    const auto C = stronglyConnectedComponents(D);
+    ASSERT_EQ(C.numComponents, 3);
+
+    ASSERT_EQ(C.labels.at(0), C.labels.at(1));
+    ASSERT_EQ(C.labels.at(1), C.labels.at(2));
+    ASSERT_EQ(C.labels.at(3), C.labels.at(4));
+
+    // Reverse topological order - sinks complete first.
+    ASSERT_LT(C.labels.at(5), C.labels.at(3));
+    ASSERT_LT(C.labels.at(3), C.labels.at(0));
+
+    std::set<size_t> distinct;
+    for (const auto& [v, label] : C.labels) {
+        distinct.insert(label);
+    }
+    ASSERT_EQ(distinct.size(), 3);
+}
+
+TEST_F(ConnectedComponentsTestSuite, StronglyConnectedUndirectedTest) {
+    const auto C = stronglyConnectedComponents(G);
+    ASSERT_EQ(C.numComponents, 3);
+}
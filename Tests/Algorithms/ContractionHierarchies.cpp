@@ -0,0 +1,276 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/Algorithms/AStarSearchContext.hpp>
+#include <CPPUtils/Algorithms/ContractionHierarchies.hpp>
+
+#include "TestGraphs.hpp"
+
+using namespace CPPUtils::Algorithms;
+using namespace CPPUtils::DataStructures::Graphs;
+
+class ContractionHierarchiesTestSuite : public ::testing::Test {
+ protected:
+    std::filesystem::path fname;
+
+    void SetUp() override {
+        fname = std::filesystem::temp_directory_path() / "test_hierarchy.bin";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(fname);
+    }
+
+    // Checks every query against Dijkstra on the original graph, including
+    // that the unpacked path uses only original edges and has the same cost.
+    template<typename U>
+    static void verifyQueries(const CSRGraph<int, U>& C, const ContractionHierarchy<int, U>& H, unsigned int seed) {
+        ContractionHierarchyQuery<int, U> query(H);
+
+        std::mt19937 rng(seed);
+        for (int i = 0; i < 100; i++) {
+            const auto s = C.vertexAt(static_cast<VertexIndex>(rng() % C.getVertexCardinality()));
+            const auto t = C.vertexAt(static_cast<VertexIndex>(rng() % C.getVertexCardinality()));
+            const auto expected = TestGraphs::referenceCosts(C, C.indexOf(s))[C.indexOf(t)];
+            const auto path = query.findPath(s, t);
+            ASSERT_EQ(path.empty(), TestGraphs::unreachable(expected));
+            if (path.empty()) {
+                ASSERT_EQ(query.getCost(), (ContractionHierarchyQuery<int, U>::infinity));
+                continue;
+            }
+
+            ASSERT_EQ(path.front(), s);
+            ASSERT_EQ(path.back(), t);
+            // The lightest of any parallel edges is the one used.
+            U cost = 0;
+            for (size_t j = 1; j < path.size(); j++) {
+                const auto a = C.indexOf(path[j - 1]);
+                const auto b = C.indexOf(path[j]);
+                const auto Na = C.neighbours(a);
+                const auto Wa = C.neighbourWeights(a);
+                auto lightest = ContractionHierarchyQuery<int, U>::infinity;
+                for (size_t k = 0; k < Na.size(); k++) {
+                    if (Na[k] == b) {
+                        lightest = std::min(lightest, Wa[k]);
+                    }
+                }
+                ASSERT_NE(lightest, (ContractionHierarchyQuery<int, U>::infinity));
+                cost += lightest;
+            }
+            ASSERT_EQ(cost, expected);
+            ASSERT_EQ(query.getCost(), cost);
+        }
+    }
+};
+
+TEST_F(ContractionHierarchiesTestSuite, DirectedQueriesTest) {
+    for (unsigned int seed = 0; seed < 3; seed++) {
+        const CSRGraph<int, std::uint32_t> C(TestGraphs::makeRoads(20, seed), 1);
+        for (const auto numThreads : { 1u, 3u }) {
+            const ContractionHierarchy<int, std::uint32_t> H(C, numThreads);
+            ASSERT_EQ(H.getVertexCardinality(), C.getVertexCardinality());
+            verifyQueries(C, H, seed);
+        }
+    }
+}
+
+TEST_F(ContractionHierarchiesTestSuite, UndirectedQueriesTest) {
+    std::mt19937 rng(9);
+    Graph<int> G;
+    for (int v = 0; v < 300; v++) {
+        G.addVertex(v);
+    }
+    // Weights are exact binary fractions, so costs compare exactly.
+    for (int i = 0; i < 900; i++) {
+        G.addEdge(static_cast<int>(rng() % 300), static_cast<int>(rng() % 300), 0.5 + (rng() % 100) * 0.25);
+    }
+
+    const ContractionHierarchy<int> H(G, 2);
+    verifyQueries(CSRGraph<int>(G, 1), H, 4);
+
+    // Ranks are a permutation, and arcs only lead upward.
+    std::vector<bool> seen(H.getVertexCardinality(), false);
+    for (VertexIndex v = 0; v < H.getVertexCardinality(); v++) {
+        ASSERT_FALSE(seen[H.getRank(v)]);
+        seen[H.getRank(v)] = true;
+
+        const auto& up = H.getUpwardGraph();
+        for (auto e = up.offsets[v]; e < up.offsets[v + 1]; e++) {
+            ASSERT_GT(H.getRank(up.targets[e]), H.getRank(v));
+        }
+        const auto& down = H.getDownwardGraph();
+        for (auto e = down.offsets[v]; e < down.offsets[v + 1]; e++) {
+            ASSERT_GT(H.getRank(down.targets[e]), H.getRank(v));
+        }
+    }
+}
+
+TEST_F(ContractionHierarchiesTestSuite, QuerySettlesFewVerticesTest) {
+    const CSRGraph<int, std::uint32_t> C(TestGraphs::makeRoads(40, 1), 1);
+    const ContractionHierarchy<int, std::uint32_t> H(C, 2);
+    AStarSearchContext<int, std::uint32_t> reference(C);
+    ContractionHierarchyQuery<int, std::uint32_t> query(H);
+
+    size_t settledDijkstra = 0;
+    size_t settledHierarchy = 0;
+    std::mt19937 rng(2);
+    for (int i = 0; i < 50; i++) {
+        const auto s = static_cast<VertexIndex>(rng() % C.getVertexCardinality());
+        const auto t = static_cast<VertexIndex>(rng() % C.getVertexCardinality());
+        reference.search(s, t);
+        query.search(s, t);
+        settledDijkstra += reference.getSettledCount();
+        settledHierarchy += query.getSettledCount();
+    }
+    ASSERT_LT(settledHierarchy, settledDijkstra);
+}
+
+TEST_F(ContractionHierarchiesTestSuite, EdgeCasesTest) {
+    DirectedGraph<int> G;
+    G.addEdge(1, 2, 1.0);
+    G.addEdge(2, 3, 1.0);
+    G.addEdge(3, 3, 1.0);
+    G.addVertex(4);
+    const ContractionHierarchy<int> H(G, 1);
+    ContractionHierarchyQuery<int> query(H);
+
+    ASSERT_EQ(query.findPath(1, 3), std::vector<int>({ 1, 2, 3 }));
+    ASSERT_EQ(query.getCost(), 2.0);
+    ASSERT_EQ(query.findPath(3, 3), std::vector<int>({ 3 }));
+    ASSERT_EQ(query.getCost(), 0.0);
+    ASSERT_TRUE(query.findPath(3, 1).empty());
+    ASSERT_TRUE(query.findPath(1, 4).empty());
+    ASSERT_TRUE(query.findPath(1, 5).empty());
+
+    DirectedGraph<int> N;
+    N.addEdge(1, 2, -1.0);
+    ASSERT_THROW(ContractionHierarchy<int>(N, 1), std::invalid_argument);
+
+    const ContractionHierarchy<int> E{ DirectedGraph<int>() };
+    ASSERT_EQ(E.getVertexCardinality(), 0u);
+}
+
+TEST_F(ContractionHierarchiesTestSuite, SaveLoadTest) {
+    const CSRGraph<int, std::uint32_t> C(TestGraphs::makeRoads(16, 5), 1);
+    const ContractionHierarchy<int, std::uint32_t> H(C, 2);
+    H.save(fname.string());
+
+    const auto L = ContractionHierarchy<int, std::uint32_t>::load(fname.string());
+    ASSERT_EQ(L.getVertexCardinality(), H.getVertexCardinality());
+    ASSERT_EQ(L.getShortcutCount(), H.getShortcutCount());
+    for (VertexIndex v = 0; v < H.getVertexCardinality(); v++) {
+        ASSERT_EQ(L.vertexAt(v), H.vertexAt(v));
+        ASSERT_EQ(L.getRank(v), H.getRank(v));
+        ASSERT_EQ(L.indexOf(H.vertexAt(v)), v);
+    }
+    verifyQueries(C, L, 5);
+
+    // Mismatched types and damaged files are rejected.
+    ASSERT_THROW((ContractionHierarchy<int, double>::load(fname.string())), std::runtime_error);
+    std::filesystem::resize_file(fname, std::filesystem::file_size(fname) - 4);
+    ASSERT_THROW((ContractionHierarchy<int, std::uint32_t>::load(fname.string())), std::runtime_error);
+    {
+        std::ofstream file(fname, std::ios::binary | std::ios::trunc);
+        file << "not a hierarchy file at all, but long enough to hold a header";
+    }
+    ASSERT_THROW((ContractionHierarchy<int, std::uint32_t>::load(fname.string())), std::runtime_error);
+    ASSERT_THROW((ContractionHierarchy<int, std::uint32_t>::load("/nonexistent/hierarchy.bin")), std::runtime_error);
+}
+
+TEST_F(ContractionHierarchiesTestSuite, CorruptLoadTest) {
+    const CSRGraph<int, std::uint32_t> C(TestGraphs::makeRoads(8, 3), 1);
+    const ContractionHierarchy<int, std::uint32_t> H(C, 1);
+    ASSERT_GT(H.getShortcutCount(), 0u);
+    H.save(fname.string());
+
+    std::vector<char> bytes(std::filesystem::file_size(fname));
+    {
+        std::ifstream file(fname, std::ios::binary);
+        file.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    ContractionHierarchyFileHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    const auto N = header.numVertices;
+    const auto M = header.numUpwardArcs;
+    const auto targetsAt = sizeof(header) + N * (sizeof(int) + sizeof(VertexIndex)) + (N + 1) * sizeof(EdgeIndex);
+    const auto middlesAt = targetsAt + M * sizeof(VertexIndex);
+
+    // Writes `bytes` with a value patched in, and checks it is rejected.
+    const auto rejects = [&](size_t at, auto value) {
+        auto patched = bytes;
+        std::memcpy(patched.data() + at, &value, sizeof(value));
+        {
+            std::ofstream file(fname, std::ios::binary | std::ios::trunc);
+            file.write(patched.data(), static_cast<std::streamsize>(patched.size()));
+        }
+        ASSERT_THROW((ContractionHierarchy<int, std::uint32_t>::load(fname.string())), std::runtime_error);
+    };
+
+    // Find a shortcut among the upward arcs.
+    size_t e = 0;
+    for (; e < M; e++) {
+        VertexIndex middle;
+        std::memcpy(&middle, bytes.data() + middlesAt + e * sizeof(VertexIndex), sizeof(middle));
+        if (middle != (ContractionHierarchy<int, std::uint32_t>::invalidVertex)) {
+            break;
+        }
+    }
+    ASSERT_LT(e, M);
+
+    // A middle out of range, or at an end of its own arc.
+    VertexIndex target;
+    std::memcpy(&target, bytes.data() + targetsAt + e * sizeof(VertexIndex), sizeof(target));
+    rejects(middlesAt + e * sizeof(VertexIndex), static_cast<VertexIndex>(N));
+    rejects(middlesAt + e * sizeof(VertexIndex), target);
+
+    // Duplicate ranks.
+    const auto ranksAt = sizeof(header) + N * sizeof(int);
+    rejects(ranksAt, static_cast<VertexIndex>(H.getRank(1)));
+
+    // Arc counts whose byte size wraps around.
+    const std::uint64_t wrap = (std::numeric_limits<std::uint64_t>::max)() / 12 + 1;
+    rejects(offsetof(ContractionHierarchyFileHeader, numUpwardArcs), wrap);
+    rejects(offsetof(ContractionHierarchyFileHeader, numDownwardArcs), (std::numeric_limits<std::uint64_t>::max)());
+}
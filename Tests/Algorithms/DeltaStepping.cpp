@@ -0,0 +1,134 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/Algorithms/DeltaStepping.hpp>
+
+#include "TestGraphs.hpp"
+
+using namespace CPPUtils::Algorithms;
+using namespace CPPUtils::DataStructures::Graphs;
+
+class DeltaSteppingTestSuite : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        //
+    }
+
+    template<typename U>
+    static DirectedGraph<int, U> makeGraph(int N, int E, unsigned int seed, U maxWeight) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> weight(0.0, static_cast<double>(maxWeight));
+        DirectedGraph<int, U> G;
+        for (int v = 0; v < N; v++) {
+            G.addVertex(v);
+        }
+        for (int i = 0; i < E; i++) {
+            G.addEdge(static_cast<int>(rng() % N), static_cast<int>(rng() % N), static_cast<U>(weight(rng)));
+        }
+        return G;
+    }
+};
+
+TEST_F(DeltaSteppingTestSuite, IntegerWeightsTest) {
+    const CSRGraph<int, std::uint32_t> C(makeGraph<std::uint32_t>(2000, 8000, 1, 100), 1);
+    for (const VertexIndex source : { 0u, 17u, 1999u }) {
+        const auto expected = TestGraphs::referenceCosts(C, source);
+        for (const std::uint32_t delta : { 0u, 1u, 7u, 50u, 1000000u }) {
+            for (const auto numThreads : { 1u, 4u }) {
+                ASSERT_EQ(deltaStepping(C, source, delta, numThreads), expected);
+            }
+        }
+    }
+}
+
+TEST_F(DeltaSteppingTestSuite, FloatingWeightsTest) {
+    const CSRGraph<int> C(makeGraph<double>(3000, 15000, 2, 10.0), 1);
+    const auto expected = TestGraphs::referenceCosts(C, 5);
+    for (const double delta : { 0.0, 0.1, 2.5, 1e9 }) {
+        for (const auto numThreads : { 1u, 4u }) {
+            ASSERT_EQ(deltaStepping(C, 5, delta, numThreads), expected);
+        }
+    }
+}
+
+TEST_F(DeltaSteppingTestSuite, HeavyEdgesTest) {
+    // Light random edges, plus a few so heavy that buckets up to the
+    // largest cost could never all be held.
+    auto G = makeGraph<std::uint64_t>(2000, 8000, 3, 100);
+    std::mt19937 rng(4);
+    for (int i = 0; i < 20; i++) {
+        G.addEdge(static_cast<int>(rng() % 2000), static_cast<int>(rng() % 2000),
+                  (std::uint64_t(1) << 50) + rng());
+    }
+    G.addEdge(0, 2000, std::uint64_t(1) << 60);
+    G.addEdge(2000, 2001, 1);
+    G.addEdge(2001, 2002, std::uint64_t(1) << 55);
+
+    const CSRGraph<int, std::uint64_t> C(G, 1);
+    const auto expected = TestGraphs::referenceCosts(C, 0);
+    for (const std::uint64_t delta : { 0ull, 1ull, 64ull }) {
+        for (const auto numThreads : { 1u, 4u }) {
+            ASSERT_EQ(deltaStepping(C, 0, delta, numThreads), expected);
+        }
+    }
+}
+
+TEST_F(DeltaSteppingTestSuite, KeyedAndEdgeCasesTest) {
+    DirectedGraph<int> G;
+    G.addEdge(1, 2, 1.0);
+    G.addEdge(2, 3, 2.0);
+    G.addEdge(1, 3, 5.0);
+    G.addEdge(3, 3, 0.0);
+    G.addVertex(4);
+
+    const auto costs = deltaStepping(G, 1, 0.0, 2);
+    ASSERT_EQ(costs.size(), 4u);
+    ASSERT_EQ(costs.at(1), 0.0);
+    ASSERT_EQ(costs.at(2), 1.0);
+    ASSERT_EQ(costs.at(3), 3.0);
+    ASSERT_EQ(costs.at(4), std::numeric_limits<double>::infinity());
+
+    // An unknown source reaches nothing.
+    for (const auto& [v, cost] : deltaStepping(G, 9)) {
+        ASSERT_EQ(cost, std::numeric_limits<double>::infinity());
+    }
+
+    G.addEdge(4, 1, -1.0);
+    ASSERT_THROW(deltaStepping(G, 1), std::invalid_argument);
+}
@@ -0,0 +1,149 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/Algorithms/DistanceMatrix.hpp>
+
+using namespace CPPUtils::Algorithms;
+using namespace CPPUtils::DataStructures::Graphs;
+
+class DistanceMatrixTestSuite : public ::testing::Test {
+ protected:
+    // A random directed graph, with a few vertices unreachable.
+    DirectedGraph<int, std::uint32_t> G;
+
+    void SetUp() override {
+        std::mt19937 rng(21);
+        for (int v = 0; v < 200; v++) {
+            G.addVertex(v);
+        }
+        for (int i = 0; i < 800; i++) {
+            G.addEdge(static_cast<int>(rng() % 190), static_cast<int>(rng() % 200), 1 + rng() % 50);
+        }
+    }
+};
+
+TEST_F(DistanceMatrixTestSuite, ManyToManyMatchesDijkstraTest) {
+    const CSRGraph<int, std::uint32_t> C(G, 1);
+    AStarSearchContext<int, std::uint32_t> reference(C);
+
+    std::mt19937 rng(4);
+    std::vector<VertexIndex> sources;
+    std::vector<VertexIndex> targets;
+    for (int i = 0; i < 20; i++) {
+        sources.push_back(static_cast<VertexIndex>(rng() % C.getVertexCardinality()));
+        targets.push_back(static_cast<VertexIndex>(rng() % C.getVertexCardinality()));
+    }
+
+    // Repeated targets, and an out of range one.
+    targets.push_back(targets.front());
+    targets.push_back(static_cast<VertexIndex>(C.getVertexCardinality()));
+
+    for (const auto numThreads : { 1u, 3u }) {
+        const auto D = manyToMany(C, std::span<const VertexIndex>(sources), std::span<const VertexIndex>(targets), numThreads);
+        ASSERT_EQ(D.rows, sources.size());
+        ASSERT_EQ(D.columns, targets.size());
+
+        for (size_t i = 0; i < sources.size(); i++) {
+            for (size_t j = 0; j < targets.size(); j++) {
+                reference.search(sources[i], targets[j]);
+                ASSERT_EQ(D(i, j), reference.getCost(targets[j]));
+            }
+            ASSERT_EQ(D.row(i).size(), targets.size());
+            ASSERT_EQ(D.row(i)[0], D(i, 0));
+        }
+    }
+}
+
+TEST_F(DistanceMatrixTestSuite, OneToManySearchTest) {
+    const CSRGraph<int, std::uint32_t> C(G, 1);
+    OneToManySearch<int, std::uint32_t> search(C);
+    AStarSearchContext<int, std::uint32_t> reference(C);
+
+    // Reuse across queries with different target sets.
+    for (VertexIndex s = 0; s < 10; s++) {
+        const std::vector<VertexIndex> targets = { s, static_cast<VertexIndex>(s + 7), 150, 195, 150 };
+        const auto distances = search.search(s, targets);
+        for (size_t j = 0; j < targets.size(); j++) {
+            reference.search(s, targets[j]);
+            ASSERT_EQ(distances[j], reference.getCost(targets[j]));
+        }
+        ASSERT_EQ(distances[0], 0u);
+    }
+
+    // The search stops once the targets are settled.
+    const std::vector<VertexIndex> own = { 3 };
+    ASSERT_EQ(search.search(3, own)[0], 0u);
+    ASSERT_EQ(search.getContext().getSettledCount(), 1u);
+
+    std::vector<std::uint32_t> tooShort(1);
+    const std::vector<VertexIndex> two = { 1, 2 };
+    ASSERT_THROW(search.search(0, two, tooShort), std::invalid_argument);
+}
+
+TEST_F(DistanceMatrixTestSuite, KeyedTest) {
+    Graph<int> U;
+    U.addEdge(1, 2, 1.0);
+    U.addEdge(2, 3, 2.0);
+    U.addEdge(1, 3, 5.0);
+    U.addVertex(4);
+
+    const auto D = manyToMany(U, { 1, 3, 9 }, { 1, 2, 3, 4 }, 2);
+    ASSERT_EQ(D(0, 0), 0.0);
+    ASSERT_EQ(D(0, 1), 1.0);
+    ASSERT_EQ(D(0, 2), 3.0);
+    ASSERT_TRUE(std::isinf(D(0, 3)));
+    ASSERT_EQ(D(1, 0), 3.0);
+    for (size_t j = 0; j < D.columns; j++) {
+        ASSERT_TRUE(std::isinf(D(2, j)));
+    }
+
+    ASSERT_EQ(oneToMany(U, 2, { 1, 3 }), std::vector<double>({ 1.0, 2.0 }));
+
+    // Writing into a caller supplied row-major buffer.
+    const CSRGraph<int> C(U, 1);
+    const std::vector<VertexIndex> sources = { C.indexOf(1) };
+    const std::vector<VertexIndex> targets = { C.indexOf(3) };
+    std::vector<double> buffer(1);
+    manyToMany(C, std::span<const VertexIndex>(sources), std::span<const VertexIndex>(targets), std::span<double>(buffer), 1);
+    ASSERT_EQ(buffer[0], 3.0);
+    std::vector<double> wrongSize(2);
+    ASSERT_THROW(manyToMany(C, std::span<const VertexIndex>(sources), std::span<const VertexIndex>(targets), std::span<double>(wrongSize), 1),
+                 std::invalid_argument);
+}
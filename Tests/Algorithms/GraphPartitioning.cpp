@@ -0,0 +1,150 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/Algorithms/GraphPartitioning.hpp>
+
+using namespace CPPUtils::Algorithms;
+using namespace CPPUtils::DataStructures::Graphs;
+
+class GraphPartitioningTestSuite : public ::testing::Test {
+ protected:
+    Graph<int> G;
+
+    void SetUp() override {
+        // Two 5-cliques, {0..4} and {5..9}, joined by the edge 4 - 5.
+        for (int c = 0; c < 10; c += 5) {
+            for (int i = c; i < c + 5; i++) {
+                for (int j = i + 1; j < c + 5; j++) {
+                    G.addEdge(i, j, 1.0);
+                }
+            }
+        }
+        G.addEdge(4, 5, 2.0);
+    }
+};
+
+TEST_F(GraphPartitioningTestSuite, TwoCliquesTest) {
+    const auto P = partitionGraph(G, 2, 0.0, 20, 2);
+    ASSERT_EQ(P.parts.size(), 2);
+    ASSERT_EQ(P.assignment.size(), 10);
+    ASSERT_EQ(P.edgeCut, 1);
+
+    // Each clique lies entirely in one part.
+    for (int i = 1; i < 5; i++) {
+        ASSERT_EQ(P.assignment.at(i), P.assignment.at(0));
+        ASSERT_EQ(P.assignment.at(5 + i), P.assignment.at(5));
+    }
+    ASSERT_NE(P.assignment.at(0), P.assignment.at(5));
+
+    for (size_t p = 0; p < 2; p++) {
+        const auto& part = P.parts[p];
+        ASSERT_EQ(part.subgraph.getVertexCardinality(), 5);
+        ASSERT_FALSE(part.subgraph.isDirected());
+        ASSERT_EQ(part.boundary.size(), 1);
+        ASSERT_EQ(part.ghosts.size(), 1);
+        ASSERT_EQ(part.cutEdges.size(), 1);
+        ASSERT_EQ(part.cutEdges[0].weight, 2.0);
+
+        // Internal edges are kept exactly once.
+        for (const auto& v : part.subgraph.getVertices()) {
+            ASSERT_EQ(part.subgraph.getAdjacencyList(v).size(), 4);
+        }
+    }
+
+    const auto& a = P.parts[P.assignment.at(4)];
+    ASSERT_EQ(a.boundary[0], 4);
+    ASSERT_EQ(a.ghosts.at(5), P.assignment.at(5));
+}
+
+TEST_F(GraphPartitioningTestSuite, BalanceTest) {
+    // A path of 100 vertices into 4 parts.
+    Graph<int> L;
+    for (int i = 0; i < 99; i++) {
+        L.addEdge(i, i + 1, 1.0);
+    }
+
+    const auto P = partitionGraph(L, 4, 0.1);
+    size_t total = 0;
+    for (const auto& part : P.parts) {
+        ASSERT_LE(part.subgraph.getVertexCardinality(), 28);
+        total += part.subgraph.getVertexCardinality();
+    }
+    ASSERT_EQ(total, 100);
+
+    // Contiguous seeding of a path cuts it only at the part boundaries.
+    ASSERT_EQ(P.edgeCut, 3);
+}
+
+TEST_F(GraphPartitioningTestSuite, DirectedTest) {
+    DirectedGraph<int> D;
+    D.addEdge(0, 1, 1.0);
+    D.addEdge(1, 2, 1.0);
+    D.addEdge(2, 3, 1.0);
+    D.addEdge(3, 0, 1.0);
+
+    const auto P = partitionGraph(D, 2);
+    ASSERT_EQ(P.edgeCut, 2);
+    for (const auto& part : P.parts) {
+        ASSERT_TRUE(part.subgraph.isDirected());
+        ASSERT_EQ(part.subgraph.getVertexCardinality(), 2);
+    }
+}
+
+TEST_F(GraphPartitioningTestSuite, TrivialPartitionsTest) {
+    const auto P = partitionGraph(G, 1);
+    ASSERT_EQ(P.edgeCut, 0);
+    ASSERT_EQ(P.parts[0].subgraph.getVertexCardinality(), 10);
+    ASSERT_TRUE(P.parts[0].boundary.empty());
+
+    ASSERT_THROW(partitionGraph(G, 0), std::invalid_argument);
+
+    const Graph<int> E;
+    ASSERT_TRUE(partitionGraph(E, 3).assignment.empty());
+}
+
+TEST_F(GraphPartitioningTestSuite, DedupeSelfLoopTest) {
+    // Under DEDUPE an undirected self-loop is stored once, not twice.
+    Graph<int> H;
+    H.setMultiEdgePolicy(MultiEdgePolicy::DEDUPE);
+    H.addEdge(1, 1, 2.0);
+    H.addEdge(1, 2, 1.0);
+    ASSERT_EQ(H.getEdgeCardinality(), 3);
+
+    const auto P = partitionGraph(H, 1);
+    ASSERT_EQ(P.parts[0].subgraph.getEdgeCardinality(), 3);
+    ASSERT_EQ(P.parts[0].subgraph.getMultiEdgePolicy(), MultiEdgePolicy::DEDUPE);
+}
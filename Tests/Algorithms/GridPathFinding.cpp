@@ -0,0 +1,290 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/Algorithms/GridPathFinding.hpp>
+
+using namespace CPPUtils::Algorithms;
+
+namespace {
+
+    OccupancyGrid makeGrid(const std::vector<std::string>& rows) {
+        std::string cells;
+        for (const auto& row : rows) {
+            cells += row;
+        }
+        return OccupancyGrid(std::span<const char>(cells.data(), cells.size()), rows[0].size(), rows.size(),
+                             [](char c) { return c == 'X'; });
+    }
+
+    OccupancyGrid randomGrid(size_t width, size_t height, double density, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::bernoulli_distribution wall(density);
+        OccupancyGrid grid(width, height);
+        for (size_t y = 0; y < height; y++) {
+            for (size_t x = 0; x < width; x++) {
+                grid.setWall({ static_cast<std::int32_t>(x), static_cast<std::int32_t>(y) }, wall(rng));
+            }
+        }
+        return grid;
+    }
+
+    // Plain Dijkstra over the cells, for reference costs.
+    double referenceCost(const OccupancyGrid& grid, GridPoint start, GridPoint goal, bool diagonal) {
+        if (!grid.isOpen(start) || !grid.isOpen(goal)) {
+            return std::numeric_limits<double>::infinity();
+        }
+
+        std::vector<double> costs(grid.getWidth() * grid.getHeight(), std::numeric_limits<double>::infinity());
+        using Entry = std::pair<double, std::uint32_t>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> Q;
+        costs[grid.indexOf(start)] = 0;
+        Q.emplace(0, grid.indexOf(start));
+        while (!Q.empty()) {
+            const auto [d, v] = Q.top();
+            Q.pop();
+            if (d > costs[v]) {
+                continue;
+            }
+
+            const auto p = grid.pointAt(v);
+            for (std::int32_t dy = -1; dy <= 1; dy++) {
+                for (std::int32_t dx = -1; dx <= 1; dx++) {
+                    const bool isDiagonal = dx != 0 && dy != 0;
+                    if ((dx == 0 && dy == 0) || (isDiagonal && !diagonal)) {
+                        continue;
+                    }
+                    const GridPoint q = { p.x + dx, p.y + dy };
+                    if (!grid.isOpen(q) ||
+                        (isDiagonal && (!grid.isOpen({ p.x + dx, p.y }) || !grid.isOpen({ p.x, p.y + dy })))) {
+                        continue;
+                    }
+
+                    const auto u = grid.indexOf(q);
+                    const auto cost = d + (isDiagonal ? std::sqrt(2.0) : 1.0);
+                    if (cost < costs[u]) {
+                        costs[u] = cost;
+                        Q.emplace(cost, u);
+                    }
+                }
+            }
+        }
+        return costs[grid.indexOf(goal)];
+    }
+
+    // Checks that `path` is a legal walk from `start` to `goal` and returns its cost.
+    double walkCost(const OccupancyGrid& grid, const std::vector<GridPoint>& path, bool diagonal) {
+        double cost = 0;
+        for (size_t i = 0; i < path.size(); i++) {
+            EXPECT_TRUE(grid.isOpen(path[i]));
+            if (i == 0) {
+                continue;
+            }
+
+            const auto dx = path[i].x - path[i - 1].x;
+            const auto dy = path[i].y - path[i - 1].y;
+            EXPECT_LE(std::abs(dx), 1);
+            EXPECT_LE(std::abs(dy), 1);
+            EXPECT_FALSE(dx == 0 && dy == 0);
+            if (dx != 0 && dy != 0) {
+                EXPECT_TRUE(diagonal);
+                EXPECT_TRUE(grid.isOpen({ path[i - 1].x + dx, path[i - 1].y }));
+                EXPECT_TRUE(grid.isOpen({ path[i - 1].x, path[i - 1].y + dy }));
+                cost += std::sqrt(2.0);
+            } else {
+                cost += 1.0;
+            }
+        }
+        return cost;
+    }
+}
+
+TEST(GridPathFindingTest, OccupancyGridTest) {
+    OccupancyGrid grid(70, 3);
+    EXPECT_EQ(grid.getWidth(), 70);
+    EXPECT_EQ(grid.getHeight(), 3);
+    EXPECT_TRUE(grid.isOpen({ 69, 2 }));
+    EXPECT_FALSE(grid.isOpen({ 70, 0 }));
+    EXPECT_FALSE(grid.isOpen({ -1, 0 }));
+    EXPECT_FALSE(grid.isOpen({ 0, 3 }));
+
+    // Cells either side of a word boundary.
+    grid.setWall({ 63, 1 }, true);
+    grid.setWall({ 64, 1 }, true);
+    EXPECT_FALSE(grid.isOpen({ 63, 1 }));
+    EXPECT_FALSE(grid.isOpen({ 64, 1 }));
+    EXPECT_TRUE(grid.isOpen({ 63, 0 }));
+    EXPECT_TRUE(grid.isOpen({ 65, 1 }));
+    grid.setWall({ 63, 1 }, false);
+    EXPECT_TRUE(grid.isOpen({ 63, 1 }));
+    EXPECT_FALSE(grid.isOpen({ 64, 1 }));
+
+    EXPECT_EQ(grid.indexOf({ 5, 2 }), 145);
+    EXPECT_EQ(grid.pointAt(145), (GridPoint{ 5, 2 }));
+
+    EXPECT_THROW(grid.setWall({ 70, 0 }, true), std::out_of_range);
+    const std::vector<char> cells(5, 'O');
+    EXPECT_THROW(OccupancyGrid(std::span<const char>(cells), 2, 2, [](char c) { return c == 'X'; }),
+                 std::invalid_argument);
+}
+
+TEST(GridPathFindingTest, FourConnectedPathTest) {
+    const auto grid = makeGrid({
+        "XXXXXX",
+        "OOOOOX",
+        "XXXXOX",
+        "XOOOOX",
+        "XXXSXX"
+    });
+
+    GridSearchContext context(grid);
+    const auto path = context.findPath({ 3, 4 }, { 0, 1 }, GridConnectivity::FOUR);
+    const std::vector<GridPoint> expected = {
+        { 3, 4 }, { 3, 3 }, { 4, 3 }, { 4, 2 }, { 4, 1 }, { 3, 1 }, { 2, 1 }, { 1, 1 }, { 0, 1 }
+    };
+    EXPECT_EQ(path, expected);
+    EXPECT_DOUBLE_EQ(context.getCost(), 8.0);
+
+    // The goal is walled off.
+    EXPECT_TRUE(context.findPath({ 3, 4 }, { 1, 0 }, GridConnectivity::FOUR).empty());
+    EXPECT_EQ(context.getCost(), GridSearchContext::infinity);
+}
+
+TEST(GridPathFindingTest, NoCornerCuttingTest) {
+    const auto grid = makeGrid({
+        "OX",
+        "XO"
+    });
+
+    GridSearchContext context(grid);
+    EXPECT_TRUE(context.findPath({ 0, 0 }, { 1, 1 }, GridConnectivity::EIGHT).empty());
+    EXPECT_TRUE(context.jumpPointSearch({ 0, 0 }, { 1, 1 }).empty());
+
+    const auto open = makeGrid({
+        "OO",
+        "OO"
+    });
+    GridSearchContext openContext(open);
+    const auto path = openContext.jumpPointSearch({ 0, 0 }, { 1, 1 });
+    EXPECT_EQ(path, (std::vector<GridPoint>{ { 0, 0 }, { 1, 1 } }));
+    EXPECT_DOUBLE_EQ(openContext.getCost(), std::sqrt(2.0));
+}
+
+TEST(GridPathFindingTest, StartIsGoalTest) {
+    OccupancyGrid grid(4, 4);
+    GridSearchContext context(grid);
+    EXPECT_EQ(context.findPath({ 2, 2 }, { 2, 2 }), (std::vector<GridPoint>{ { 2, 2 } }));
+    EXPECT_EQ(context.jumpPointSearch({ 2, 2 }, { 2, 2 }), (std::vector<GridPoint>{ { 2, 2 } }));
+    EXPECT_DOUBLE_EQ(context.getCost(), 0.0);
+
+    grid.setWall({ 2, 2 }, true);
+    EXPECT_TRUE(context.findPath({ 2, 2 }, { 0, 0 }).empty());
+    EXPECT_TRUE(context.findPath({ 0, 0 }, { 9, 0 }).empty());
+}
+
+TEST(GridPathFindingTest, AgreesWithDijkstraTest) {
+    for (unsigned seed = 0; seed < 8; seed++) {
+        const auto grid = randomGrid(37, 29, 0.1 + 0.05 * seed, seed);
+        GridSearchContext context(grid);
+        std::mt19937 rng(100 + seed);
+        std::uniform_int_distribution<std::int32_t> x(0, 36), y(0, 28);
+
+        for (int query = 0; query < 25; query++) {
+            const GridPoint start = { x(rng), y(rng) };
+            const GridPoint goal = { x(rng), y(rng) };
+
+            for (const bool diagonal : { false, true }) {
+                const auto expected = referenceCost(grid, start, goal, diagonal);
+                const auto path = context.findPath(start, goal, diagonal ? GridConnectivity::EIGHT : GridConnectivity::FOUR);
+                if (std::isinf(expected)) {
+                    EXPECT_TRUE(path.empty());
+                    continue;
+                }
+
+                ASSERT_FALSE(path.empty());
+                EXPECT_EQ(path.front(), start);
+                EXPECT_EQ(path.back(), goal);
+                EXPECT_NEAR(context.getCost(), expected, 1e-9);
+                EXPECT_NEAR(walkCost(grid, path, diagonal), expected, 1e-9);
+            }
+        }
+    }
+}
+
+TEST(GridPathFindingTest, JumpPointSearchAgreesWithAStarTest) {
+    for (unsigned seed = 0; seed < 8; seed++) {
+        const auto grid = randomGrid(64, 48, 0.05 + 0.05 * seed, 50 + seed);
+        GridSearchContext astar(grid);
+        GridSearchContext jps(grid);
+        std::mt19937 rng(200 + seed);
+        std::uniform_int_distribution<std::int32_t> x(0, 63), y(0, 47);
+
+        for (int query = 0; query < 25; query++) {
+            const GridPoint start = { x(rng), y(rng) };
+            const GridPoint goal = { x(rng), y(rng) };
+
+            const auto expected = astar.findPath(start, goal, GridConnectivity::EIGHT);
+            const auto path = jps.jumpPointSearch(start, goal);
+            ASSERT_EQ(path.empty(), expected.empty());
+            if (path.empty()) {
+                continue;
+            }
+
+            EXPECT_EQ(path.front(), start);
+            EXPECT_EQ(path.back(), goal);
+            EXPECT_NEAR(jps.getCost(), astar.getCost(), 1e-9);
+            EXPECT_NEAR(walkCost(grid, path, true), astar.getCost(), 1e-9);
+        }
+    }
+}
+
+TEST(GridPathFindingTest, JumpPointSearchSettlesFewerCellsTest) {
+    OccupancyGrid grid(100, 100);
+    for (std::int32_t y = 10; y < 90; y++) {
+        grid.setWall({ 50, y }, true);
+    }
+
+    GridSearchContext astar(grid);
+    GridSearchContext jps(grid);
+    astar.findPath({ 5, 50 }, { 95, 50 });
+    jps.jumpPointSearch({ 5, 50 }, { 95, 50 });
+    EXPECT_NEAR(jps.getCost(), astar.getCost(), 1e-9);
+    EXPECT_LT(jps.getSettledCount(), astar.getSettledCount());
+}
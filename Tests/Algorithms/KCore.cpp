@@ -0,0 +1,148 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/Algorithms/KCore.hpp>
+
+using namespace CPPUtils::Algorithms;
+using namespace CPPUtils::DataStructures::Graphs;
+
+class KCoreTestSuite : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        //
+    }
+};
+
+namespace {
+    // Textbook sequential peeling, for comparison.
+    std::vector<std::uint32_t> referenceCores(const std::vector<std::vector<int>>& adjacency) {
+        const auto N = adjacency.size();
+        std::vector<std::uint32_t> degree(N);
+        std::vector<bool> removed(N, false);
+        std::vector<std::uint32_t> core(N, 0);
+        for (size_t v = 0; v < N; v++) {
+            degree[v] = static_cast<std::uint32_t>(adjacency[v].size());
+        }
+
+        std::uint32_t k = 0;
+        for (size_t n = 0; n < N; n++) {
+            size_t best = N;
+            for (size_t v = 0; v < N; v++) {
+                if (!removed[v] && (best == N || degree[v] < degree[best])) {
+                    best = v;
+                }
+            }
+            k = (std::max)(k, degree[best]);
+            core[best] = k;
+            removed[best] = true;
+            for (const auto u : adjacency[best]) {
+                if (!removed[u]) {
+                    degree[u]--;
+                }
+            }
+        }
+        return core;
+    }
+}
+
+TEST_F(KCoreTestSuite, SmallGraphTest) {
+    // A 4-clique {0, 1, 2, 3}, with a tail 3 - 4 - 5 and an isolated vertex.
+    Graph<int> G;
+    for (int i = 0; i < 4; i++) {
+        for (int j = i + 1; j < 4; j++) {
+            G.addEdge(i, j, 1.0);
+        }
+    }
+    G.addEdge(3, 4, 1.0);
+    G.addEdge(4, 5, 1.0);
+    G.addEdge(5, 5, 1.0);
+    G.addVertex(6);
+
+    const auto cores = coreNumbers(G, 2);
+    for (int i = 0; i < 4; i++) {
+        ASSERT_EQ(cores.at(i), 3);
+    }
+    ASSERT_EQ(cores.at(4), 1);
+    ASSERT_EQ(cores.at(5), 1);
+    ASSERT_EQ(cores.at(6), 0);
+
+    const CSRGraph<int> C(G);
+    const auto dense = coreNumbers(C, 2);
+    ASSERT_EQ(degeneracy(dense), 3);
+    ASSERT_EQ(kCoreVertices(dense, 3).size(), 4);
+    ASSERT_EQ(kCoreVertices(dense, 1).size(), 6);
+    ASSERT_EQ(kCoreVertices(dense, 0).size(), 7);
+    ASSERT_TRUE(kCoreVertices(dense, 4).empty());
+}
+
+TEST_F(KCoreTestSuite, RandomGraphTest) {
+    std::mt19937 rng(11);
+    const int N = 3000;
+    std::vector<std::vector<int>> adjacency(N);
+    std::vector<std::vector<bool>> adjacent(N, std::vector<bool>(N, false));
+    DirectedGraph<int> G;
+    for (int i = 0; i < N; i++) {
+        G.addVertex(i);
+    }
+
+    // Skewed endpoints give a range of core numbers.
+    for (int e = 0; e < 20000; e++) {
+        const int a = static_cast<int>(rng() % (1 + rng() % N));
+        const int b = static_cast<int>(rng() % N);
+        G.addEdge(a, b, 1.0);
+        if (a != b && !adjacent[a][b]) {
+            adjacent[a][b] = adjacent[b][a] = true;
+            adjacency[a].push_back(b);
+            adjacency[b].push_back(a);
+        }
+    }
+
+    const auto expected = referenceCores(adjacency);
+    const CSRGraph<int> C(G);
+    for (const unsigned int threads : { 1u, 4u }) {
+        const auto cores = coreNumbers(C, threads);
+        for (int v = 0; v < N; v++) {
+            ASSERT_EQ(cores[C.indexOf(v)], expected[v]);
+        }
+    }
+}
+
+TEST_F(KCoreTestSuite, EmptyGraphTest) {
+    ASSERT_TRUE(coreNumbers(Graph<int>()).empty());
+    ASSERT_EQ(degeneracy({}), 0);
+}
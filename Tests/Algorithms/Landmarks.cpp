@@ -0,0 +1,261 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/Algorithms/AStarSearchContext.hpp>
+#include <CPPUtils/Algorithms/BidirectionalSearch.hpp>
+#include <CPPUtils/Algorithms/Landmarks.hpp>
+#include <CPPUtils/Algorithms/PathFinding.hpp>
+
+#include "TestGraphs.hpp"
+
+using namespace CPPUtils::Algorithms;
+using namespace CPPUtils::DataStructures::Graphs;
+
+class LandmarksTestSuite : public ::testing::Test {
+ protected:
+    std::filesystem::path fname;
+
+    void SetUp() override {
+        fname = std::filesystem::temp_directory_path() / "test_landmarks.bin";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(fname);
+    }
+
+    // Checks that estimates never exceed true costs, are zero at the
+    // target, and are consistent.
+    template<typename U>
+    static void verifyBounds(const CSRGraph<int, U>& C, const Landmarks<int, U>& L, unsigned int seed) {
+        const auto R = transpose(C);
+        std::mt19937 rng(seed);
+        for (int i = 0; i < 20; i++) {
+            const auto s = static_cast<VertexIndex>(rng() % C.getVertexCardinality());
+            const auto costs = TestGraphs::referenceCosts(C, s);
+            ASSERT_EQ(L.estimate(s, s), 0);
+
+            for (VertexIndex t = 0; t < C.getVertexCardinality(); t++) {
+                if (!TestGraphs::unreachable(costs[t])) {
+                    ASSERT_LE(L.estimate(s, t), costs[t]);
+                }
+            }
+
+            // Consistency only matters along edges into vertices that can
+            // still reach the target, which the reverse search reaches.
+            const auto t = s;
+            const auto reverseCosts = TestGraphs::referenceCosts(R, t);
+            for (VertexIndex v = 0; v < C.getVertexCardinality(); v++) {
+                const auto Nv = C.neighbours(v);
+                const auto Wv = C.neighbourWeights(v);
+                for (size_t j = 0; j < Nv.size(); j++) {
+                    if (!TestGraphs::unreachable(reverseCosts[Nv[j]])) {
+                        ASSERT_LE(L.estimate(v, t), Wv[j] + L.estimate(Nv[j], t));
+                    }
+                }
+            }
+        }
+    }
+};
+
+TEST_F(LandmarksTestSuite, DirectedBoundsTest) {
+    for (const auto selection : { LandmarkSelection::FARTHEST, LandmarkSelection::AVOID }) {
+        for (unsigned int seed = 0; seed < 3; seed++) {
+            const CSRGraph<int, std::uint32_t> C(TestGraphs::makeRoads(15, seed), 1);
+            const Landmarks<int, std::uint32_t> L(C, 6, selection, 2, seed);
+            ASSERT_EQ(L.getLandmarks().size(), 6);
+            verifyBounds(C, L, seed);
+        }
+    }
+}
+
+TEST_F(LandmarksTestSuite, UndirectedBoundsTest) {
+    std::mt19937 rng(5);
+    CPPUtils::DataStructures::Graphs::Graph<int> G;
+    for (int v = 0; v < 200; v++) {
+        G.addVertex(v);
+    }
+    for (int i = 0; i < 500; i++) {
+        G.addEdge(static_cast<int>(rng() % 200), static_cast<int>(rng() % 200), 0.5 + (rng() % 100) * 0.25);
+    }
+
+    const CSRGraph<int> C(G, 1);
+    for (const auto selection : { LandmarkSelection::FARTHEST, LandmarkSelection::AVOID }) {
+        const Landmarks<int> L(C, 8, selection, 1, 3);
+        verifyBounds(C, L, 7);
+    }
+}
+
+TEST_F(LandmarksTestSuite, LandmarkDistancesTest) {
+    const CSRGraph<int, std::uint32_t> C(TestGraphs::makeRoads(12, 4), 1);
+    const Landmarks<int, std::uint32_t> L(C, 5, LandmarkSelection::AVOID, 1, 1);
+
+    // Landmarks are distinct, and estimates from a landmark are exact.
+    auto landmarks = std::vector<VertexIndex>(L.getLandmarks().begin(), L.getLandmarks().end());
+    std::sort(landmarks.begin(), landmarks.end());
+    ASSERT_EQ(std::unique(landmarks.begin(), landmarks.end()), landmarks.end());
+
+    for (size_t i = 0; i < L.getLandmarks().size(); i++) {
+        const auto l = L.getLandmarks()[i];
+        const auto costs = TestGraphs::referenceCosts(C, l);
+        for (VertexIndex v = 0; v < C.getVertexCardinality(); v++) {
+            ASSERT_EQ(L.getDistanceFrom(i, v), costs[v]);
+            if (!TestGraphs::unreachable(costs[v])) {
+                ASSERT_EQ(L.estimate(l, v), costs[v]);
+            }
+        }
+    }
+}
+
+TEST_F(LandmarksTestSuite, FarthestCoversComponentsTest) {
+    CPPUtils::DataStructures::Graphs::Graph<int> G;
+    G.addEdge(1, 2, 1.0);
+    G.addEdge(2, 3, 1.0);
+    G.addEdge(10, 11, 1.0);
+    G.addEdge(11, 12, 1.0);
+
+    const Landmarks<int> L(G, 2, LandmarkSelection::FARTHEST, 1);
+    ASSERT_EQ(L.getLandmarks().size(), 2);
+    const auto a = L.vertexAt(L.getLandmarks()[0]);
+    const auto b = L.vertexAt(L.getLandmarks()[1]);
+    ASSERT_NE(a < 10, b < 10);
+
+    // No bound holds between components, and more landmarks than vertices
+    // are capped.
+    ASSERT_EQ(L.estimate(L.indexOf(1), L.indexOf(12)), 0);
+    ASSERT_EQ((Landmarks<int>(G, 100, LandmarkSelection::AVOID, 1).getLandmarks().size()), 6);
+    ASSERT_TRUE((Landmarks<int>(G, 0).getLandmarks().empty()));
+    ASSERT_EQ((Landmarks<int>(G, 0).estimate(0, 1)), 0);
+}
+
+TEST_F(LandmarksTestSuite, GuidesSearchTest) {
+    const auto G = TestGraphs::makeRoads(30, 8);
+    const CSRGraph<int, std::uint32_t> C(G, 1);
+    const Landmarks<int, std::uint32_t> L(C, 8);
+    AStarSearchContext<int, std::uint32_t> dijkstraContext(C);
+    AStarSearchContext<int, std::uint32_t> altContext(C);
+    BidirectionalSearchContext<int, std::uint32_t> bidirectional(C);
+
+    size_t settledDijkstra = 0;
+    size_t settledALT = 0;
+    std::mt19937 rng(3);
+    for (int i = 0; i < 30; i++) {
+        const auto s = static_cast<VertexIndex>(rng() % C.getVertexCardinality());
+        const auto t = static_cast<VertexIndex>(rng() % C.getVertexCardinality());
+        const auto reached = dijkstraContext.search(s, t);
+        const auto goal = altContext.search(s,
+                                            [t](VertexIndex v) { return v == t; },
+                                            [&L, t](VertexIndex v) { return L.estimate(v, t); });
+        ASSERT_EQ((goal != AStarSearchContext<int, std::uint32_t>::invalidVertex), reached);
+        ASSERT_EQ(altContext.getCost(t), dijkstraContext.getCost(t));
+        settledDijkstra += dijkstraContext.getSettledCount();
+        settledALT += altContext.getSettledCount();
+
+        ASSERT_EQ(bidirectional.search(s, t, L), reached);
+        if (reached) {
+            ASSERT_EQ(bidirectional.getCost(), dijkstraContext.getCost(t));
+        }
+
+        // The keyed heuristic plugs into AStarSearch.
+        const auto path = AStarSearch<int, std::uint32_t, std::uint32_t>(
+            G, C.vertexAt(s), [&](int v) { return v == C.vertexAt(t); }, L.heuristicTo(C.vertexAt(t)));
+        ASSERT_EQ(path.empty(), !reached);
+        std::uint32_t cost = 0;
+        for (size_t j = 1; j < path.size(); j++) {
+            std::uint32_t lightest = UINT32_MAX;
+            for (const auto& e : G.getAdjacencyList(path[j - 1])) {
+                if (e.getVertex() == path[j]) {
+                    lightest = std::min(lightest, e.getWeight());
+                }
+            }
+            cost += lightest;
+        }
+        if (reached) {
+            ASSERT_EQ(cost, dijkstraContext.getCost(t));
+        }
+    }
+    ASSERT_LT(settledALT, settledDijkstra);
+}
+
+TEST_F(LandmarksTestSuite, SaveLoadTest) {
+    const CSRGraph<int, std::uint32_t> C(TestGraphs::makeRoads(10, 2), 1);
+    const Landmarks<int, std::uint32_t> L(C, 4);
+    L.save(fname.string());
+
+    const auto loaded = Landmarks<int, std::uint32_t>::load(fname.string());
+    ASSERT_EQ(loaded.getVertexCardinality(), L.getVertexCardinality());
+    ASSERT_TRUE(std::equal(L.getLandmarks().begin(), L.getLandmarks().end(), loaded.getLandmarks().begin(),
+                           loaded.getLandmarks().end()));
+    for (VertexIndex v = 0; v < C.getVertexCardinality(); v++) {
+        ASSERT_EQ(loaded.indexOf(C.vertexAt(v)), v);
+        for (VertexIndex t = 0; t < C.getVertexCardinality(); t += 7) {
+            ASSERT_EQ(loaded.estimate(v, t), L.estimate(v, t));
+        }
+    }
+
+    // The wrong cost type, and a truncated file, are rejected.
+    ASSERT_THROW((Landmarks<int, std::uint32_t, double>::load(fname.string())), std::runtime_error);
+    std::filesystem::resize_file(fname, std::filesystem::file_size(fname) - 4);
+    ASSERT_THROW((Landmarks<int, std::uint32_t>::load(fname.string())), std::runtime_error);
+    {
+        std::ofstream file(fname, std::ios::binary | std::ios::trunc);
+        file << "not landmarks at all, but long enough for a header";
+    }
+    ASSERT_THROW((Landmarks<int, std::uint32_t>::load(fname.string())), std::runtime_error);
+
+    // Counts whose section sizes sum to exactly 2^64, matching an empty body
+    // if the arithmetic wrapped.
+    LandmarksFileHeader header = {};
+    std::copy(std::begin(LandmarksFileHeader::expectedMagic), std::end(LandmarksFileHeader::expectedMagic),
+              header.magic);
+    header.version = LandmarksFileHeader::currentVersion;
+    header.keySize = sizeof(int);
+    header.costSize = sizeof(std::uint32_t);
+    header.directed = 0;
+    header.numVertices = 2147549184;
+    header.numLandmarks = 2147418112;
+    {
+        std::ofstream file(fname, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    ASSERT_THROW((Landmarks<int, std::uint32_t>::load(fname.string())), std::runtime_error);
+}
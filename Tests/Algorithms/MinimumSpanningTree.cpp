@@ -0,0 +1,165 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/Algorithms/ConnectedComponents.hpp>
+#include <CPPUtils/Algorithms/MinimumSpanningTree.hpp>
+
+using namespace CPPUtils::Algorithms;
+using namespace CPPUtils::DataStructures::Graphs;
+
+class MinimumSpanningTreeTestSuite : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        //
+    }
+};
+
+namespace {
+    // Prim's algorithm from every unvisited vertex; the total forest weight.
+    double referenceWeight(const Graph<int>& G, int N) {
+        std::vector<bool> visited(N, false);
+        double total = 0.0;
+        for (int s = 0; s < N; s++) {
+            if (visited[s]) {
+                continue;
+            }
+
+            using Entry = std::pair<double, int>;
+            std::priority_queue<Entry, std::vector<Entry>, std::greater<>> Q;
+            Q.emplace(0.0, s);
+            while (!Q.empty()) {
+                const auto [w, v] = Q.top();
+                Q.pop();
+                if (visited[v]) {
+                    continue;
+                }
+                visited[v] = true;
+                total += w;
+                for (const auto& e : G.getAdjacencyList(v)) {
+                    if (!visited[e.getVertex()]) {
+                        Q.emplace(e.getWeight(), e.getVertex());
+                    }
+                }
+            }
+        }
+        return total;
+    }
+
+    bool isAcyclic(const SpanningForest<int>& forest, int N) {
+        ConcurrentUnionFind sets(N);
+        for (const auto& e : forest.edges) {
+            if (!sets.unite(e.source, e.target)) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+TEST_F(MinimumSpanningTreeTestSuite, SmallGraphTest) {
+    Graph<int> G;
+    G.addEdge(0, 1, 4.0);
+    G.addEdge(0, 2, 1.0);
+    G.addEdge(1, 2, 2.0);
+    G.addEdge(1, 3, 5.0);
+    G.addEdge(2, 3, 8.0);
+    G.addEdge(3, 3, 0.5);
+    G.addEdge(4, 5, 3.0);
+    G.addVertex(6);
+
+    for (const auto& forest : { kruskal(G, 2), boruvka(G, 2) }) {
+        ASSERT_EQ(forest.edges.size(), 4);
+        ASSERT_EQ(forest.numTrees, 3);
+        ASSERT_DOUBLE_EQ(forest.totalWeight, 1.0 + 2.0 + 5.0 + 3.0);
+        ASSERT_TRUE(isAcyclic(forest, 7));
+
+        const auto F = spanningForestGraph(G, forest);
+        ASSERT_EQ(F.getVertexCardinality(), 7);
+        ASSERT_FALSE(F.isDirected());
+        ASSERT_EQ(connectedComponents(F, 1).numComponents, 3);
+    }
+}
+
+TEST_F(MinimumSpanningTreeTestSuite, RandomGraphTest) {
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<double> weight(0.0, 10.0);
+    const int N = 2000;
+    Graph<int> G;
+    for (int i = 0; i < N; i++) {
+        G.addVertex(i);
+    }
+    for (int e = 0; e < 12000; e++) {
+        // Integral weights give plenty of ties.
+        G.addEdge(static_cast<int>(rng() % N), static_cast<int>(rng() % N),
+                  e % 2 == 0 ? weight(rng) : static_cast<int>(weight(rng)));
+    }
+
+    const auto expected = referenceWeight(G, N);
+    const auto components = connectedComponents(G, 1).numComponents;
+    for (const unsigned int threads : { 1u, 4u }) {
+        for (const auto& forest : { kruskal(G, threads), boruvka(G, threads) }) {
+            ASSERT_NEAR(forest.totalWeight, expected, 1e-6);
+            ASSERT_EQ(forest.numTrees, components);
+            ASSERT_EQ(forest.edges.size(), N - components);
+            ASSERT_TRUE(isAcyclic(forest, N));
+        }
+    }
+}
+
+TEST_F(MinimumSpanningTreeTestSuite, DirectedTest) {
+    // Direction is ignored; the 1 -> 0 edge is the lightest way to join 0.
+    DirectedGraph<int> G;
+    G.addEdge(0, 1, 5.0);
+    G.addEdge(1, 0, 1.0);
+    G.addEdge(1, 2, 2.0);
+
+    for (const auto& forest : { kruskal(G, 2), boruvka(G, 2) }) {
+        ASSERT_EQ(forest.edges.size(), 2);
+        ASSERT_DOUBLE_EQ(forest.totalWeight, 3.0);
+    }
+}
+
+TEST_F(MinimumSpanningTreeTestSuite, EmptyGraphTest) {
+    const Graph<int> G;
+    ASSERT_TRUE(kruskal(G).edges.empty());
+    ASSERT_TRUE(boruvka(G).edges.empty());
+    ASSERT_EQ(boruvka(G).numTrees, 0);
+}
@@ -31,7 +31,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <map>
+#include <random>
+#include <unordered_map>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -74,8 +79,14 @@ TEST_F(PathFindingTestSuite, VertexCostPriorityTest) {
     RankedVertex<int> a(0.1, 1);
     RankedVertex<int> b(0.2, 1);
 
-    ASSERT_TRUE(VertexCostPriority<int>()(a, b));
-    ASSERT_FALSE(VertexCostPriority<int>()(b, a));
+    // The lower cost ranks higher, so it is popped first.
+    ASSERT_FALSE(VertexCostPriority<int>()(a, b));
+    ASSERT_TRUE(VertexCostPriority<int>()(b, a));
+
+    VertexPriorityQueue<int> Q;
+    Q.push(b);
+    Q.push(a);
+    ASSERT_EQ(Q.top().first, a.first);
 }
 
 TEST_F(PathFindingTestSuite, GetPathTest) {
@@ -100,6 +111,37 @@ TEST_F(PathFindingTestSuite, GetPathInvalidSinkTest) {
     ASSERT_TRUE(path.empty());
 }
 
+TEST_F(PathFindingTestSuite, GetPathIntoBufferTest) {
+    // The buffer is overwritten, not appended to.
+    std::vector<int> path = { 9, 9, 9, 9, 9, 9 };
+    ASSERT_TRUE(getPath(traversals, 1, 4, path));
+    ASSERT_EQ(path, std::vector<int>({ 1, 2, 3, 4 }));
+    ASSERT_FALSE(getPath(traversals_no_path, 1, 4, path));
+    ASSERT_TRUE(path.empty());
+
+    const std::unordered_map<int, int> hashed(traversals.begin(), traversals.end());
+    ASSERT_TRUE(getPath(hashed, 2, 4, path));
+    ASSERT_EQ(path, std::vector<int>({ 2, 3, 4 }));
+    ASSERT_TRUE(getPath(hashed, 4, 4, path));
+    ASSERT_EQ(path, std::vector<int>({ 4 }));
+}
+
+TEST_F(PathFindingTestSuite, GetPathParentArrayTest) {
+    // Vertex 0 is the root; 5 and 6 form a cycle.
+    const std::vector<std::uint32_t> parents = { 0, 0, 1, 1, 3, 6, 5 };
+    std::vector<std::uint32_t> path;
+    ASSERT_TRUE(getPath(parents, 0u, 4u, path));
+    ASSERT_EQ(path, std::vector<std::uint32_t>({ 0, 1, 3, 4 }));
+    ASSERT_TRUE(getPath(parents, 1u, 2u, path));
+    ASSERT_EQ(path, std::vector<std::uint32_t>({ 1, 2 }));
+
+    // Not an ancestor, a cycle, and out of range.
+    ASSERT_FALSE(getPath(parents, 2u, 4u, path));
+    ASSERT_TRUE(path.empty());
+    ASSERT_FALSE(getPath(parents, 0u, 5u, path));
+    ASSERT_FALSE(getPath(parents, 0u, 7u, path));
+}
+
 TEST_F(PathFindingTestSuite, AStarSearchTest) {
     auto heuristic = [](int a, int b) -> double {
         return a % b == 0 ? 0.0 : 1.0;
@@ -164,3 +206,120 @@ TEST_F(PathFindingTestSuite, DijkstraInvalidEndTest) {
     const auto path = dijkstra<int, double>(G, 1, 6);
     ASSERT_TRUE(path.empty());
 }
+
+TEST_F(PathFindingTestSuite, DijkstraPathTest) {
+    // The direct edge costs more than the detour.
+    G.addEdge(1, 5, 1.0);
+    for (const auto queueType : { PriorityQueueType::BINARY_HEAP, PriorityQueueType::INDEXED_DARY_HEAP }) {
+        const auto path = dijkstra<int, double>(G, 1, 5, queueType);
+        ASSERT_EQ(path, std::vector<int>({ 1, 2, 4, 5 }));
+    }
+    ASSERT_THROW((dijkstra<int, double>(G, 1, 5, PriorityQueueType::RADIX_HEAP)), std::invalid_argument);
+}
+
+TEST_F(PathFindingTestSuite, PriorityQueueTypesAgreeTest) {
+    // A grid with random integer weights.
+    constexpr int W = 12;
+    CPPUtils::Algorithms::Graph<int, int> H;
+    std::mt19937 rng(3);
+    for (int y = 0; y < W; y++) {
+        for (int x = 0; x < W; x++) {
+            if (x + 1 < W) {
+                H.addEdge(y * W + x, y * W + x + 1, 1 + static_cast<int>(rng() % 9));
+            }
+            if (y + 1 < W) {
+                H.addEdge(y * W + x, (y + 1) * W + x, 1 + static_cast<int>(rng() % 9));
+            }
+        }
+    }
+
+    const auto costOf = [&H](const std::vector<int>& path) {
+        int cost = 0;
+        for (size_t i = 1; i < path.size(); i++) {
+            for (const auto& e : H.getAdjacencyList(path[i - 1])) {
+                if (e.getVertex() == path[i]) {
+                    cost += e.getWeight();
+                }
+            }
+        }
+        return cost;
+    };
+
+    for (int sink = 1; sink < W * W; sink += 7) {
+        const auto binary = dijkstra<int, int>(H, 0, sink, PriorityQueueType::BINARY_HEAP);
+        const auto indexed = dijkstra<int, int>(H, 0, sink, PriorityQueueType::INDEXED_DARY_HEAP);
+        const auto radix = dijkstra<int, int>(H, 0, sink, PriorityQueueType::RADIX_HEAP);
+        ASSERT_FALSE(binary.empty());
+        ASSERT_EQ(binary.front(), 0);
+        ASSERT_EQ(binary.back(), sink);
+        ASSERT_EQ(costOf(binary), costOf(indexed));
+        ASSERT_EQ(costOf(binary), costOf(radix));
+    }
+}
+
+TEST_F(PathFindingTestSuite, CallableOverloadsAgreeTest) {
+    G.addEdge(1, 5, 1.0);
+
+    // Type erased arguments take the std::function overload, and lambdas
+    // the inlined one; both find the same path.
+    const std::function<bool(int)> erasedGoal = [](int v) { return v == 5; };
+    const std::function<double(int, int)> erasedHeuristic = [](int, int) { return 0.0; };
+    const auto erased = AStarSearch<int, double, double>(G, 1, erasedGoal, erasedHeuristic);
+    ASSERT_EQ(erased, std::vector<int>({ 1, 2, 4, 5 }));
+
+    // A stateful goal test is called in place, not copied.
+    size_t goalTests = 0;
+    auto countingGoal = [&goalTests](const int& v) {
+        goalTests++;
+        return v == 5;
+    };
+    const auto inlined = AStarSearch<int, double, double>(G, 1, countingGoal, ZeroHeuristic());
+    ASSERT_EQ(inlined, erased);
+    ASSERT_GT(goalTests, 0);
+
+    const auto withHeuristic = AStarSearch<int, double, double>(G, 1, countingGoal, [](const int&, const int&) {
+        return 0.25;
+    });
+    ASSERT_EQ(withHeuristic, erased);
+}
+
+TEST_F(PathFindingTestSuite, PathIntoBufferTest) {
+    G.addEdge(1, 5, 1.0);
+
+    // The buffer is reused across searches, and overwritten each time.
+    std::vector<int> path = { 9, 9, 9, 9, 9, 9 };
+    ASSERT_TRUE((dijkstra<int, double>(G, 1, 5, path)));
+    ASSERT_EQ(path, std::vector<int>({ 1, 2, 4, 5 }));
+    ASSERT_TRUE((dijkstra<int, double>(G, 1, 5, path, PriorityQueueType::BINARY_HEAP)));
+    ASSERT_EQ(path, std::vector<int>({ 1, 2, 4, 5 }));
+    ASSERT_FALSE((dijkstra<int, double>(G, 1, 6, path)));
+    ASSERT_TRUE(path.empty());
+
+    const std::function<bool(int)> erasedGoal = [](int v) { return v == 4; };
+    const std::function<double(int, int)> erasedHeuristic = [](int, int) { return 0.0; };
+    ASSERT_TRUE((AStarSearch<int, double, double>(G, 1, erasedGoal, erasedHeuristic, path)));
+    ASSERT_EQ(path, std::vector<int>({ 1, 2, 4 }));
+
+    ASSERT_TRUE((AStarSearch<int, double, double>(G, 1, [](const int& v) { return v == 5; }, ZeroHeuristic(), path)));
+    ASSERT_EQ(path, std::vector<int>({ 1, 2, 4, 5 }));
+    ASSERT_FALSE((AStarSearch<int, double, double>(G, 6, [](const int&) { return true; }, ZeroHeuristic(), path)));
+    ASSERT_TRUE(path.empty());
+}
+
+TEST_F(PathFindingTestSuite, DijkstraCostTest) {
+    ASSERT_DOUBLE_EQ((dijkstraCost<int, double>(G, 1, 5)), 0.3);
+    ASSERT_DOUBLE_EQ((dijkstraCost<int, double>(G, 1, 1)), 0.0);
+    ASSERT_EQ((dijkstraCost<int, double>(G, 5, 1)), std::numeric_limits<double>::infinity());
+    ASSERT_EQ((dijkstraCost<int, double>(G, 6, 1)), std::numeric_limits<double>::infinity());
+
+    // Integer costs without infinity report the maximum instead.
+    CPPUtils::Algorithms::Graph<int, int> H;
+    H.addEdge(1, 2, 3);
+    H.addVertex(3);
+    ASSERT_EQ((dijkstraCost<int, int>(H, 1, 2, PriorityQueueType::RADIX_HEAP)), 3);
+    ASSERT_EQ((dijkstraCost<int, int>(H, 1, 3)), std::numeric_limits<int>::max());
+
+    const auto cost = AStarSearchCost<int, double, double>(G, 1, [](const int& v) { return v == 4; },
+                                                           [](const int&, const int&) { return 0.0; });
+    ASSERT_DOUBLE_EQ(cost, 0.2);
+}
@@ -0,0 +1,82 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/Algorithms/SearchState.hpp>
+
+using namespace CPPUtils::Algorithms;
+
+class SearchStateTestSuite : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        //
+    }
+};
+
+TEST_F(SearchStateTestSuite, InfinityOfTest) {
+    ASSERT_TRUE(std::isinf(Detail::infinityOf<double>()));
+    ASSERT_TRUE(std::isinf(Detail::infinityOf<float>()));
+    ASSERT_EQ(Detail::infinityOf<int>(), (std::numeric_limits<int>::max)());
+    ASSERT_EQ(Detail::infinityOf<std::uint64_t>(), (std::numeric_limits<std::uint64_t>::max)());
+}
+
+TEST_F(SearchStateTestSuite, NextGenerationTest) {
+    std::uint32_t generation = 0;
+    std::vector<std::uint32_t> reached(3, 0);
+    std::vector<std::uint32_t> settled(3, 0);
+
+    Detail::nextGeneration(generation, reached, settled);
+    ASSERT_EQ(generation, 1);
+    reached[0] = generation;
+
+    // Stamps survive ordinary advances.
+    Detail::nextGeneration(generation, reached, settled);
+    ASSERT_EQ(generation, 2);
+    ASSERT_EQ(reached[0], 1);
+
+    // On wrap around, every stamp is cleared and zero is skipped.
+    generation = (std::numeric_limits<std::uint32_t>::max)();
+    reached[1] = 1;
+    settled[2] = generation;
+    Detail::nextGeneration(generation, reached, settled);
+    ASSERT_EQ(generation, 1);
+    for (size_t v = 0; v < 3; v++) {
+        ASSERT_EQ(reached[v], 0);
+        ASSERT_EQ(settled[v], 0);
+    }
+}
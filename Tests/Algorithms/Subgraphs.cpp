@@ -0,0 +1,172 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/Algorithms/Subgraphs.hpp>
+
+using namespace CPPUtils::Algorithms;
+using namespace CPPUtils::DataStructures::Graphs;
+
+class SubgraphsTestSuite : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        //
+    }
+};
+
+namespace {
+    // A 10 x 10 grid, with vertex y * 10 + x.
+    Graph<int> makeGrid() {
+        Graph<int> G;
+        for (int y = 0; y < 10; y++) {
+            for (int x = 0; x < 10; x++) {
+                if (x + 1 < 10) {
+                    G.addEdge(y * 10 + x, y * 10 + x + 1, 1.0 + x);
+                }
+                if (y + 1 < 10) {
+                    G.addEdge(y * 10 + x, (y + 1) * 10 + x, 2.0);
+                }
+            }
+        }
+        return G;
+    }
+
+    std::vector<int> sorted(std::vector<int> v) {
+        std::sort(v.begin(), v.end());
+        return v;
+    }
+}
+
+TEST_F(SubgraphsTestSuite, KHopNeighbourhoodTest) {
+    const auto G = makeGrid();
+
+    ASSERT_EQ(kHopNeighbourhood(G, 0, 0), std::vector<int>{ 0 });
+    ASSERT_EQ(sorted(kHopNeighbourhood(G, 0, 1)), (std::vector<int>{ 0, 1, 10 }));
+    ASSERT_EQ(kHopNeighbourhood(G, 55, 2).size(), 13);
+    ASSERT_EQ(kHopNeighbourhood(G, 55, 100).size(), 100);
+    ASSERT_TRUE(kHopNeighbourhood(G, -1, 2).empty());
+
+    // Breadth first; the centre, then its neighbours.
+    const auto hood = kHopNeighbourhood(G, 55, 2);
+    ASSERT_EQ(hood.front(), 55);
+    ASSERT_EQ(sorted({ hood.begin() + 1, hood.begin() + 5 }), (std::vector<int>{ 45, 54, 56, 65 }));
+}
+
+TEST_F(SubgraphsTestSuite, InducedSubgraphTest) {
+    auto G = makeGrid();
+    G.addEdge(0, 0, 7.0);
+
+    const std::vector<int> vertices = { 0, 1, 2, 10, 11, 2, 500 };
+    const auto S = inducedSubgraph(G, vertices);
+    ASSERT_FALSE(S.isDirected());
+    ASSERT_EQ(S.getVertexCardinality(), 5);
+    ASSERT_EQ(S.getAdjacencyList(0).size(), 4);
+    ASSERT_EQ(S.getAdjacencyList(2).size(), 1);
+    ASSERT_EQ(S.getAdjacencyList(11).size(), 2);
+
+    const auto C = inducedSubgraphCSR(G, vertices);
+    ASSERT_EQ(C.getVertexCardinality(), 5);
+    ASSERT_EQ(C.vertexAt(3), 10);
+    ASSERT_EQ(C.getEdgeCardinality(), 2 * 5 + 2);
+    ASSERT_EQ(C.getWeights()[C.findEdge(1, 2)], 2.0);
+}
+
+TEST_F(SubgraphsTestSuite, DirectedKHopSubgraphTest) {
+    DirectedGraph<int> G;
+    G.addEdge(0, 1, 1.0);
+    G.addEdge(1, 2, 1.0);
+    G.addEdge(2, 3, 1.0);
+    G.addEdge(3, 0, 1.0);
+    G.addEdge(4, 0, 1.0);
+
+    const auto S = kHopSubgraph(G, 0, 2);
+    ASSERT_TRUE(S.isDirected());
+    ASSERT_EQ(sorted(S.getVertices()), (std::vector<int>{ 0, 1, 2 }));
+    ASSERT_EQ(S.getAdjacencyList(1).size(), 1);
+    ASSERT_TRUE(S.getAdjacencyList(2).empty());
+}
+
+TEST_F(SubgraphsTestSuite, ExtractorTest) {
+    const auto G = makeGrid();
+    const CSRGraph<int> C(G);
+    SubgraphExtractor<int> extractor(C);
+
+    // Repeated queries reuse scratch space, so must not interfere.
+    for (int repeat = 0; repeat < 3; repeat++) {
+        for (const int centre : { 0, 55, 99 }) {
+            std::vector<int> expected = kHopNeighbourhood(G, centre, 2);
+            std::vector<int> actual;
+            for (const auto v : extractor.kHopVertices(C.indexOf(centre), 2)) {
+                actual.push_back(C.vertexAt(v));
+            }
+            ASSERT_EQ(sorted(actual), sorted(expected));
+
+            const auto S = extractor.kHopSubgraph(C.indexOf(centre), 2);
+            ASSERT_EQ(S.vertexAt(0), centre);
+            ASSERT_EQ(S.getVertexCardinality(), expected.size());
+            for (size_t v = 0; v < S.getVertexCardinality(); v++) {
+                const auto row = S.neighbours(static_cast<VertexIndex>(v));
+                ASSERT_TRUE(std::is_sorted(row.begin(), row.end()));
+                for (const auto u : row) {
+                    ASSERT_NE(C.findEdge(C.indexOf(S.vertexAt(static_cast<VertexIndex>(v))),
+                                         C.indexOf(S.vertexAt(u))),
+                              CSRGraph<int>::invalidEdge);
+                }
+            }
+        }
+    }
+
+    const std::vector<VertexIndex> vertices = { C.indexOf(11), C.indexOf(12), 12345, C.indexOf(11) };
+    const auto S = extractor.induced(vertices);
+    ASSERT_EQ(S.getVertexCardinality(), 2);
+    ASSERT_EQ(S.getEdgeCardinality(), 2);
+    ASSERT_TRUE(extractor.kHopVertices(12345, 3).empty());
+}
+
+TEST_F(SubgraphsTestSuite, DedupeSelfLoopTest) {
+    // Under DEDUPE an undirected self-loop is stored once, not twice.
+    Graph<int> G;
+    G.setMultiEdgePolicy(MultiEdgePolicy::DEDUPE);
+    G.addEdge(1, 1, 2.0);
+    G.addEdge(1, 2, 1.0);
+    ASSERT_EQ(G.getEdgeCardinality(), 3);
+
+    const std::vector<int> vertices = { 1, 2 };
+    for (const auto& S : { inducedSubgraph(G, vertices), kHopSubgraph(G, 1, 1) }) {
+        ASSERT_EQ(S.getEdgeCardinality(), 3);
+        ASSERT_EQ(S.getMultiEdgePolicy(), MultiEdgePolicy::DEDUPE);
+    }
+}
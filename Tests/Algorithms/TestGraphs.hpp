@@ -0,0 +1,150 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef CPP_UTILS_TESTS_ALGORITHMS_TEST_GRAPHS
+#define CPP_UTILS_TESTS_ALGORITHMS_TEST_GRAPHS
+
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <CPPUtils/DataStructures/CSRGraph.hpp>
+#include <CPPUtils/DataStructures/Graph.hpp>
+
+// Graph generators and reference results shared by the path finding tests.
+namespace TestGraphs {
+
+    using CPPUtils::DataStructures::Graphs::CSRGraph;
+    using CPPUtils::DataStructures::Graphs::DirectedGraph;
+    using CPPUtils::DataStructures::Graphs::Graph;
+    using CPPUtils::DataStructures::Graphs::VertexIndex;
+
+    // The grid distance between vertices keyed y * width + x.
+    inline int manhattan(int a, int b, int width) {
+        return std::abs(a % width - b % width) + std::abs(a / width - b / width);
+    }
+
+    // An undirected W by W grid, vertex key y * W + x, with each edge
+    // weighted by a call to `weight`.
+    template<typename Weight>
+    Graph<int> makeGrid(int W, Weight&& weight) {
+        Graph<int> G;
+        for (int y = 0; y < W; y++) {
+            for (int x = 0; x < W; x++) {
+                const auto v = y * W + x;
+                G.addVertex(v);
+                if (x > 0) {
+                    G.addEdge(v, v - 1, weight());
+                }
+                if (y > 0) {
+                    G.addEdge(v, v - W, weight());
+                }
+            }
+        }
+        return G;
+    }
+
+    // A road-like directed W by W grid, vertex key y * W + x: most streets
+    // two way with different weights of at least 1, some one way, some
+    // missing.
+    template<typename U = std::uint32_t>
+    DirectedGraph<int, U> makeRoads(int W, unsigned int seed) {
+        std::mt19937 rng(seed);
+        DirectedGraph<int, U> G;
+        for (int y = 0; y < W; y++) {
+            for (int x = 0; x < W; x++) {
+                const auto v = y * W + x;
+                G.addVertex(v);
+                for (const auto u : { x > 0 ? v - 1 : -1, y > 0 ? v - W : -1 }) {
+                    if (u < 0 || rng() % 8 == 0) {
+                        continue;
+                    }
+                    if (rng() % 5 != 0) {
+                        G.addEdge(u, v, static_cast<U>(1 + rng() % 20));
+                    }
+                    if (rng() % 5 != 0) {
+                        G.addEdge(v, u, static_cast<U>(1 + rng() % 20));
+                    }
+                }
+            }
+        }
+        return G;
+    }
+
+    // The cost of reaching every vertex from `source`, by textbook binary
+    // heap Dijkstra; infinity, or the maximum for integer weights, where
+    // unreachable.
+    template<typename T, typename U>
+    std::vector<U> referenceCosts(const CSRGraph<T, U>& G, VertexIndex source) {
+        constexpr auto infinity = std::numeric_limits<U>::has_infinity ?
+                                  std::numeric_limits<U>::infinity() :
+                                  (std::numeric_limits<U>::max)();
+
+        std::vector<U> costs(G.getVertexCardinality(), infinity);
+        using Entry = std::pair<U, VertexIndex>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> Q;
+        costs[source] = 0;
+        Q.emplace(0, source);
+        while (!Q.empty()) {
+            const auto [d, v] = Q.top();
+            Q.pop();
+            if (d > costs[v]) {
+                continue;
+            }
+
+            const auto Nv = G.neighbours(v);
+            const auto Wv = G.neighbourWeights(v);
+            for (size_t i = 0; i < Nv.size(); i++) {
+                if (d + Wv[i] < costs[Nv[i]]) {
+                    costs[Nv[i]] = d + Wv[i];
+                    Q.emplace(costs[Nv[i]], Nv[i]);
+                }
+            }
+        }
+        return costs;
+    }
+
+    // Whether `cost`, from `referenceCosts`, marks an unreachable vertex.
+    template<typename U>
+    bool unreachable(U cost) {
+        return cost == (std::numeric_limits<U>::has_infinity ?
+                        std::numeric_limits<U>::infinity() :
+                        (std::numeric_limits<U>::max)());
+    }
+}
+
+#endif
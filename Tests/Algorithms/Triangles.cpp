@@ -0,0 +1,166 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/Algorithms/Triangles.hpp>
+
+using namespace CPPUtils::Algorithms;
+using namespace CPPUtils::DataStructures::Graphs;
+
+class TrianglesTestSuite : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        //
+    }
+};
+
+TEST_F(TrianglesTestSuite, IntersectionTest) {
+    std::mt19937 rng(7);
+    for (int trial = 0; trial < 200; trial++) {
+        std::vector<VertexIndex> a;
+        std::vector<VertexIndex> b;
+        const auto range = 1 + rng() % 200;
+        for (VertexIndex i = 0; i < range; i++) {
+            if (rng() % 3 == 0) {
+                a.push_back(i);
+            }
+            if (rng() % 2 == 0) {
+                b.push_back(i);
+            }
+        }
+
+        std::vector<VertexIndex> expected;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+        ASSERT_EQ(Detail::intersectionSizeScalar(a, b), expected.size());
+        ASSERT_EQ(Detail::intersectionSize(a, b), expected.size());
+        ASSERT_EQ(Detail::intersectionSize(b, a), expected.size());
+    }
+}
+
+TEST_F(TrianglesTestSuite, CompleteGraphTest) {
+    // K_n has n choose 3 triangles.
+    const int n = 12;
+    Graph<int> G;
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            G.addEdge(i, j, 1.0);
+        }
+    }
+
+    ASSERT_EQ(countTriangles(G, 2), n * (n - 1) * (n - 2) / 6);
+
+    const CSRGraph<int> C(G);
+    for (const auto t : vertexTriangleCounts(C, 2)) {
+        ASSERT_EQ(t, (n - 1) * (n - 2) / 2);
+    }
+    for (const auto& [v, c] : localClusteringCoefficients(G, 2)) {
+        ASSERT_DOUBLE_EQ(c, 1.0);
+    }
+    ASSERT_DOUBLE_EQ(globalClusteringCoefficient(C, 2), 1.0);
+}
+
+TEST_F(TrianglesTestSuite, BowtieTest) {
+    // Two triangles sharing vertex 2, plus a pendant, a self loop and a
+    // parallel edge that should all be ignored.
+    Graph<int> G;
+    G.addEdge(0, 1, 1.0);
+    G.addEdge(1, 2, 1.0);
+    G.addEdge(2, 0, 1.0);
+    G.addEdge(2, 3, 1.0);
+    G.addEdge(3, 4, 1.0);
+    G.addEdge(4, 2, 1.0);
+    G.addEdge(4, 5, 1.0);
+    G.addEdge(0, 0, 1.0);
+    G.addEdge(0, 1, 2.0);
+
+    ASSERT_EQ(countTriangles(G, 2), 2);
+
+    const auto c = localClusteringCoefficients(G, 2);
+    ASSERT_DOUBLE_EQ(c.at(0), 1.0);
+    ASSERT_DOUBLE_EQ(c.at(2), 2.0 / 6.0);
+    ASSERT_DOUBLE_EQ(c.at(4), 1.0 / 3.0);
+    ASSERT_DOUBLE_EQ(c.at(5), 0.0);
+
+    // Triples: 1 + 1 + 6 + 1 + 3 + 0.
+    ASSERT_DOUBLE_EQ(globalClusteringCoefficient(CSRGraph<int>(G), 2), 6.0 / 12.0);
+}
+
+TEST_F(TrianglesTestSuite, DirectedTest) {
+    // A directed cycle is a triangle once direction is ignored.
+    DirectedGraph<int> G;
+    G.addEdge(0, 1, 1.0);
+    G.addEdge(1, 2, 1.0);
+    G.addEdge(2, 0, 1.0);
+    G.addEdge(0, 2, 1.0);
+    ASSERT_EQ(countTriangles(G, 2), 1);
+}
+
+TEST_F(TrianglesTestSuite, RandomGraphTest) {
+    std::mt19937 rng(3);
+    const int N = 200;
+    std::vector<std::vector<bool>> adjacent(N, std::vector<bool>(N, false));
+    Graph<int> G;
+    for (int i = 0; i < N; i++) {
+        G.addVertex(i);
+    }
+    for (int e = 0; e < 3000; e++) {
+        const int a = rng() % N;
+        const int b = rng() % N;
+        if (a != b && !adjacent[a][b]) {
+            adjacent[a][b] = adjacent[b][a] = true;
+            G.addEdge(a, b, 1.0);
+        }
+    }
+
+    std::uint64_t expected = 0;
+    for (int a = 0; a < N; a++) {
+        for (int b = a + 1; b < N; b++) {
+            for (int c = b + 1; c < N; c++) {
+                expected += adjacent[a][b] && adjacent[b][c] && adjacent[a][c];
+            }
+        }
+    }
+    ASSERT_EQ(countTriangles(G, 1), expected);
+    ASSERT_EQ(countTriangles(G, 4), expected);
+
+    std::uint64_t sum = 0;
+    for (const auto t : vertexTriangleCounts(CSRGraph<int>(G), 3)) {
+        sum += t;
+    }
+    ASSERT_EQ(sum, 3 * expected);
+}
@@ -0,0 +1,146 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/Algorithms/VertexOrdering.hpp>
+
+using namespace CPPUtils::Algorithms;
+using namespace CPPUtils::DataStructures::Graphs;
+
+class VertexOrderingTestSuite : public ::testing::Test {
+ protected:
+    Graph<int> G;
+
+    void SetUp() override {
+        // A 4x4 grid, with scrambled vertex keys.
+        constexpr int W = 4;
+        auto key = [](int x, int y) {
+            return (y * W + x) * 7 % 16 * 31;
+        };
+        for (int y = 0; y < W; y++) {
+            for (int x = 0; x < W; x++) {
+                if (x + 1 < W) {
+                    G.addEdge(key(x, y), key(x + 1, y), 1.0);
+                }
+                if (y + 1 < W) {
+                    G.addEdge(key(x, y), key(x, y + 1), 1.0);
+                }
+            }
+        }
+    }
+
+    static bool isPermutation(std::vector<VertexIndex> order, size_t N) {
+        std::sort(order.begin(), order.end());
+        for (size_t i = 0; i < order.size(); i++) {
+            if (order[i] != i) {
+                return false;
+            }
+        }
+        return order.size() == N;
+    }
+
+    static size_t bandwidth(const CSRGraph<int>& C) {
+        size_t b = 0;
+        for (VertexIndex v = 0; v < C.getVertexCardinality(); v++) {
+            for (const auto u : C.neighbours(v)) {
+                b = (std::max)(b, static_cast<size_t>(std::abs(static_cast<long>(u) - static_cast<long>(v))));
+            }
+        }
+        return b;
+    }
+};
+
+TEST_F(VertexOrderingTestSuite, PermutationTest) {
+    const CSRGraph C(G);
+    const auto N = C.getVertexCardinality();
+    ASSERT_EQ(N, 16);
+
+    ASSERT_TRUE(isPermutation(breadthFirstOrder(C), N));
+    ASSERT_TRUE(isPermutation(degreeOrder(C), N));
+    ASSERT_TRUE(isPermutation(degreeOrder(C, false), N));
+    ASSERT_TRUE(isPermutation(reverseCuthillMcKeeOrder(C), N));
+}
+
+TEST_F(VertexOrderingTestSuite, DegreeOrderTest) {
+    const CSRGraph C(G);
+    const auto order = degreeOrder(C);
+    for (size_t i = 1; i < order.size(); i++) {
+        ASSERT_GE(C.degree(order[i - 1]), C.degree(order[i]));
+    }
+}
+
+TEST_F(VertexOrderingTestSuite, ReverseCuthillMcKeeTest) {
+    const auto R = reorder(G, reverseCuthillMcKeeOrder<int, double>);
+
+    // A 4x4 grid has optimal bandwidth 4; RCM achieves it.
+    ASSERT_LE(bandwidth(R), 4);
+    ASSERT_EQ(R.getEdgeCardinality(), 48);
+
+    // Relabelling preserves the edges.
+    const CSRGraph C(G);
+    for (VertexIndex v = 0; v < C.getVertexCardinality(); v++) {
+        const auto& a = C.vertexAt(v);
+        ASSERT_EQ(R.degree(R.indexOf(a)), C.degree(v));
+        for (const auto u : C.neighbours(v)) {
+            ASSERT_NE(R.findEdge(R.indexOf(a), R.indexOf(C.vertexAt(u))), CSRGraph<int>::invalidEdge);
+        }
+    }
+}
+
+TEST_F(VertexOrderingTestSuite, BreadthFirstComponentsTest) {
+    Graph<int> H;
+    H.addEdge(0, 1, 1.0);
+    H.addEdge(2, 3, 1.0);
+    H.addVertex(4);
+
+    const auto R = reorder(H, breadthFirstOrder<int, double>);
+    ASSERT_EQ(R.getVertexCardinality(), 5);
+
+    // Neighbours in each component end up adjacent.
+    ASSERT_EQ(bandwidth(R), 1);
+}
+
+TEST_F(VertexOrderingTestSuite, DirectedTest) {
+    DirectedGraph<int> D;
+    D.addEdge(5, 3, 1.0);
+    D.addEdge(1, 3, 1.0);
+    D.addEdge(1, 9, 1.0);
+
+    const CSRGraph C(D);
+    const auto order = reverseCuthillMcKeeOrder(C);
+    ASSERT_TRUE(isPermutation(order, 4));
+}
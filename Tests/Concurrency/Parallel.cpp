@@ -0,0 +1,129 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/Concurrency/Parallel.hpp>
+
+using namespace CPPUtils::Concurrency;
+
+class ParallelTestSuite : public ::testing::TestWithParam<unsigned int> {
+ protected:
+    void SetUp() override {
+        //
+    }
+};
+
+TEST_P(ParallelTestSuite, ParallelForVisitsAllTest) {
+    constexpr size_t N = 1000;
+    std::vector<int> visits(N, 0);
+    parallelFor(0, N, [&visits](size_t i) {
+        visits[i]++;
+    }, GetParam());
+
+    for (const auto v : visits) {
+        ASSERT_EQ(v, 1);
+    }
+}
+
+TEST_P(ParallelTestSuite, ParallelForOffsetRangeTest) {
+    std::atomic<size_t> sum = 0;
+    parallelFor(10, 20, [&sum](size_t i) {
+        sum += i;
+    }, GetParam());
+    ASSERT_EQ(sum.load(), 145);
+}
+
+TEST_P(ParallelTestSuite, ParallelForEmptyRangeTest) {
+    bool called = false;
+    parallelFor(5, 5, [&called](size_t) {
+        called = true;
+    }, GetParam());
+    ASSERT_FALSE(called);
+}
+
+TEST_P(ParallelTestSuite, ParallelForExceptionTest) {
+    auto f = [](size_t i) {
+        if (i == 7) {
+            throw std::runtime_error("Failure.");
+        }
+    };
+    ASSERT_THROW(parallelFor(0, 16, f, GetParam()), std::runtime_error);
+}
+
+TEST_P(ParallelTestSuite, ParallelForBlocksTest) {
+    constexpr size_t N = 101;
+    std::vector<int> visits(N, 0);
+    parallelForBlocks(0, N, [&visits](size_t, size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            visits[i]++;
+        }
+    }, GetParam());
+
+    ASSERT_EQ(std::accumulate(visits.begin(), visits.end(), 0), N);
+}
+
+TEST_P(ParallelTestSuite, ParallelSortTest) {
+    std::mt19937 rng(5);
+    for (const size_t N : { 0, 1, 1000, 50000 }) {
+        std::vector<int> values(N);
+        for (auto& v : values) {
+            v = static_cast<int>(rng() % 1000);
+        }
+
+        auto expected = values;
+        std::sort(expected.begin(), expected.end(), std::greater<>());
+        parallelSort(values.begin(), values.end(), std::greater<>(), GetParam());
+        ASSERT_EQ(values, expected);
+    }
+}
+
+TEST_P(ParallelTestSuite, ThreadsForWorkTest) {
+    const auto workers = resolveThreadCount(GetParam());
+    ASSERT_EQ(threadsForWork(0, 1024, GetParam()), 1);
+    ASSERT_EQ(threadsForWork(2047, 1024, GetParam()), 1);
+    ASSERT_EQ(threadsForWork(2048, 1024, GetParam()), std::min(2u, workers));
+    ASSERT_EQ(threadsForWork(1u << 20, 1024, GetParam()), workers);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ThreadCounts,
+    ParallelTestSuite,
+    testing::Values(0u, 1u, 2u, 3u, 8u));
@@ -0,0 +1,124 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/Algorithms/PathFinding.hpp>
+#include <CPPUtils/DataStructures/ArenaGraph.hpp>
+#include <CPPUtils/DataStructures/CSRGraph.hpp>
+
+using namespace CPPUtils::DataStructures::Graphs;
+
+class ArenaGraphTestSuite : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        //
+    }
+};
+
+TEST_F(ArenaGraphTestSuite, UndirectedTest) {
+    ArenaGraph<int> G;
+    ASSERT_FALSE(G->isDirected());
+    ASSERT_EQ(G->getAllocator().resource(), &G.getArena());
+
+    const int N = 1000;
+    for (int i = 0; i < N; i++) {
+        G->addEdge(i, (i + 1) % N, 1.0);
+    }
+    ASSERT_EQ(G->getVertexCardinality(), N);
+    ASSERT_EQ(G->getAdjacencyList(0).size(), 2);
+    ASSERT_GT(G.getArena().getBytesReserved(), 0);
+
+    G->removeVertex(0);
+    ASSERT_EQ(G->getVertexCardinality(), N - 1);
+    ASSERT_TRUE(G->getAdjacencyList(1).size() == 1);
+
+    // Works with anything that takes a Graph.
+    auto path = CPPUtils::Algorithms::dijkstra(*G, 1, 10);
+    ASSERT_EQ(path.size(), 10);
+}
+
+TEST_F(ArenaGraphTestSuite, StorageTest) {
+    // Only arena graphs pay for polymorphic allocation.
+    static_assert(std::is_same_v<AdjacencyList<int>, std::vector<OutwardEdge<int>>>);
+    static_assert(std::is_same_v<ArenaGraph<int>::GraphType::EdgeType, OutwardEdge<int>>);
+
+    ArenaGraph<int> G;
+    G->addEdge(0, 1, 1.0);
+    ASSERT_EQ(G->getAdjacencyList(0).get_allocator().resource(), &G.getArena());
+
+    CSRGraph<int> H(*G);
+    ASSERT_EQ(H.getEdgeCardinality(), 2);
+}
+
+TEST_F(ArenaGraphTestSuite, DirectedTest) {
+    ArenaGraph<int, float> G(true);
+    ASSERT_TRUE(G->isDirected());
+
+    G->addEdge(0, 1, 1.0f);
+    ASSERT_EQ(G->getAdjacencyList(0).size(), 1);
+    ASSERT_TRUE(G->getAdjacencyList(1).empty());
+}
+
+TEST_F(ArenaGraphTestSuite, CopyTest) {
+    Graph<int> copy;
+    {
+        ArenaGraph<int> G;
+        G->addEdge(0, 1, 2.0);
+        G->addEdge(0, 1, 3.0);
+        copy = Graph<int>(*G);
+    }
+
+    // The copy has its own storage, duplicates included, and outlives the
+    // arena.
+    ASSERT_FALSE(copy.isDirected());
+    ASSERT_EQ(copy.getAdjacencyList(0).size(), 2);
+    ASSERT_EQ(copy.getAdjacencyList(1).at(1).getWeight(), 3.0);
+}
+
+TEST_F(ArenaGraphTestSuite, ClearTest) {
+    ArenaGraph<std::string> G;
+    G->addEdge("a", "b", 1.0);
+    G.clear();
+    ASSERT_EQ(G->getVertexCardinality(), 0);
+
+    G->addEdge("c", "d", 1.0);
+    ASSERT_EQ(G->getVertexCardinality(), 2);
+
+    ArenaGraph<std::string> H(std::move(G));
+    ASSERT_TRUE(H->vertexExists("c"));
+}
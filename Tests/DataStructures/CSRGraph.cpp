@@ -0,0 +1,195 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/DataStructures/CSRGraph.hpp>
+
+using namespace CPPUtils::DataStructures::Graphs;
+
+template <typename T>
+class CSRGraphTestSuite : public ::testing::Test {
+ public:
+    using GraphType = T;
+
+ protected:
+    void SetUp() override {
+        //
+    }
+
+    static T makeGraph() {
+        T G;
+        G.addEdge(0, 2, 0.5);
+        G.addEdge(0, 1, 0.25);
+        G.addEdge(2, 1, 2.0);
+        G.addVertex(3);
+        return G;
+    }
+};
+
+using GraphTypes = ::testing::Types<
+    Graph<int>,
+    Graph<int, float>,
+    DirectedGraph<int>,
+    DirectedGraph<int, float>>;
+
+TYPED_TEST_SUITE(CSRGraphTestSuite, GraphTypes);
+
+TYPED_TEST(CSRGraphTestSuite, EmptyGraphTest) {
+    const TypeParam G;
+    const CSRGraph C(G);
+    ASSERT_EQ(C.getVertexCardinality(), 0);
+    ASSERT_EQ(C.getEdgeCardinality(), 0);
+    ASSERT_EQ(C.getOffsets().size(), 1);
+    ASSERT_FALSE(C.vertexExists(0));
+}
+
+TYPED_TEST(CSRGraphTestSuite, FreezeTest) {
+    const auto G = this->makeGraph();
+    const CSRGraph C(G, 2);
+
+    ASSERT_EQ(C.isDirected(), G.isDirected());
+    ASSERT_EQ(C.getVertexCardinality(), G.getVertexCardinality());
+    ASSERT_EQ(C.getEdgeCardinality(), G.isDirected() ? 3 : 6);
+
+    for (const auto& v : G.getVertices()) {
+        ASSERT_TRUE(C.vertexExists(v));
+
+        const auto i = C.indexOf(v);
+        ASSERT_EQ(C.vertexAt(i), v);
+
+        // Same edges as the source graph, sorted by target index.
+        const auto& adj = G.getAdjacencyList(v);
+        const auto N = C.neighbours(i);
+        const auto W = C.neighbourWeights(i);
+        ASSERT_EQ(N.size(), adj.size());
+        ASSERT_EQ(C.degree(i), adj.size());
+        ASSERT_TRUE(std::is_sorted(N.begin(), N.end()));
+
+        for (const auto& e : adj) {
+            const auto it = std::find(N.begin(), N.end(), C.indexOf(e.getVertex()));
+            ASSERT_NE(it, N.end());
+            ASSERT_EQ(W[it - N.begin()], e.getWeight());
+        }
+    }
+
+    ASSERT_FALSE(C.vertexExists(4));
+    ASSERT_EQ(C.indexOf(4), CSRGraph<int>::invalidVertex);
+}
+
+TYPED_TEST(CSRGraphTestSuite, VertexOrderTest) {
+    const auto G = this->makeGraph();
+    const std::vector<int> order = { 3, 2, 1, 0 };
+    const CSRGraph C(G, order);
+
+    for (size_t i = 0; i < order.size(); i++) {
+        ASSERT_EQ(C.vertexAt(static_cast<VertexIndex>(i)), order[i]);
+        ASSERT_EQ(C.indexOf(order[i]), i);
+    }
+
+    ASSERT_THROW((CSRGraph(G, std::vector<int>{ 0, 1 })), std::invalid_argument);
+    ASSERT_THROW((CSRGraph(G, std::vector<int>{ 0, 1, 1, 2 })), std::invalid_argument);
+}
+
+TYPED_TEST(CSRGraphTestSuite, MoveTest) {
+    const auto G = this->makeGraph();
+    CSRGraph A(G);
+    const auto i = A.indexOf(2);
+
+    const CSRGraph B(std::move(A));
+    ASSERT_EQ(B.indexOf(2), i);
+    ASSERT_EQ(B.getVertexCardinality(), 4);
+}
+
+TYPED_TEST(CSRGraphTestSuite, SetEdgeWeightTest) {
+    const auto G = this->makeGraph();
+    CSRGraph C(G);
+
+    const auto a = C.indexOf(0);
+    const auto b = C.indexOf(2);
+    const auto e = C.findEdge(a, b);
+    ASSERT_NE(e, CSRGraph<int>::invalidEdge);
+    ASSERT_EQ(C.getTargets()[e], b);
+
+    ASSERT_TRUE(C.setEdgeWeight(0, 2, 4.0));
+    ASSERT_EQ(C.getWeights()[e], 4.0);
+
+    const auto r = C.findEdge(b, a);
+    if (G.isDirected()) {
+        ASSERT_EQ(r, CSRGraph<int>::invalidEdge);
+    } else {
+        ASSERT_EQ(C.getWeights()[r], 4.0);
+    }
+
+    ASSERT_FALSE(C.setEdgeWeight(0, 3, 1.0));
+    ASSERT_FALSE(C.setEdgeWeight(0, 9, 1.0));
+
+    using Edge = WeightedEdge<int, typename TypeParam::WeightType>;
+    const std::vector<Edge> updates = { { 0, 1, 8.0 }, { 3, 0, 1.0 } };
+    ASSERT_EQ(C.setEdgeWeights(updates), 1);
+    ASSERT_EQ(C.getWeights()[C.findEdge(a, C.indexOf(1))], 8.0);
+
+    // Bulk overwrite of the weights array.
+    for (auto& w : C.getWeights()) {
+        w = 1.0;
+    }
+    ASSERT_EQ(C.neighbourWeights(a)[0], 1.0);
+    ASSERT_EQ(C.getEdgeCardinality(), G.isDirected() ? 3 : 6);
+}
+
+TYPED_TEST(CSRGraphTestSuite, TransposeTest) {
+    const auto G = this->makeGraph();
+    const CSRGraph C(G, 1);
+    const auto R = transpose(C);
+
+    ASSERT_EQ(R.isDirected(), C.isDirected());
+    ASSERT_EQ(R.getVertexCardinality(), C.getVertexCardinality());
+    ASSERT_EQ(R.getEdgeCardinality(), C.getEdgeCardinality());
+
+    // Every edge a -> b of C appears as b -> a in R, with the same weight
+    // and the same vertex indices.
+    for (VertexIndex a = 0; a < C.getVertexCardinality(); a++) {
+        ASSERT_EQ(R.vertexAt(a), C.vertexAt(a));
+        const auto N = R.neighbours(a);
+        ASSERT_TRUE(std::is_sorted(N.begin(), N.end()));
+
+        for (const auto b : C.neighbours(a)) {
+            const auto e = R.findEdge(b, a);
+            ASSERT_NE(e, CSRGraph<int>::invalidEdge);
+            ASSERT_EQ(R.getWeights()[e], C.getWeights()[C.findEdge(a, b)]);
+        }
+    }
+}
@@ -0,0 +1,184 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/Algorithms/PathFinding.hpp>
+#include <CPPUtils/DataStructures/ConcurrentGraph.hpp>
+
+using namespace CPPUtils::DataStructures::Graphs;
+
+class ConcurrentGraphTestSuite : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        //
+    }
+};
+
+TEST_F(ConcurrentGraphTestSuite, BatchTest) {
+    GraphUpdateBatch<int> batch;
+    ASSERT_TRUE(batch.empty());
+
+    batch.addEdge(0, 1, 0.5);
+    batch.addEdge(1, 2, 0.5);
+    batch.addVertex(3);
+    batch.addEdge(3, 4, 0.5);
+    batch.setEdgeWeight(3, 4, 2.5);
+    batch.removeEdge(0, 1);
+    batch.removeVertex(2);
+    ASSERT_EQ(batch.size(), 7);
+
+    Graph<int> G;
+    batch.applyTo(G);
+    ASSERT_EQ(G.getVertexCardinality(), 4);
+    ASSERT_TRUE(G.getAdjacencyList(0).empty());
+    ASSERT_TRUE(G.getAdjacencyList(1).empty());
+    ASSERT_EQ(G.getAdjacencyList(3).at(0).getWeight(), 2.5);
+    ASSERT_EQ(G.getAdjacencyList(4).at(0).getWeight(), 2.5);
+
+    batch.clear();
+    ASSERT_TRUE(batch.empty());
+}
+
+TEST_F(ConcurrentGraphTestSuite, SnapshotIsolationTest) {
+    ConcurrentGraph<int> G;
+    ASSERT_EQ(G.getVersion(), 0);
+
+    GraphUpdateBatch<int> batch;
+    batch.addEdge(0, 1, 0.5);
+    ASSERT_EQ(G.update(batch), 1);
+
+    // Hold on to version 1.
+    const auto before = G.snapshot();
+
+    batch.clear();
+    batch.addEdge(1, 2, 0.5);
+    ASSERT_EQ(G.update(batch), 2);
+
+    // The old snapshot is unchanged, the new one sees the update.
+    ASSERT_EQ(before->getVertexCardinality(), 2);
+    ASSERT_EQ(G.snapshot()->getVertexCardinality(), 3);
+    ASSERT_EQ(G.getVersion(), 2);
+
+    // Empty batches don't create versions.
+    ASSERT_EQ(G.update(GraphUpdateBatch<int>()), 2);
+}
+
+TEST_F(ConcurrentGraphTestSuite, DirectedTest) {
+    ConcurrentGraph<int> G{ DirectedGraph<int>() };
+
+    GraphUpdateBatch<int> batch;
+    batch.addEdge(0, 1, 0.5);
+    G.update(batch);
+
+    const auto S = G.snapshot();
+    ASSERT_TRUE(S->isDirected());
+    ASSERT_TRUE(S->getAdjacencyList(1).empty());
+}
+
+TEST_F(ConcurrentGraphTestSuite, ConcurrentReadersTest) {
+    // A chain 0 - 1 - ... - N.
+    constexpr int N = 64;
+    Graph<int> initial;
+    for (int i = 0; i < N; i++) {
+        initial.addEdge(i, i + 1, 1.0);
+    }
+    ConcurrentGraph<int> G(initial);
+
+    // Readers continually search the chain, which every version contains.
+    std::atomic<bool> done = false;
+    std::atomic<int> failures = 0;
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; t++) {
+        readers.emplace_back([&]() {
+            while (!done) {
+                const auto S = G.snapshot();
+                const auto path = CPPUtils::Algorithms::dijkstra<int, double>(*S, 0, N);
+                if (path.size() != N + 1) {
+                    failures++;
+                }
+            }
+        });
+    }
+
+    // Meanwhile the writer adds and removes shortcuts that never shorten
+    // the path.
+    for (int i = 0; i < 100; i++) {
+        GraphUpdateBatch<int> batch;
+        batch.addEdge(i % N, N + 1 + i, 1000.0);
+        if (i > 0) {
+            batch.removeVertex(N + i);
+        }
+        G.update(batch);
+    }
+    done = true;
+
+    for (auto& r : readers) {
+        r.join();
+    }
+
+    ASSERT_EQ(failures.load(), 0);
+    ASSERT_EQ(G.getVersion(), 100);
+}
+
+TEST_F(ConcurrentGraphTestSuite, ManySnapshotsTest) {
+    ConcurrentGraph<int> G;
+    GraphUpdateBatch<int> batch;
+
+    // More snapshots than fit in one block of reader slots, each of a
+    // different version, all held while later versions are published.
+    std::vector<ConcurrentGraph<int>::Snapshot> held;
+    for (int i = 0; i < 100; i++) {
+        held.push_back(G.snapshot());
+        batch.clear();
+        batch.addVertex(i);
+        G.update(batch);
+    }
+
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(held[i].getVersion(), static_cast<std::uint64_t>(i));
+        ASSERT_EQ(held[i]->getVertexCardinality(), static_cast<size_t>(i));
+    }
+
+    // Released snapshots free their slots, and moved-from ones hold nothing.
+    auto moved = std::move(held[5]);
+    ASSERT_EQ(held[5].get(), nullptr);
+    ASSERT_EQ(moved->getVertexCardinality(), 5);
+    held.clear();
+    ASSERT_EQ(G.snapshot()->getVertexCardinality(), 100);
+}
@@ -31,7 +31,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <ranges>
 #include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -226,3 +230,262 @@ TYPED_TEST(GraphTestSuite, GraphRemoveEdgesTest) {
         ASSERT_EQ(adj_2.at(0).getWeight(), -0.1);
     }
 }
+
+TYPED_TEST(GraphTestSuite, GraphSetEdgeWeightTest) {
+    TypeParam G;
+    G.addEdge(0, 1, 0.5);
+    G.addEdge(2, 0, 0.1);
+
+    ASSERT_TRUE(G.setEdgeWeight(0, 1, 1.5));
+    ASSERT_EQ(G.getAdjacencyList(0).at(0).getWeight(), 1.5);
+
+    if (G.isDirected()) {
+        // Only the edge in the given direction exists.
+        ASSERT_FALSE(G.setEdgeWeight(0, 2, 3.0));
+        ASSERT_EQ(G.getAdjacencyList(2).at(0).getWeight(), 0.1);
+        ASSERT_TRUE(G.getAdjacencyList(1).empty());
+    } else {
+        // Both directions are updated.
+        ASSERT_EQ(G.getAdjacencyList(1).at(0).getWeight(), 1.5);
+        ASSERT_TRUE(G.setEdgeWeight(0, 2, 3.0));
+        ASSERT_EQ(G.getAdjacencyList(2).at(0).getWeight(), 3.0);
+        ASSERT_EQ(G.getAdjacencyList(0).at(1).getWeight(), 3.0);
+    }
+
+    // Missing vertices or edges.
+    ASSERT_FALSE(G.setEdgeWeight(0, 7, 1.0));
+    ASSERT_FALSE(G.setEdgeWeight(7, 0, 1.0));
+    ASSERT_FALSE(G.setEdgeWeight(1, 2, 1.0));
+
+    // No edges were added or removed.
+    ASSERT_EQ(G.getAdjacencyList(0).size(), G.isDirected() ? 1 : 2);
+}
+
+TYPED_TEST(GraphTestSuite, GraphSetEdgeWeightsTest) {
+    TypeParam G;
+    G.addEdge(0, 1, 0.5);
+    G.addEdge(1, 2, 0.5);
+
+    using Edge = Graphs::WeightedEdge<typename TypeParam::VertexType>;
+    const std::vector<Edge> updates = {
+        { 0, 1, 2.0 },
+        { 1, 2, 3.0 },
+        { 2, 3, 4.0 }
+    };
+    ASSERT_EQ(G.setEdgeWeights(updates), 2);
+    ASSERT_EQ(G.getAdjacencyList(0).at(0).getWeight(), 2.0);
+    ASSERT_EQ(G.getAdjacencyList(1).back().getWeight(), 3.0);
+}
+
+TYPED_TEST(GraphTestSuite, GraphVertexRangeTest) {
+    TypeParam G;
+    ASSERT_TRUE(std::ranges::empty(G.getVertexRange()));
+
+    G.addEdge(0, 1, 0.5);
+    G.addVertex(2);
+
+    std::vector<typename TypeParam::VertexType> vertices(G.getVertexRange().begin(),
+                                                         G.getVertexRange().end());
+    std::sort(vertices.begin(), vertices.end());
+    ASSERT_EQ(vertices, (std::vector<typename TypeParam::VertexType>{ 0, 1, 2 }));
+    ASSERT_EQ(std::ranges::size(G.getVertexRange()), G.getVertexCardinality());
+}
+
+TYPED_TEST(GraphTestSuite, GraphEdgeRangeTest) {
+    TypeParam G;
+    ASSERT_EQ(G.getEdgeRange().begin(), G.getEdgeRange().end());
+
+    G.addVertex(5);
+    G.addEdge(0, 1, 0.5);
+    G.addEdge(1, 2, 1.5);
+    G.addVertex(6);
+
+    std::vector<std::pair<int, int>> edges;
+    double totalWeight = 0.0;
+    for (const auto& e : G.getEdgeRange()) {
+        edges.emplace_back(static_cast<int>(e.source), static_cast<int>(e.target));
+        totalWeight += e.weight;
+    }
+    std::sort(edges.begin(), edges.end());
+
+    if (G.isDirected()) {
+        ASSERT_EQ(edges, (std::vector<std::pair<int, int>>{ { 0, 1 }, { 1, 2 } }));
+        ASSERT_EQ(totalWeight, 2.0);
+    } else {
+        ASSERT_EQ(edges, (std::vector<std::pair<int, int>>{ { 0, 1 }, { 1, 0 }, { 1, 2 }, { 2, 1 } }));
+        ASSERT_EQ(totalWeight, 4.0);
+    }
+
+    static_assert(std::forward_iterator<decltype(G.getEdgeRange().begin())>);
+}
+
+TYPED_TEST(GraphTestSuite, GraphMemoryUsageTest) {
+    TypeParam G;
+    ASSERT_EQ(G.getMemoryUsage().adjacencyCapacityBytes, 0);
+
+    for (int i = 0; i < 100; i++) {
+        G.addEdge(0, i + 1, 1.0);
+    }
+
+    using Edge = typename TypeParam::EdgeType;
+    const auto before = G.getMemoryUsage();
+    ASSERT_EQ(before.adjacencyUsedBytes, G.getEdgeCardinality() * sizeof(Edge));
+    ASSERT_GE(before.adjacencyCapacityBytes, before.adjacencyUsedBytes);
+    ASSERT_EQ(before.keyBytes, 101 * sizeof(typename TypeParam::VertexType));
+    ASSERT_GT(before.bucketBytes, 0);
+    ASSERT_GT(before.total(), before.adjacencyCapacityBytes);
+
+    G.shrinkToFit();
+    const auto after = G.getMemoryUsage();
+    ASSERT_EQ(after.adjacencySlackBytes(), 0);
+    ASSERT_EQ(after.adjacencyUsedBytes, before.adjacencyUsedBytes);
+    ASSERT_EQ(G.getAdjacencyList(0).size(), 100);
+}
+
+TYPED_TEST(GraphTestSuite, GraphDegreeStatisticsTest) {
+    TypeParam G;
+    ASSERT_EQ(G.getDegreeStatistics().maximum, 0);
+    ASSERT_TRUE(G.getDegreeStatistics().histogram.empty());
+
+    // A star with 4 leaves, and an isolated vertex.
+    for (int i = 1; i <= 4; i++) {
+        G.addEdge(0, i, 1.0);
+    }
+    G.addVertex(5);
+
+    const auto stats = G.getDegreeStatistics();
+    ASSERT_EQ(stats.minimum, 0);
+    ASSERT_EQ(stats.maximum, 4);
+    if (G.isDirected()) {
+        ASSERT_EQ(G.getEdgeCardinality(), 4);
+        ASSERT_EQ(stats.isolated, 5);
+        ASSERT_EQ(stats.histogram, (std::vector<size_t>{ 5, 0, 0, 1 }));
+        ASSERT_DOUBLE_EQ(stats.mean, 4.0 / 6.0);
+    } else {
+        ASSERT_EQ(G.getEdgeCardinality(), 8);
+        ASSERT_EQ(stats.isolated, 1);
+        ASSERT_EQ(stats.histogram, (std::vector<size_t>{ 1, 4, 0, 1 }));
+        ASSERT_DOUBLE_EQ(stats.mean, 8.0 / 6.0);
+        ASSERT_NEAR(stats.standardDeviation, std::sqrt(20.0 / 6.0 - (8.0 / 6.0) * (8.0 / 6.0)), 1e-12);
+    }
+}
+
+TYPED_TEST(GraphTestSuite, GraphMultiEdgePolicyTest) {
+    TypeParam G;
+    ASSERT_EQ(G.getMultiEdgePolicy(), Graphs::MultiEdgePolicy::ALLOW);
+    G.addEdge(0, 1, 2.0);
+    G.addEdge(0, 1, 1.0);
+    ASSERT_EQ(G.getAdjacencyList(0).size(), 2);
+
+    G.setMultiEdgePolicy(Graphs::MultiEdgePolicy::DEDUPE);
+    G.addEdge(0, 2, 2.0);
+    G.addEdge(0, 2, 1.0);
+    ASSERT_EQ(G.getAdjacencyList(0).size(), 3);
+    ASSERT_EQ(G.getAdjacencyList(0).back().getWeight(), 2.0);
+
+    G.setMultiEdgePolicy(Graphs::MultiEdgePolicy::KEEP_MIN);
+    G.addEdge(0, 3, 2.0);
+    G.addEdge(0, 3, 3.0);
+    G.addEdge(0, 3, 1.0);
+    ASSERT_EQ(G.getAdjacencyList(0).size(), 4);
+    ASSERT_EQ(G.getAdjacencyList(0).back().getWeight(), 1.0);
+    ASSERT_EQ(G.getAdjacencyList(3).size(), G.isDirected() ? 0 : 1);
+    if (!G.isDirected()) {
+        ASSERT_EQ(G.getAdjacencyList(3).back().getWeight(), 1.0);
+    }
+
+    ASSERT_TRUE(G.hasEdge(0, 3));
+    ASSERT_EQ(G.hasEdge(3, 0), !G.isDirected());
+    ASSERT_FALSE(G.hasEdge(0, 4));
+    ASSERT_FALSE(G.hasEdge(4, 0));
+}
+
+TYPED_TEST(GraphTestSuite, GraphPolicySwitchWeightTest) {
+    TypeParam G;
+    G.addEdge(0, 1, 2.0);
+    G.addEdge(0, 1, 3.0);
+
+    // Duplicates added under ALLOW survive the switch, and are all updated.
+    G.setMultiEdgePolicy(Graphs::MultiEdgePolicy::DEDUPE);
+    ASSERT_TRUE(G.setEdgeWeight(0, 1, 5.0));
+    ASSERT_EQ(G.getAdjacencyList(0).size(), 2);
+    for (const auto& e : G.getAdjacencyList(0)) {
+        ASSERT_EQ(e.getWeight(), 5.0);
+    }
+    if (!G.isDirected()) {
+        for (const auto& e : G.getAdjacencyList(1)) {
+            ASSERT_EQ(e.getWeight(), 5.0);
+        }
+    }
+
+    G.setMultiEdgePolicy(Graphs::MultiEdgePolicy::KEEP_MIN);
+    G.addEdge(0, 1, 1.0);
+    ASSERT_EQ(G.getAdjacencyList(0).size(), 2);
+    ASSERT_TRUE(G.setEdgeWeight(0, 1, 4.0));
+    ASSERT_EQ(G.getAdjacencyList(0).at(0).getWeight(), 4.0);
+    ASSERT_EQ(G.getAdjacencyList(0).at(1).getWeight(), 4.0);
+}
+
+TYPED_TEST(GraphTestSuite, GraphEmptyCopyTest) {
+    TypeParam G;
+    G.setMultiEdgePolicy(Graphs::MultiEdgePolicy::KEEP_MIN);
+    G.addEdge(0, 1, 2.0);
+
+    auto H = G.emptyCopy();
+    ASSERT_EQ(H.getVertexCardinality(), 0);
+    ASSERT_EQ(H.isDirected(), G.isDirected());
+    ASSERT_EQ(H.getMultiEdgePolicy(), Graphs::MultiEdgePolicy::KEEP_MIN);
+    H.addEdge(0, 1, 2.0);
+    H.addEdge(0, 1, 1.0);
+    ASSERT_EQ(H.getAdjacencyList(0).size(), 1);
+    ASSERT_EQ(H.hasEdge(1, 0), !G.isDirected());
+}
+
+TYPED_TEST(GraphTestSuite, GraphHubAdjacencyTest) {
+    using Vertex = typename TypeParam::VertexType;
+    using Adjacency = Graphs::VertexAdjacency<Vertex, typename TypeParam::WeightType>;
+    const int N = 1000;
+
+    TypeParam G;
+    G.setMultiEdgePolicy(Graphs::MultiEdgePolicy::KEEP_MIN);
+    for (int repeat = 0; repeat < 3; repeat++) {
+        for (int i = 1; i <= N; i++) {
+            G.addEdge(0, i, static_cast<double>(3 - repeat));
+        }
+    }
+    ASSERT_EQ(G.getAdjacencyList(0).size(), N);
+    ASSERT_GT(G.getMemoryUsage().hubIndexBytes, 0);
+    for (const auto& e : G.getAdjacencyList(0)) {
+        ASSERT_EQ(e.getWeight(), 1.0);
+    }
+
+    // Removal shifts positions; lookups must still be right.
+    for (int i = 1; i <= N; i += 2) {
+        G.removeEdge(0, i);
+    }
+    ASSERT_EQ(G.getAdjacencyList(0).size(), N / 2);
+    for (int i = 1; i <= N; i++) {
+        ASSERT_EQ(G.hasEdge(0, i), i % 2 == 0);
+    }
+
+    ASSERT_TRUE(G.setEdgeWeight(0, 500, 9.0));
+    ASSERT_FALSE(G.setEdgeWeight(0, 501, 9.0));
+    ASSERT_EQ(G.getAdjacencyList(0).at(249).getWeight(), 9.0);
+
+    // Dropping below the hub degree discards the index.
+    for (int i = 2; i <= N; i += 2) {
+        G.removeVertex(i);
+    }
+    ASSERT_TRUE(G.getAdjacencyList(0).empty());
+    ASSERT_EQ(G.getMemoryUsage().hubIndexBytes, 0);
+
+    Adjacency adjacency;
+    for (int i = 0; i < 2 * static_cast<int>(Adjacency::hubDegree); i++) {
+        adjacency.insert(static_cast<Vertex>(i % Adjacency::hubDegree), 1.0, Graphs::MultiEdgePolicy::ALLOW);
+        ASSERT_EQ(adjacency.isHub(), i + 1 >= static_cast<int>(Adjacency::hubDegree));
+    }
+    ASSERT_EQ(adjacency.find(static_cast<Vertex>(3)), 3);
+    ASSERT_EQ(adjacency.find(static_cast<Vertex>(-1)), Adjacency::npos);
+    ASSERT_EQ(adjacency.erase(static_cast<Vertex>(3)), 2);
+    ASSERT_EQ(adjacency.find(static_cast<Vertex>(4)), 3);
+}
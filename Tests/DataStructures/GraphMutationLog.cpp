@@ -0,0 +1,227 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/DataStructures/ArenaGraph.hpp>
+#include <CPPUtils/DataStructures/ConcurrentGraph.hpp>
+#include <CPPUtils/DataStructures/GraphMutationLog.hpp>
+
+using namespace CPPUtils::DataStructures::Graphs;
+
+class GraphMutationLogTestSuite : public ::testing::TestWithParam<bool> {
+ protected:
+    void SetUp() override {
+        //
+    }
+};
+
+namespace {
+    Graph<int> makeGraph(bool directed) {
+        return directed ? Graph<int>(DirectedGraph<int>()) : Graph<int>();
+    }
+
+    // Adjacency lists as sorted (source, target, weight) triples.
+    template<typename A>
+    std::vector<std::tuple<int, int, double>> sortedEdges(const Graph<int, double, A>& G) {
+        std::vector<std::tuple<int, int, double>> result;
+        for (const auto& e : G.getEdgeRange()) {
+            result.emplace_back(e.source, e.target, e.weight);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+}
+
+TEST_P(GraphMutationLogTestSuite, MatchesSerialTest) {
+    const bool directed = GetParam();
+    std::mt19937 rng(17);
+
+    auto expected = makeGraph(directed);
+    auto actual = makeGraph(directed);
+    actual.addVertex(1000);
+    expected.addVertex(1000);
+
+    GraphMutationLog<int> log(7);
+    for (int i = 0; i < 5000; i++) {
+        int a = static_cast<int>(rng() % 200);
+        int b = static_cast<int>(rng() % 200);
+
+        // Undirected edges are only ordered when recorded from one end.
+        if (!directed && b < a) {
+            std::swap(a, b);
+        }
+
+        const double w = static_cast<double>(rng() % 100);
+        switch (rng() % 4) {
+        case 0:
+        case 1:
+            log.addEdge(a, b, w);
+            expected.addEdge(a, b, w);
+            break;
+        case 2:
+            log.removeEdge(a, b);
+            expected.removeEdge(a, b);
+            break;
+        case 3:
+            log.setEdgeWeight(a, b, w);
+            expected.setEdgeWeight(a, b, w);
+            break;
+        }
+    }
+
+    ASSERT_EQ(log.applyTo(actual, 3), 5000);
+    ASSERT_EQ(actual.getVertexCardinality(), expected.getVertexCardinality());
+    ASSERT_EQ(sortedEdges(actual), sortedEdges(expected));
+
+    // The log is empty once applied.
+    ASSERT_EQ(log.applyTo(actual, 3), 0);
+}
+
+TEST_P(GraphMutationLogTestSuite, ConcurrentProducersTest) {
+    const int P = 4;
+    const int M = 2000;
+    GraphMutationLog<int> log;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < P; p++) {
+        producers.emplace_back([&log, p]() {
+            for (int i = 0; i < M; i++) {
+                log.addEdge(p * M + i, p * M + (i + 1) % M, 1.0);
+            }
+            // Removes one edge of each producer's ring.
+            log.removeEdge(p * M, p * M + 1);
+        });
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+
+    auto G = makeGraph(GetParam());
+    log.applyTo(G, 4);
+    ASSERT_EQ(G.getVertexCardinality(), P * M);
+
+    const auto expectedArcs = P * (M - 1) * (GetParam() ? 1 : 2);
+    ASSERT_EQ(sortedEdges(G).size(), expectedArcs);
+}
+
+TEST_P(GraphMutationLogTestSuite, DrainWhileRecordingTest) {
+    const int P = 3;
+    const int M = 5000;
+    GraphMutationLog<int> log(4);
+    auto G = makeGraph(GetParam());
+
+    std::atomic<int> running(P);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < P; p++) {
+        producers.emplace_back([&log, &running, p]() {
+            for (int i = 0; i < M; i++) {
+                log.addEdge(p, P + p * M + i, 1.0);
+            }
+            running--;
+        });
+    }
+
+    // Apply batches while the producers are still recording.
+    size_t applied = 0;
+    while (running > 0) {
+        applied += log.applyTo(G, 2);
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+    applied += log.applyTo(G, 2);
+
+    ASSERT_EQ(applied, P * M);
+    for (int p = 0; p < P; p++) {
+        ASSERT_EQ(G.getAdjacencyList(p).size(), M);
+    }
+}
+
+TEST_P(GraphMutationLogTestSuite, ArenaGraphTest) {
+    const bool directed = GetParam();
+    ArenaGraph<int> G(directed);
+    auto expected = makeGraph(directed);
+
+    // The arena is not thread safe, so the batch is applied serially no
+    // matter how many threads are asked for.
+    GraphMutationLog<int> log(8);
+    for (int i = 0; i < 4000; i++) {
+        log.addEdge(i % 300, (7 * i) % 300, static_cast<double>(i));
+        expected.addEdge(i % 300, (7 * i) % 300, static_cast<double>(i));
+    }
+    ASSERT_EQ(log.applyTo(*G, 4), 4000);
+    ASSERT_EQ(sortedEdges(*G), sortedEdges(expected));
+}
+
+TEST_P(GraphMutationLogTestSuite, ConcurrentGraphTest) {
+    ConcurrentGraph<int> G(makeGraph(GetParam()));
+    GraphMutationLog<int> log(3);
+    ASSERT_EQ(G.update(log), 0);
+
+    log.addEdge(0, 1, 1.0);
+    log.addEdge(1, 2, 1.0);
+    const auto before = G.snapshot();
+    ASSERT_EQ(G.update(log, 2), 1);
+
+    ASSERT_EQ(before->getVertexCardinality(), 0);
+    ASSERT_EQ(G.snapshot()->getVertexCardinality(), 3);
+    ASSERT_EQ(G.snapshot()->isDirected(), GetParam());
+}
+
+TEST_P(GraphMutationLogTestSuite, MultiEdgePolicyTest) {
+    auto G = makeGraph(GetParam());
+    G.setMultiEdgePolicy(MultiEdgePolicy::KEEP_MIN);
+
+    GraphMutationLog<int> log(5);
+    for (int i = 0; i < 200; i++) {
+        log.addEdge(0, i % 100 + 1, 200.0 - i);
+    }
+    log.applyTo(G, 2);
+
+    ASSERT_EQ(G.getAdjacencyList(0).size(), 100);
+    for (const auto& e : G.getAdjacencyList(0)) {
+        ASSERT_EQ(e.getWeight(), 101.0 - e.getVertex());
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Directedness,
+    GraphMutationLogTestSuite,
+    testing::Values(false, true));
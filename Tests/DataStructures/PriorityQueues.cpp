@@ -0,0 +1,148 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/DataStructures/PriorityQueues.hpp>
+
+using namespace CPPUtils::DataStructures::PriorityQueues;
+
+class PriorityQueuesTestSuite : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        //
+    }
+};
+
+TEST_F(PriorityQueuesTestSuite, IndexedDaryHeapOrderTest) {
+    std::mt19937 rng(1);
+    constexpr std::uint32_t N = 1000;
+    IndexedDaryHeap<std::uint32_t> Q(N);
+
+    std::vector<std::uint32_t> priorities(N);
+    for (std::uint32_t i = 0; i < N; i++) {
+        priorities[i] = static_cast<std::uint32_t>(rng() % 500);
+        Q.push(i, priorities[i]);
+    }
+    ASSERT_EQ(Q.size(), N);
+
+    std::vector<std::uint32_t> popped;
+    while (!Q.empty()) {
+        const auto [priority, item] = Q.pop();
+        ASSERT_EQ(priority, priorities[item]);
+        ASSERT_FALSE(Q.contains(item));
+        popped.push_back(priority);
+    }
+    ASSERT_TRUE(std::is_sorted(popped.begin(), popped.end()));
+    ASSERT_EQ(popped.size(), N);
+}
+
+TEST_F(PriorityQueuesTestSuite, IndexedDaryHeapDecreaseKeyTest) {
+    IndexedDaryHeap<double, 3> Q(8);
+    for (std::uint32_t i = 0; i < 8; i++) {
+        Q.push(i, 10.0 + i);
+    }
+
+    Q.decreaseKey(7, 1.0);
+    ASSERT_EQ(Q.top().second, 7u);
+    ASSERT_EQ(Q.getPriority(7), 1.0);
+    ASSERT_THROW(Q.decreaseKey(7, 2.0), std::invalid_argument);
+
+    ASSERT_FALSE(Q.pushOrDecrease(3, 20.0));
+    ASSERT_TRUE(Q.pushOrDecrease(3, 0.5));
+    ASSERT_EQ(Q.pop(), std::make_pair(0.5, 3u));
+    ASSERT_TRUE(Q.pushOrDecrease(3, 30.0));
+    ASSERT_EQ(Q.size(), 8u);
+
+    ASSERT_THROW(Q.push(3, 1.0), std::invalid_argument);
+    ASSERT_THROW(Q.push(8, 1.0), std::out_of_range);
+    Q.reserve(9);
+    Q.push(8, 1.5);
+    ASSERT_EQ(Q.pop().second, 7u);
+    ASSERT_EQ(Q.pop().second, 8u);
+
+    Q.clear();
+    ASSERT_TRUE(Q.empty());
+    ASSERT_FALSE(Q.contains(3));
+    ASSERT_THROW(Q.pop(), std::out_of_range);
+    Q.push(3, 1.0);
+    ASSERT_EQ(Q.top().second, 3u);
+}
+
+TEST_F(PriorityQueuesTestSuite, RadixHeapMonotoneTest) {
+    // Simulate a Dijkstra-like workload: each push is at least the last pop.
+    std::mt19937 rng(2);
+    RadixHeap<std::uint64_t> Q;
+    std::uint64_t last = 0;
+    Q.push(0, 0);
+    size_t pops = 0;
+    while (!Q.empty()) {
+        const auto [priority, item] = Q.pop();
+        ASSERT_GE(priority, last);
+        last = priority;
+        pops++;
+
+        if (pops < 2000) {
+            for (int i = 0; i < 2; i++) {
+                Q.push(item + 1, last + rng() % 1000);
+            }
+        }
+    }
+    ASSERT_GT(pops, 2000u);
+    ASSERT_THROW(Q.pop(), std::out_of_range);
+    ASSERT_THROW(Q.push(0, last - 1), std::invalid_argument);
+
+    Q.clear();
+    Q.push(1, 0);
+    ASSERT_EQ(Q.pop(), std::make_pair(std::uint64_t(0), 1u));
+}
+
+TEST_F(PriorityQueuesTestSuite, RadixHeapSignedTest) {
+    RadixHeap<int> Q;
+    ASSERT_THROW(Q.push(0, -1), std::invalid_argument);
+    Q.push(0, 5);
+    Q.push(1, 3);
+    Q.push(2, 3);
+    Q.push(3, (std::numeric_limits<int>::max)());
+    ASSERT_EQ(Q.pop().first, 3);
+    ASSERT_EQ(Q.pop().first, 3);
+    ASSERT_EQ(Q.pop().first, 5);
+    ASSERT_EQ(Q.pop().second, 3u);
+    ASSERT_TRUE(Q.empty());
+}
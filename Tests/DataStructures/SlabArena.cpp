@@ -0,0 +1,126 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/DataStructures/SlabArena.hpp>
+
+using namespace CPPUtils::DataStructures::Arenas;
+
+class SlabArenaTestSuite : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        //
+    }
+};
+
+TEST_F(SlabArenaTestSuite, BlockSizeTest) {
+    ASSERT_EQ(SlabArena::blockSize(1), SlabArena::minBlockSize);
+    ASSERT_EQ(SlabArena::blockSize(16), 16);
+    ASSERT_EQ(SlabArena::blockSize(17), 32);
+    ASSERT_EQ(SlabArena::blockSize(1000), 1024);
+    ASSERT_EQ(SlabArena::blockSize(SlabArena::maxBlockSize), SlabArena::maxBlockSize);
+    ASSERT_EQ(SlabArena::blockSize(SlabArena::maxBlockSize + 1), SlabArena::maxBlockSize + 1);
+}
+
+TEST_F(SlabArenaTestSuite, AllocateTest) {
+    SlabArena arena(SlabArena::maxBlockSize);
+    ASSERT_EQ(arena.getSlabCount(), 0);
+
+    // Distinct, aligned, non-overlapping blocks.
+    std::set<std::uintptr_t> blocks;
+    for (int i = 0; i < 100; i++) {
+        auto* p = static_cast<std::uint64_t*>(arena.allocate(24, alignof(std::uint64_t)));
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(p) % alignof(std::max_align_t), 0);
+        p[0] = p[1] = p[2] = i;
+        ASSERT_TRUE(blocks.insert(reinterpret_cast<std::uintptr_t>(p)).second);
+    }
+    ASSERT_EQ(arena.getSlabCount(), 1);
+
+    // Fill past the first slab.
+    for (int i = 0; i < 100; i++) {
+        ASSERT_NE(arena.allocate(1024), nullptr);
+    }
+    ASSERT_EQ(arena.getSlabCount(), 2);
+    ASSERT_EQ(arena.getBytesReserved(), 2 * SlabArena::maxBlockSize);
+}
+
+TEST_F(SlabArenaTestSuite, ReuseTest) {
+    SlabArena arena;
+    void* a = arena.allocate(100);
+    arena.deallocate(a, 100);
+
+    // Same size class gets the freed block back, others do not.
+    void* b = arena.allocate(120);
+    ASSERT_EQ(a, b);
+    void* c = arena.allocate(100);
+    ASSERT_NE(b, c);
+    void* d = arena.allocate(200);
+    ASSERT_NE(a, d);
+}
+
+TEST_F(SlabArenaTestSuite, LargeBlockTest) {
+    SlabArena arena;
+    const auto n = SlabArena::maxBlockSize * 4;
+    void* p = arena.allocate(n);
+    ASSERT_EQ(arena.getSlabCount(), 0);
+    ASSERT_EQ(arena.getBytesReserved(), n);
+
+    arena.deallocate(p, n);
+    ASSERT_EQ(arena.getBytesReserved(), 0);
+
+    // Left allocated; release frees it.
+    ASSERT_NE(arena.allocate(n), nullptr);
+    ASSERT_NE(arena.allocate(64), nullptr);
+    arena.release();
+    ASSERT_EQ(arena.getBytesReserved(), 0);
+    ASSERT_EQ(arena.getSlabCount(), 0);
+}
+
+TEST_F(SlabArenaTestSuite, ContainerTest) {
+    SlabArena arena;
+    std::pmr::vector<int> v(&arena);
+    for (int i = 0; i < 100000; i++) {
+        v.push_back(i);
+    }
+
+    for (int i = 0; i < 100000; i++) {
+        ASSERT_EQ(v[i], i);
+    }
+    ASSERT_GE(arena.getBytesReserved(), v.size() * sizeof(int));
+}
@@ -0,0 +1,211 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <CPPUtils/IO/GraphFile.hpp>
+
+using namespace CPPUtils::IO;
+using namespace CPPUtils::DataStructures::Graphs;
+
+class GraphFileTestSuite : public ::testing::Test {
+ protected:
+    std::filesystem::path fname;
+
+    void SetUp() override {
+        fname = std::filesystem::temp_directory_path() / "test_graph.bin";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(fname);
+    }
+
+    template<typename G>
+    static void verifyEqual(const CSRGraph<int, double>& a, const G& b) {
+        ASSERT_EQ(a.isDirected(), b.isDirected());
+        ASSERT_EQ(a.getVertexCardinality(), b.getVertexCardinality());
+        ASSERT_EQ(a.getEdgeCardinality(), b.getEdgeCardinality());
+
+        for (size_t i = 0; i < a.getVertexCardinality(); i++) {
+            ASSERT_EQ(a.getVertices()[i], b.getVertices()[i]);
+        }
+        for (size_t i = 0; i <= a.getVertexCardinality(); i++) {
+            ASSERT_EQ(a.getOffsets()[i], b.getOffsets()[i]);
+        }
+        for (size_t i = 0; i < a.getEdgeCardinality(); i++) {
+            ASSERT_EQ(a.getTargets()[i], b.getTargets()[i]);
+            ASSERT_EQ(a.getWeights()[i], b.getWeights()[i]);
+        }
+    }
+};
+
+TEST_F(GraphFileTestSuite, RoundTripTest) {
+    Graph<int> G;
+    G.addEdge(0, 1, 0.5);
+    G.addEdge(1, 2, 1.5);
+    G.addEdge(2, 0, -1.0);
+    G.addVertex(7);
+
+    const CSRGraph<int, double> C(G);
+    saveGraph(C, fname.string());
+
+    const auto L = loadGraph<int, double>(fname.string());
+    verifyEqual(C, L);
+    ASSERT_EQ(L.indexOf(7), C.indexOf(7));
+}
+
+TEST_F(GraphFileTestSuite, DirectedRoundTripTest) {
+    DirectedGraph<int> G;
+    G.addEdge(3, 1, 0.5);
+    G.addEdge(1, 3, 1.5);
+    G.addEdge(1, 2, 2.5);
+
+    saveGraph(G, fname.string());
+    const auto L = loadGraph<int, double>(fname.string());
+
+    ASSERT_TRUE(L.isDirected());
+    verifyEqual(CSRGraph<int, double>(G), L);
+}
+
+TEST_F(GraphFileTestSuite, EmptyRoundTripTest) {
+    const Graph<int> G;
+    saveGraph(G, fname.string());
+
+    const auto L = loadGraph<int, double>(fname.string());
+    ASSERT_EQ(L.getVertexCardinality(), 0);
+    ASSERT_EQ(L.getEdgeCardinality(), 0);
+}
+
+TEST_F(GraphFileTestSuite, TypeMismatchTest) {
+    Graph<int> G;
+    G.addEdge(0, 1, 0.5);
+    saveGraph(G, fname.string());
+
+    ASSERT_THROW((loadGraph<int, float>(fname.string())), std::runtime_error);
+    ASSERT_THROW((loadGraph<long long, double>(fname.string())), std::runtime_error);
+}
+
+TEST_F(GraphFileTestSuite, InvalidFileTest) {
+    {
+        std::ofstream file(fname, std::ios::binary);
+        file << "This is not a graph file, but is long enough to hold a header.";
+        file << "This is not a graph file, but is long enough to hold a header.";
+    }
+    ASSERT_THROW((loadGraph<int, double>(fname.string())), std::runtime_error);
+
+    ASSERT_THROW((loadGraph<int, double>("does_not_exist.bin")), std::runtime_error);
+}
+
+TEST_F(GraphFileTestSuite, CorruptHeaderTest) {
+    Graph<int> G;
+    G.addEdge(0, 1, 0.5);
+    G.addEdge(1, 2, 1.5);
+    saveGraph(G, fname.string());
+
+    GraphFileHeader original;
+    {
+        std::ifstream file(fname, std::ios::binary);
+        file.read(reinterpret_cast<char*>(&original), sizeof(original));
+    }
+
+    const auto rejects = [&](auto&& corrupt) {
+        auto header = original;
+        corrupt(header);
+        {
+            std::fstream file(fname, std::ios::binary | std::ios::in | std::ios::out);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+        EXPECT_THROW((loadGraph<int, double>(fname.string())), std::runtime_error);
+    };
+
+    // Sections overlapping the header, misaligned, or with counts whose
+    // sizes overflow.
+    rejects([](GraphFileHeader& h) { h.keysOffset = 0; });
+    rejects([](GraphFileHeader& h) { h.offsetsOffset += 1; });
+    rejects([](GraphFileHeader& h) { h.weightsOffset += 4; });
+    rejects([](GraphFileHeader& h) { h.numEdges = (std::uint64_t(1) << 62) + 1; });
+    rejects([](GraphFileHeader& h) { h.numVertices = ~std::uint64_t(0); });
+    rejects([](GraphFileHeader& h) { h.numVertices = std::uint64_t(1) << 61; });
+
+    // The unmodified header still loads.
+    {
+        std::fstream file(fname, std::ios::binary | std::ios::in | std::ios::out);
+        file.write(reinterpret_cast<const char*>(&original), sizeof(original));
+    }
+    ASSERT_EQ((loadGraph<int, double>(fname.string()).getEdgeCardinality()), 4);
+}
+
+TEST_F(GraphFileTestSuite, CorruptSectionsTest) {
+    Graph<int> G;
+    G.addEdge(0, 1, 0.5);
+    G.addEdge(1, 2, 1.5);
+    saveGraph(G, fname.string());
+
+    GraphFileHeader header;
+    {
+        std::ifstream file(fname, std::ios::binary);
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    }
+
+    const auto rejects = [&](std::uint64_t position, auto value) {
+        decltype(value) original;
+        {
+            std::fstream file(fname, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekg(static_cast<std::streamoff>(position));
+            file.read(reinterpret_cast<char*>(&original), sizeof(original));
+            file.seekp(static_cast<std::streamoff>(position));
+            file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+        EXPECT_THROW((loadGraph<int, double>(fname.string())), std::runtime_error);
+        {
+            std::fstream file(fname, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(static_cast<std::streamoff>(position));
+            file.write(reinterpret_cast<const char*>(&original), sizeof(original));
+        }
+    };
+
+    // Offsets that decrease or do not span the targets, and an out of range
+    // target.
+    rejects(header.offsetsOffset, EdgeIndex(1));
+    rejects(header.offsetsOffset + sizeof(EdgeIndex), EdgeIndex(4));
+    rejects(header.offsetsOffset + 3 * sizeof(EdgeIndex), EdgeIndex(3));
+    rejects(header.targetsOffset + sizeof(VertexIndex), VertexIndex(3));
+
+    // The restored file loads, with or without validation.
+    ASSERT_EQ((loadGraph<int, double>(fname.string()).getEdgeCardinality()), 4);
+    ASSERT_EQ((loadGraph<int, double>(fname.string(), false).getEdgeCardinality()), 4);
+}
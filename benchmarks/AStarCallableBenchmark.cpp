@@ -0,0 +1,131 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <CPPUtils/Algorithms/PathFinding.hpp>
+#include <CPPUtils/Timing/Timer.hpp>
+
+using CPPUtils::Algorithms::AStarSearch;
+using CPPUtils::Algorithms::ZeroHeuristic;
+using CPPUtils::Algorithms::dijkstra;
+using CPPUtils::DataStructures::Graphs::Graph;
+using CPPUtils::Timing::Timer;
+using CPPUtils::Timing::getElapsed;
+
+using Key = std::uint32_t;
+using Weight = std::uint64_t;
+
+/*
+ * A W x W grid with random integer weights of at least 1, so that the
+ * Manhattan distance is an admissible heuristic.
+ */
+Graph<Key, Weight> buildGrid(Key W) {
+    std::mt19937 rng(42);
+    Graph<Key, Weight> G;
+    for (Key y = 0; y < W; y++) {
+        for (Key x = 0; x < W; x++) {
+            if (x + 1 < W) {
+                G.addEdge(y * W + x, y * W + x + 1, 1 + rng() % 100);
+            }
+            if (y + 1 < W) {
+                G.addEdge(y * W + x, (y + 1) * W + x, 1 + rng() % 100);
+            }
+        }
+    }
+    return G;
+}
+
+double medianMilliseconds(const Timer& timer) {
+    auto elapsed = getElapsed(timer.getTicTocs());
+    std::sort(elapsed.begin(), elapsed.end());
+    return elapsed[elapsed.size() / 2] / 1e6;
+}
+
+template<typename F>
+void run(const std::string& name, F&& search, int repeats) {
+    size_t checksum = 0;
+    Timer timer;
+    for (int r = 0; r < repeats; r++) {
+        timer.tic();
+        checksum += search();
+        timer.toc();
+    }
+
+    std::cout << name << ": " << medianMilliseconds(timer) << " ms "
+              << "(path length " << checksum / repeats << ")" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const Key W = argc > 1 ? static_cast<Key>(std::atoi(argv[1])) : 512;
+    constexpr int repeats = 5;
+
+    std::cout << "Building a " << W << " x " << W << " grid graph." << std::endl;
+    const auto G = buildGrid(W);
+    const Key sink = W * W - 1;
+
+    const auto isSink = [sink](const Key& v) {
+        return v == sink;
+    };
+    const auto manhattan = [W, sink](const Key&, const Key& u) -> Weight {
+        const auto dx = static_cast<std::int64_t>(u % W) - static_cast<std::int64_t>(sink % W);
+        const auto dy = static_cast<std::int64_t>(u / W) - static_cast<std::int64_t>(sink / W);
+        return static_cast<Weight>(std::abs(dx) + std::abs(dy));
+    };
+
+    // The same callables, behind std::function.
+    const std::function<bool(Key)> erasedIsSink = isSink;
+    const std::function<Weight(Key, Key)> erasedZero = [](Key, Key) -> Weight { return 0; };
+    const std::function<Weight(Key, Key)> erasedManhattan = manhattan;
+
+    run("Dijkstra, std::function     ", [&]() {
+        return AStarSearch<Key, Weight, Weight>(G, 0, erasedIsSink, erasedZero).size();
+    }, repeats);
+    run("Dijkstra, inlined           ", [&]() {
+        return dijkstra<Key, Weight>(G, 0, sink).size();
+    }, repeats);
+    run("Manhattan A*, std::function ", [&]() {
+        return AStarSearch<Key, Weight, Weight>(G, 0, erasedIsSink, erasedManhattan).size();
+    }, repeats);
+    run("Manhattan A*, inlined       ", [&]() {
+        return AStarSearch<Key, Weight, Weight>(G, 0, isSink, manhattan).size();
+    }, repeats);
+
+    return 0;
+}
@@ -0,0 +1,163 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <CPPUtils/Algorithms/GridPathFinding.hpp>
+#include <CPPUtils/Algorithms/PathFinding.hpp>
+#include <CPPUtils/Timing/Timer.hpp>
+
+using CPPUtils::Algorithms::GridConnectivity;
+using CPPUtils::Algorithms::GridPoint;
+using CPPUtils::Algorithms::GridSearchContext;
+using CPPUtils::Algorithms::OccupancyGrid;
+using CPPUtils::Algorithms::AStarSearch;
+using CPPUtils::DataStructures::Graphs::Graph;
+using CPPUtils::Timing::Timer;
+using CPPUtils::Timing::getElapsed;
+
+using Key = std::uint32_t;
+
+/*
+ * A W x W map with 20% random walls, with the corners kept open so that
+ * queries run from corner to corner.
+ */
+OccupancyGrid buildMap(std::int32_t W) {
+    std::mt19937 rng(42);
+    std::bernoulli_distribution wall(0.2);
+    OccupancyGrid grid(W, W);
+    for (std::int32_t y = 0; y < W; y++) {
+        for (std::int32_t x = 0; x < W; x++) {
+            grid.setWall({ x, y }, wall(rng));
+        }
+    }
+    grid.setWall({ 0, 0 }, false);
+    grid.setWall({ W - 1, W - 1 }, false);
+    return grid;
+}
+
+/*
+ * The same map as an 8-connected graph, the route taken before grid-native
+ * search existed.
+ */
+Graph<Key> buildGraph(const OccupancyGrid& grid) {
+    const auto W = static_cast<std::int32_t>(grid.getWidth());
+    Graph<Key> G;
+    for (std::int32_t y = 0; y < W; y++) {
+        for (std::int32_t x = 0; x < W; x++) {
+            if (!grid.isOpen({ x, y })) {
+                continue;
+            }
+
+            G.addVertex(grid.indexOf({ x, y }));
+            for (const auto& [dx, dy] : { std::pair{ 1, 0 }, std::pair{ 0, 1 }, std::pair{ 1, 1 }, std::pair{ -1, 1 } }) {
+                const GridPoint q = { x + dx, y + dy };
+                const bool diagonal = dx != 0 && dy != 0;
+                if (grid.isOpen(q) && (!diagonal || (grid.isOpen({ x + dx, y }) && grid.isOpen({ x, y + dy })))) {
+                    G.addEdge(grid.indexOf({ x, y }), grid.indexOf(q), diagonal ? std::sqrt(2.0) : 1.0);
+                }
+            }
+        }
+    }
+    return G;
+}
+
+double medianMilliseconds(const Timer& timer) {
+    auto elapsed = getElapsed(timer.getTicTocs());
+    std::sort(elapsed.begin(), elapsed.end());
+    return elapsed[elapsed.size() / 2] / 1e6;
+}
+
+template<typename F>
+void run(const std::string& name, F&& search, int repeats) {
+    size_t checksum = 0;
+    Timer timer;
+    for (int r = 0; r < repeats; r++) {
+        timer.tic();
+        checksum += search();
+        timer.toc();
+    }
+
+    std::cout << name << ": " << medianMilliseconds(timer) << " ms "
+              << "(path length " << checksum / repeats << ")" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const std::int32_t W = argc > 1 ? std::atoi(argv[1]) : 512;
+    constexpr int repeats = 5;
+
+    std::cout << "Building a " << W << " x " << W << " map." << std::endl;
+    const auto grid = buildMap(W);
+    const GridPoint start = { 0, 0 };
+    const GridPoint goal = { W - 1, W - 1 };
+
+    Timer build;
+    build.tic();
+    const auto G = buildGraph(grid);
+    build.toc();
+    std::cout << "Graph build       : " << medianMilliseconds(build) << " ms" << std::endl;
+
+    // The same octile distance heuristic on both routes.
+    const auto octile = [&](GridPoint p) {
+        const auto dx = static_cast<double>(std::abs(p.x - goal.x));
+        const auto dy = static_cast<double>(std::abs(p.y - goal.y));
+        return std::max(dx, dy) + (std::sqrt(2.0) - 1.0) * std::min(dx, dy);
+    };
+    const std::function<bool(Key)> isGoal = [&](Key v) {
+        return v == grid.indexOf(goal);
+    };
+    const std::function<double(Key, Key)> heuristic = [&](Key, Key u) {
+        return octile(grid.pointAt(u));
+    };
+
+    run("Graph A*          ", [&]() {
+        return AStarSearch<Key>(G, grid.indexOf(start), isGoal, heuristic).size();
+    }, repeats);
+
+    GridSearchContext context(grid);
+    run("Grid A* (8)       ", [&]() {
+        return context.findPath(start, goal, GridConnectivity::EIGHT).size();
+    }, repeats);
+    run("Grid JPS          ", [&]() {
+        return context.jumpPointSearch(start, goal).size();
+    }, repeats);
+
+    return 0;
+}
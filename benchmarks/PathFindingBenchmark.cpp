@@ -0,0 +1,106 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <CPPUtils/Algorithms/PathFinding.hpp>
+#include <CPPUtils/Timing/Timer.hpp>
+
+using CPPUtils::Algorithms::PriorityQueueType;
+using CPPUtils::Algorithms::dijkstra;
+using CPPUtils::DataStructures::Graphs::Graph;
+using CPPUtils::Timing::Timer;
+using CPPUtils::Timing::getElapsed;
+
+using Key = std::uint32_t;
+using Weight = std::uint64_t;
+
+/*
+ * A W x W grid with random integer weights, so that all three queues,
+ * including the radix heap, can be compared on the same graph.
+ */
+Graph<Key, Weight> buildGrid(Key W) {
+    std::mt19937 rng(42);
+    Graph<Key, Weight> G;
+    for (Key y = 0; y < W; y++) {
+        for (Key x = 0; x < W; x++) {
+            if (x + 1 < W) {
+                G.addEdge(y * W + x, y * W + x + 1, 1 + rng() % 100);
+            }
+            if (y + 1 < W) {
+                G.addEdge(y * W + x, (y + 1) * W + x, 1 + rng() % 100);
+            }
+        }
+    }
+    return G;
+}
+
+double medianMilliseconds(const Timer& timer) {
+    auto elapsed = getElapsed(timer.getTicTocs());
+    std::sort(elapsed.begin(), elapsed.end());
+    return elapsed[elapsed.size() / 2] / 1e6;
+}
+
+void run(const std::string& name, const Graph<Key, Weight>& G, Key sink,
+         PriorityQueueType queueType, int repeats) {
+    size_t checksum = 0;
+    Timer timer;
+    for (int r = 0; r < repeats; r++) {
+        timer.tic();
+        checksum += dijkstra<Key, Weight>(G, 0, sink, queueType).size();
+        timer.toc();
+    }
+
+    std::cout << name << ": " << medianMilliseconds(timer) << " ms "
+              << "(path length " << checksum / repeats << ")" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const Key W = argc > 1 ? static_cast<Key>(std::atoi(argv[1])) : 512;
+    constexpr int repeats = 5;
+
+    std::cout << "Building a " << W << " x " << W << " grid graph." << std::endl;
+    const auto G = buildGrid(W);
+    const auto sink = W * W - 1;
+
+    run("Binary heap       ", G, sink, PriorityQueueType::BINARY_HEAP, repeats);
+    run("Indexed 4-ary heap", G, sink, PriorityQueueType::INDEXED_DARY_HEAP, repeats);
+    run("Radix heap        ", G, sink, PriorityQueueType::RADIX_HEAP, repeats);
+
+    return 0;
+}
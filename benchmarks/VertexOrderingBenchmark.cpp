@@ -0,0 +1,156 @@
+/*
+BSD 3-Clause License
+
+Copyright (c) 2023 Jack Miles Hunt
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <CPPUtils/Algorithms/VertexOrdering.hpp>
+#include <CPPUtils/Timing/Timer.hpp>
+
+using CPPUtils::Algorithms::breadthFirstOrder;
+using CPPUtils::Algorithms::degreeOrder;
+using CPPUtils::Algorithms::reorder;
+using CPPUtils::Algorithms::reverseCuthillMcKeeOrder;
+using CPPUtils::DataStructures::Graphs::CSRGraph;
+using CPPUtils::DataStructures::Graphs::Graph;
+using CPPUtils::DataStructures::Graphs::VertexIndex;
+using CPPUtils::Timing::Timer;
+using CPPUtils::Timing::getElapsed;
+
+using Key = std::uint32_t;
+
+/*
+ * A W x W grid, with keys scrambled by a multiplicative hash so that the
+ * default (hash map iteration) vertex order has no locality.
+ */
+Graph<Key> buildGrid(Key W) {
+    auto key = [W](Key x, Key y) -> Key {
+        return (y * W + x) * 2654435761u;
+    };
+
+    Graph<Key> G;
+    for (Key y = 0; y < W; y++) {
+        for (Key x = 0; x < W; x++) {
+            if (x + 1 < W) {
+                G.addEdge(key(x, y), key(x + 1, y), 1.0);
+            }
+            if (y + 1 < W) {
+                G.addEdge(key(x, y), key(x, y + 1), 1.0);
+            }
+        }
+    }
+    return G;
+}
+
+/*
+ * One sweep of neighbour value propagation, as in PageRank or label
+ * propagation; reads neighbour values through the vertex ordering.
+ */
+double sweep(const CSRGraph<Key>& G, const std::vector<double>& x, std::vector<double>& y) {
+    const auto N = G.getVertexCardinality();
+    for (VertexIndex v = 0; v < N; v++) {
+        double sum = 0;
+        const auto Nv = G.neighbours(v);
+        const auto Wv = G.neighbourWeights(v);
+        for (size_t i = 0; i < Nv.size(); i++) {
+            sum += x[Nv[i]] * Wv[i];
+        }
+        y[v] = sum;
+    }
+    return y[0];
+}
+
+/*
+ * A breadth first traversal from vertex 0.
+ */
+size_t traverse(const CSRGraph<Key>& G, std::vector<bool>& seen, std::vector<VertexIndex>& queue) {
+    std::fill(seen.begin(), seen.end(), false);
+    queue.assign(1, 0);
+    seen[0] = true;
+    for (size_t head = 0; head < queue.size(); head++) {
+        for (const auto u : G.neighbours(queue[head])) {
+            if (!seen[u]) {
+                seen[u] = true;
+                queue.push_back(u);
+            }
+        }
+    }
+    return queue.size();
+}
+
+double medianMilliseconds(const Timer& timer) {
+    auto elapsed = getElapsed(timer.getTicTocs());
+    std::sort(elapsed.begin(), elapsed.end());
+    return elapsed[elapsed.size() / 2] / 1e6;
+}
+
+void run(const std::string& name, const CSRGraph<Key>& G, int repeats) {
+    const auto N = G.getVertexCardinality();
+    std::vector<double> x(N, 1.0), y(N, 0.0);
+    std::vector<bool> seen(N);
+    std::vector<VertexIndex> queue;
+
+    double checksum = 0;
+    Timer sweepTimer, traverseTimer;
+    for (int r = 0; r < repeats; r++) {
+        sweepTimer.tic();
+        checksum += sweep(G, x, y);
+        sweepTimer.toc();
+
+        traverseTimer.tic();
+        checksum += static_cast<double>(traverse(G, seen, queue));
+        traverseTimer.toc();
+    }
+
+    std::cout << name << ": sweep " << medianMilliseconds(sweepTimer) << " ms, "
+              << "bfs " << medianMilliseconds(traverseTimer) << " ms "
+              << "(checksum " << checksum << ")" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const Key W = argc > 1 ? static_cast<Key>(std::atoi(argv[1])) : 1024;
+    constexpr int repeats = 9;
+
+    std::cout << "Building a " << W << " x " << W << " grid graph." << std::endl;
+    const auto G = buildGrid(W);
+
+    run("Hash order  ", CSRGraph<Key>(G), repeats);
+    run("BFS order   ", reorder(G, breadthFirstOrder<Key, double>), repeats);
+    run("Degree order", reorder(G, [](const auto& C) { return degreeOrder(C); }), repeats);
+    run("RCM order   ", reorder(G, reverseCuthillMcKeeOrder<Key, double>), repeats);
+
+    return 0;
+}